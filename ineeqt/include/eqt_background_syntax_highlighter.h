@@ -0,0 +1,277 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::BackgroundSyntaxHighlighter class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_BACKGROUND_SYNTAX_HIGHLIGHTER_H
+#define EQT_BACKGROUND_SYNTAX_HIGHLIGHTER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "eqt_common.h"
+#include "eqt_syntax_rule_set.h"
+
+class QTimer;
+class QThreadPool;
+class QTextDocument;
+class QPlainTextEdit;
+
+namespace EQt {
+    /**
+     * Class that highlights a QPlainTextEdit or \ref EQt::CodeEditor on a worker thread using a shared
+     * \ref EQt::SyntaxRuleSet.  Use this class in place of \ref EQt::SyntaxHighlighter for large documents.  The two
+     * should not be attached to the same document.
+     *
+     * The highlighter keeps a snapshot of the block texts and the state at the end of each block.  After an edit,
+     * blocks are scanned on a worker thread, starting with the edited block.  The visible
+     * blocks are highlighted first using the previously known block states, then blocks are scanned in order until
+     * the block states match those of the previous scan.  Formats are sent back to the GUI thread in batches, so
+     * keystrokes are never held up by the scan.
+     */
+    class EQT_PUBLIC_API BackgroundSyntaxHighlighter:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * The number of blocks delivered to the GUI thread in each batch.
+             */
+            static const unsigned blocksPerBatch;
+
+            /**
+             * Constructor.  The highlighter is a child of the editor.
+             *
+             * \param[in] editor  The editor holding the document to be highlighted.
+             *
+             * \param[in] ruleSet The rule set used to highlight the document.  A null pointer selects the C++ rule
+             *                    set.
+             */
+            BackgroundSyntaxHighlighter(
+                QPlainTextEdit*                     editor,
+                QSharedPointer<const SyntaxRuleSet> ruleSet = QSharedPointer<const SyntaxRuleSet>()
+            );
+
+            ~BackgroundSyntaxHighlighter() override;
+
+            /**
+             * Method you can use to obtain the editor.
+             *
+             * \return Returns the editor holding the highlighted document.
+             */
+            QPlainTextEdit* editor() const;
+
+            /**
+             * Method you can use to obtain the rule set used by this highlighter.
+             *
+             * \return Returns the rule set.
+             */
+            QSharedPointer<const SyntaxRuleSet> ruleSet() const;
+
+            /**
+             * Method you can use to change the rule set used by this highlighter.  The document is highlighted again.
+             *
+             * \param[in] newRuleSet The new rule set.  A null pointer selects the C++ rule set.
+             */
+            void setRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet);
+
+            /**
+             * Method you can use to set the thread pool used to scan the document.
+             *
+             * \param[in] newThreadPool The new thread pool.  A null pointer will cause the global thread pool to be
+             *                          used.
+             */
+            void setThreadPool(QThreadPool* newThreadPool);
+
+            /**
+             * Method you can use to obtain the thread pool used to scan the document.
+             *
+             * \return Returns the thread pool used to scan the document.
+             */
+            QThreadPool* threadPool() const;
+
+            /**
+             * Method you can use to determine if highlighting is up to date.
+             *
+             * \return Returns true if every block has been highlighted.  Returns false if a scan is underway or
+             *         pending.
+             */
+            bool isIdle() const;
+
+            /**
+             * Method you can use to set the state assumed at the end of the block preceding the first block.  Use
+             * this when the document holds a window into a larger file so that the first block is highlighted as if
+             * the lines above it were present.  Blocks are scanned again, starting with the first block, until their
+             * states match.
+             *
+             * \param[in] newInitialBlockState The new initial block state.  A value of -1 indicates the start of the
+             *                                 file.
+             */
+            void setInitialBlockState(int newInitialBlockState);
+
+            /**
+             * Method you can use to obtain the state assumed at the end of the block preceding the first block.
+             *
+             * \return Returns the initial block state.
+             */
+            int initialBlockState() const;
+
+        signals:
+            /**
+             * Signal that is emitted when every block has been highlighted.
+             */
+            void highlightingFinished();
+
+        public slots:
+            /**
+             * Slot you can use to highlight the entire document again.
+             */
+            void rehighlight();
+
+        private slots:
+            /**
+             * Slot that is triggered when the document contents change.
+             *
+             * \param[in] position     The position of the change.
+             *
+             * \param[in] charsRemoved The number of characters removed.
+             *
+             * \param[in] charsAdded   The number of characters added.
+             */
+            void contentsChange(int position, int charsRemoved, int charsAdded);
+
+            /**
+             * Slot that is triggered to start a scan of the dirty blocks.
+             */
+            void startScan();
+
+            /**
+             * Slot that is triggered by the worker thread when batches are waiting to be applied.
+             */
+            void batchesReady();
+
+        private:
+            class Batch;
+            class Context;
+            class Scanner;
+
+            /**
+             * Method that cancels any scan underway, folding its unfinished blocks back into the dirty range.
+             */
+            void cancelScan();
+
+            /**
+             * Method that adds a range of blocks to the dirty range.
+             *
+             * \param[in] firstBlock The first dirty block.
+             *
+             * \param[in] lastBlock  The last dirty block.
+             */
+            void markDirty(int firstBlock, int lastBlock);
+
+            /**
+             * Method that applies a batch of formats to the document.
+             *
+             * \param[in] batch The batch to apply.
+             */
+            void applyBatch(const Batch& batch);
+
+            /**
+             * The editor holding the document.
+             */
+            QPointer<QPlainTextEdit> currentEditor;
+
+            /**
+             * The document being highlighted.
+             */
+            QPointer<QTextDocument> currentDocument;
+
+            /**
+             * The current rule set.
+             */
+            QSharedPointer<const SyntaxRuleSet> currentRuleSet;
+
+            /**
+             * The current thread pool.
+             */
+            QThreadPool* currentThreadPool;
+
+            /**
+             * Timer used to coalesce edits before a scan starts.
+             */
+            QTimer* scanTimer;
+
+            /**
+             * Snapshot of the block texts.
+             */
+            QVector<QString> blockTexts;
+
+            /**
+             * The state at the end of each block as of the last in-order scan.
+             */
+            QVector<int> blockStates;
+
+            /**
+             * The first block needing a scan, or -1 if no blocks are dirty.
+             */
+            int firstDirtyBlock;
+
+            /**
+             * The last block known to need a scan.  Scanning continues past this block until block states match.
+             */
+            int lastDirtyBlock;
+
+            /**
+             * Context shared with the worker thread for the scan underway.
+             */
+            QSharedPointer<Context> currentContext;
+
+            /**
+             * The next block the scan underway will deliver in order.
+             */
+            int scanNextBlock;
+
+            /**
+             * The last dirty block of the scan underway.
+             */
+            int scanLastDirtyBlock;
+
+            /**
+             * The state assumed at the end of the block preceding the first block.
+             */
+            int currentInitialBlockState;
+
+            /**
+             * Flag used to ignore document changes caused by applying formats.
+             */
+            bool applyingBatch;
+    };
+}
+
+#endif
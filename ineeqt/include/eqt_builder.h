@@ -59,6 +59,10 @@ namespace EQt {
      *       tab in the window becomes the current tab.
      *     * Dynamic actions within a main window are unbound dynamically whenever a tab is deselected.
      *
+     * For application start-up, methods are called in the following order:
+     *     * prepare, called concurrently for all builders on worker threads
+     *     * registerResources
+     *
      * For window creation, methods are called in the following order:
      *     * buildMainWindowGui
      *     * buildAdditionalMainWindowActions
@@ -91,6 +95,16 @@ namespace EQt {
 
             ~Builder() override;
 
+            /**
+             * Method that is called once on a worker thread before any GUI is built.  Builders can use this method
+             * for work that does not involve the GUI, such as loading data files or parsing resources.  Builders are
+             * prepared concurrently, so this method must not access widgets and must synchronize access to any data
+             * shared with other builders.
+             *
+             * The default implementation simply returns, performing no action.
+             */
+            virtual void prepare();
+
             /**
              * Method that is called once when the plug-in is loaded to register any resources and to create any global
              * settings used by the application.  The default implementation simply returns, performing no action.
@@ -0,0 +1,241 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::BuilderProfiler class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_BUILDER_PROFILER_H
+#define EQT_BUILDER_PROFILER_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include "eqt_common.h"
+
+namespace EQt {
+    class BuilderBase;
+
+    /**
+     * Class that collects the time spent by each builder in each build phase.  You can use the report generated by
+     * this class to identify the builders that slow down application start-up.
+     *
+     * Profiling is disabled by default.  The class is thread safe so builders prepared on worker threads can be
+     * profiled alongside the GUI phases.
+     */
+    class EQT_PUBLIC_API BuilderProfiler {
+        public:
+            /**
+             * Class that holds the accumulated time spent by one builder in one phase.
+             */
+            class EQT_PUBLIC_API Timing {
+                public:
+                    Timing();
+
+                    /**
+                     * Constructor.
+                     *
+                     * \param[in] builderIdentifier The identifier of the builder.
+                     *
+                     * \param[in] plugInName        The name of the plug-in that supplied the builder.
+                     *
+                     * \param[in] phase             The name of the phase.
+                     */
+                    Timing(const QString& builderIdentifier, const QString& plugInName, const QString& phase);
+
+                    ~Timing();
+
+                    /**
+                     * Method you can use to obtain the identifier of the builder.
+                     *
+                     * \return Returns the builder identifier.
+                     */
+                    const QString& builderIdentifier() const;
+
+                    /**
+                     * Method you can use to obtain the name of the plug-in that supplied the builder.
+                     *
+                     * \return Returns the plug-in name.
+                     */
+                    const QString& plugInName() const;
+
+                    /**
+                     * Method you can use to obtain the name of the phase.
+                     *
+                     * \return Returns the phase name.  By convention, this is the name of the builder method.
+                     */
+                    const QString& phase() const;
+
+                    /**
+                     * Method you can use to obtain the number of times the phase was run.
+                     *
+                     * \return Returns the number of calls.
+                     */
+                    unsigned long numberCalls() const;
+
+                    /**
+                     * Method you can use to obtain the total time spent in the phase.
+                     *
+                     * \return Returns the total time, in nanoseconds.
+                     */
+                    qint64 elapsedNanoseconds() const;
+
+                    /**
+                     * Method that adds a call to this timing.
+                     *
+                     * \param[in] nanoseconds The time spent in the call, in nanoseconds.
+                     */
+                    void addCall(qint64 nanoseconds);
+
+                private:
+                    QString       currentBuilderIdentifier;
+                    QString       currentPlugInName;
+                    QString       currentPhase;
+                    unsigned long currentNumberCalls;
+                    qint64        currentElapsedNanoseconds;
+            };
+
+            /**
+             * Class that times a single builder call.  The time is recorded when the instance is destroyed.  The
+             * class does nothing if profiling is disabled.
+             */
+            class EQT_PUBLIC_API Scope {
+                public:
+                    /**
+                     * Constructor.
+                     *
+                     * \param[in] builder The builder being called.
+                     *
+                     * \param[in] phase   The name of the phase.  The string must outlive this instance.
+                     */
+                    Scope(const BuilderBase* builder, const char* phase);
+
+                    ~Scope();
+
+                private:
+                    const BuilderBase* currentBuilder;
+                    const char*        currentPhase;
+                    QElapsedTimer      timer;
+            };
+
+            /**
+             * Method you can use to enable or disable profiling.
+             *
+             * \param[in] nowEnabled If true, profiling will be enabled.  If false, profiling will be disabled.
+             */
+            static void setProfilingEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable profiling.
+             *
+             * \param[in] nowDisabled If true, profiling will be disabled.  If false, profiling will be enabled.
+             */
+            static void setProfilingDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if profiling is enabled.
+             *
+             * \return Returns true if profiling is enabled.  Returns false if profiling is disabled.
+             */
+            static bool profilingEnabled();
+
+            /**
+             * Method you can use to determine if profiling is disabled.
+             *
+             * \return Returns true if profiling is disabled.  Returns false if profiling is enabled.
+             */
+            static bool profilingDisabled();
+
+            /**
+             * Method that records the time spent in one builder call.  Calls are recorded even if profiling is
+             * disabled.
+             *
+             * \param[in] builder            The builder that was called.
+             *
+             * \param[in] phase              The name of the phase.
+             *
+             * \param[in] elapsedNanoseconds The time spent in the call, in nanoseconds.
+             */
+            static void record(const BuilderBase* builder, const char* phase, qint64 elapsedNanoseconds);
+
+            /**
+             * Method you can use to obtain the recorded timings.
+             *
+             * \return Returns the recorded timings, slowest first.
+             */
+            static QList<Timing> timings();
+
+            /**
+             * Method you can use to obtain a human readable start-up report.
+             *
+             * \return Returns a report holding one line per builder and phase, slowest first.
+             */
+            static QString report();
+
+            /**
+             * Method you can use to discard the recorded timings.
+             */
+            static void clear();
+
+        private:
+            /**
+             * Type used to index timings by builder identifier and phase.
+             */
+            typedef QPair<QString, QString> TimingKey;
+
+            /**
+             * Method used to order timings, slowest first.
+             *
+             * \param[in] first  The first timing to compare.
+             *
+             * \param[in] second The second timing to compare.
+             *
+             * \return Returns true if the first timing is slower than the second.
+             */
+            static bool slowerTiming(const Timing& first, const Timing& second);
+
+            /**
+             * Flag indicating if profiling is enabled.
+             */
+            static QAtomicInt currentProfilingEnabled;
+
+            /**
+             * Mutex used to guard the recorded timings.
+             */
+            static QMutex timingMutex;
+
+            /**
+             * The recorded timings.
+             */
+            static QHash<TimingKey, Timing> currentTimings;
+    };
+}
+
+#endif
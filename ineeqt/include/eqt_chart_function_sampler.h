@@ -0,0 +1,300 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::ChartFunctionSampler class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_CHART_FUNCTION_SAMPLER_H
+#define EQT_CHART_FUNCTION_SAMPLER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
+#include <QPolygonF>
+
+#include <functional>
+
+#include "eqt_charts.h"
+#include "eqt_common.h"
+
+class QThreadPool;
+
+namespace EQt {
+    /**
+     * Class that samples a function for display in a QXYSeries.  The function is evaluated on a pool of worker
+     * threads.  Each thread starts from a uniform grid over its part of the domain, then subdivides segments where
+     * the plotted curve bends sharply or where the function becomes undefined.  The finished points are delivered to
+     * the series in a single update.
+     *
+     * Bend angles are measured in plot pixels using the ranges of the axes attached to the series and the chart's
+     * plot area, so refinement tracks what the user actually sees.  For \ref EQt::Polar2DChartItem the function
+     * is treated as a radius in terms of angle.
+     *
+     * The function must be safe to call from several threads at once.  Points where the function returns a value
+     * that is not finite are omitted.
+     */
+    class EQT_PUBLIC_API ChartFunctionSampler:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * Type of function that can be sampled.
+             */
+            typedef std::function<double(double)> Function;
+
+            /**
+             * The default number of uniformly spaced samples used before refinement.
+             */
+            static const unsigned defaultInitialNumberSamples;
+
+            /**
+             * The default maximum number of times a segment can be subdivided.
+             */
+            static const unsigned defaultMaximumRefinementDepth;
+
+            /**
+             * The default maximum bend, in degrees, allowed between adjacent segments.
+             */
+            static const double defaultMaximumAngle;
+
+            /**
+             * Constructor
+             *
+             * \param[in] series The series to receive the sampled points.
+             *
+             * \param[in] parent Pointer to the parent object.
+             */
+            ChartFunctionSampler(QXYSeries* series, QObject* parent = Q_NULLPTR);
+
+            ~ChartFunctionSampler() override;
+
+            /**
+             * Method you can use to obtain the series receiving the sampled points.
+             *
+             * \return Returns the series.
+             */
+            QXYSeries* series() const;
+
+            /**
+             * Method you can use to set the thread pool used to evaluate the function.
+             *
+             * \param[in] newThreadPool The new thread pool.  A null pointer will cause the global thread pool to be
+             *                          used.
+             */
+            void setThreadPool(QThreadPool* newThreadPool);
+
+            /**
+             * Method you can use to obtain the thread pool used to evaluate the function.
+             *
+             * \return Returns the thread pool used to evaluate the function.
+             */
+            QThreadPool* threadPool() const;
+
+            /**
+             * Method you can use to set the number of uniformly spaced samples used before refinement.
+             *
+             * \param[in] newInitialNumberSamples The new number of initial samples.
+             */
+            void setInitialNumberSamples(unsigned newInitialNumberSamples);
+
+            /**
+             * Method you can use to obtain the number of uniformly spaced samples used before refinement.
+             *
+             * \return Returns the number of initial samples.
+             */
+            unsigned initialNumberSamples() const;
+
+            /**
+             * Method you can use to set the maximum number of times a segment can be subdivided.
+             *
+             * \param[in] newMaximumRefinementDepth The new maximum refinement depth.
+             */
+            void setMaximumRefinementDepth(unsigned newMaximumRefinementDepth);
+
+            /**
+             * Method you can use to obtain the maximum number of times a segment can be subdivided.
+             *
+             * \return Returns the maximum refinement depth.
+             */
+            unsigned maximumRefinementDepth() const;
+
+            /**
+             * Method you can use to set the maximum bend allowed between adjacent segments before they are
+             * subdivided.
+             *
+             * \param[in] newMaximumAngle The new maximum angle, in degrees.
+             */
+            void setMaximumAngle(double newMaximumAngle);
+
+            /**
+             * Method you can use to obtain the maximum bend allowed between adjacent segments.
+             *
+             * \return Returns the maximum angle, in degrees.
+             */
+            double maximumAngle() const;
+
+            /**
+             * Method you can use to have the function sampled again, over the new range, whenever the horizontal
+             * axis range changes.
+             *
+             * \param[in] nowEnabled If true, the function will be resampled when the view changes.  If false, the
+             *                       view can change without resampling.
+             */
+            void setAutomaticResamplingEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to determine if the function is resampled when the view changes.
+             *
+             * \return Returns true if automatic resampling is enabled.
+             */
+            bool automaticResamplingEnabled() const;
+
+            /**
+             * Method you can use to determine if sampling is underway.
+             *
+             * \return Returns true if sampling is underway.  Returns false if the sampler is idle.
+             */
+            bool isActive() const;
+
+            /**
+             * Method you can use to start sampling a function.  Any sampling already underway is canceled.
+             *
+             * \param[in] function The function to be sampled.
+             *
+             * \param[in] minimum  The start of the domain to be sampled.
+             *
+             * \param[in] maximum  The end of the domain to be sampled.
+             */
+            void sample(const Function& function, double minimum, double maximum);
+
+        signals:
+            /**
+             * Signal that is emitted when sampling ends.
+             *
+             * \param[in] completed Holds true if the series was updated.  Holds false if sampling was canceled.
+             */
+            void finished(bool completed);
+
+        public slots:
+            /**
+             * Slot you can use to cancel sampling.  The series is not modified.
+             */
+            void cancel();
+
+        private slots:
+            /**
+             * Slot that is triggered by the worker threads when part of the domain has been sampled.
+             *
+             * \param[in] generation The sampling run the points belong to.
+             *
+             * \param[in] chunkIndex The zero based index of the part of the domain.
+             *
+             * \param[in] points     The sampled points.
+             */
+            void chunkSampled(unsigned generation, unsigned chunkIndex, const QPolygonF& points);
+
+            /**
+             * Slot that is triggered when the horizontal axis range changes.
+             *
+             * \param[in] minimum The new axis minimum.
+             *
+             * \param[in] maximum The new axis maximum.
+             */
+            void axisRangeChanged(qreal minimum, qreal maximum);
+
+        private:
+            class Context;
+            class ChunkSampler;
+
+            /**
+             * Method that connects to the horizontal axis attached to the series, if needed.
+             */
+            void attach();
+
+            /**
+             * The series receiving points.
+             */
+            QPointer<QXYSeries> currentSeries;
+
+            /**
+             * The horizontal axis attached to the series.
+             */
+            QPointer<QValueAxis> currentAxis;
+
+            /**
+             * Context shared with the worker threads for the current run.
+             */
+            QSharedPointer<Context> currentContext;
+
+            /**
+             * The current thread pool.
+             */
+            QThreadPool* currentThreadPool;
+
+            /**
+             * The number of initial samples.
+             */
+            unsigned currentInitialNumberSamples;
+
+            /**
+             * The maximum refinement depth.
+             */
+            unsigned currentMaximumRefinementDepth;
+
+            /**
+             * The maximum angle, in degrees.
+             */
+            double currentMaximumAngle;
+
+            /**
+             * Flag indicating if automatic resampling is enabled.
+             */
+            bool currentAutomaticResamplingEnabled;
+
+            /**
+             * The most recently sampled function.
+             */
+            Function currentFunction;
+
+            /**
+             * Counter used to identify each sampling run.
+             */
+            unsigned currentGeneration;
+
+            /**
+             * Points received for the current run, by chunk.
+             */
+            QVector<QPolygonF> sampledChunks;
+
+            /**
+             * The number of chunks still outstanding for the current run.
+             */
+            unsigned numberOutstandingChunks;
+    };
+}
+
+#endif
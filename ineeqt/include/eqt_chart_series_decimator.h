@@ -0,0 +1,260 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::ChartSeriesDecimator class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_CHART_SERIES_DECIMATOR_H
+#define EQT_CHART_SERIES_DECIMATOR_H
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+
+#include "eqt_charts.h"
+#include "eqt_common.h"
+
+namespace EQt {
+    /**
+     * Class that holds full resolution data for a QXYSeries and feeds the series a reduced view sized to the
+     * chart's plot area.  The view is recalculated whenever the horizontal axis range or the plot area changes so
+     * zooming and panning reveal detail while the number of points handed to QtCharts stays proportional to the
+     * plot width.
+     *
+     * Data must be sorted by increasing X value.  The class works with \ref EQt::ChartItem and
+     * \ref EQt::Polar2DChartItem.  For polar charts, the angular axis is treated as the horizontal axis.
+     */
+    class EQT_PUBLIC_API ChartSeriesDecimator:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * Enumeration of supported decimation methods.
+             */
+            enum class Method {
+                /**
+                 * Value indicating that each bucket is reduced to its minimum and maximum Y values, in the order they
+                 * occur.  This method preserves peaks and is well suited for dense, noisy data.  Buckets hold a power
+                 * of two number of points and are read from a min/max pyramid built when the data is set, so the cost
+                 * of a view update is proportional to the plot width rather than the number of visible points.
+                 */
+                MIN_MAX,
+
+                /**
+                 * Value indicating the largest-triangle-three-buckets method.  This method preserves the visual shape
+                 * of the data using fewer points.
+                 */
+                LTTB
+            };
+
+            /**
+             * The default number of points generated per horizontal pixel of the plot area.
+             */
+            static const double defaultPointsPerPixel;
+
+            /**
+             * Constructor
+             *
+             * \param[in] series The series to receive the decimated data.  The series should be added to its chart
+             *                   and attached to its axes before data is supplied.
+             *
+             * \param[in] parent Pointer to the parent object.
+             */
+            ChartSeriesDecimator(QXYSeries* series, QObject* parent = Q_NULLPTR);
+
+            ~ChartSeriesDecimator() override;
+
+            /**
+             * Method you can use to obtain the series receiving the decimated data.
+             *
+             * \return Returns the series.
+             */
+            QXYSeries* series() const;
+
+            /**
+             * Method you can use to set the decimation method.
+             *
+             * \param[in] newMethod The new decimation method.
+             */
+            void setMethod(Method newMethod);
+
+            /**
+             * Method you can use to obtain the decimation method.
+             *
+             * \return Returns the decimation method.
+             */
+            Method method() const;
+
+            /**
+             * Method you can use to set the number of points generated per horizontal pixel of the plot area.
+             *
+             * \param[in] newPointsPerPixel The new number of points per pixel.
+             */
+            void setPointsPerPixel(double newPointsPerPixel);
+
+            /**
+             * Method you can use to obtain the number of points generated per horizontal pixel of the plot area.
+             *
+             * \return Returns the number of points per pixel.
+             */
+            double pointsPerPixel() const;
+
+            /**
+             * Method you can use to set the full resolution data.
+             *
+             * \param[in] newData The new data, sorted by increasing X value.
+             */
+            void setData(const QVector<QPointF>& newData);
+
+            /**
+             * Method you can use to set the full resolution data without copying it.
+             *
+             * \param[in] newData The new data, sorted by increasing X value.
+             */
+            void setData(QVector<QPointF>&& newData);
+
+            /**
+             * Method you can use to obtain the full resolution data.
+             *
+             * \return Returns the full resolution data.
+             */
+            const QVector<QPointF>& data() const;
+
+            /**
+             * Method that reduces data using min/max bucketing.
+             *
+             * \param[in] begin         Pointer to the first point to be reduced.
+             *
+             * \param[in] end           Pointer past the last point to be reduced.
+             *
+             * \param[in] numberBuckets The number of buckets.  Each bucket contributes at most two points.
+             *
+             * \return Returns the reduced points.  The first and last points are always included and no point is
+             *         included more than once.
+             */
+            static QVector<QPointF> minMaxDecimate(const QPointF* begin, const QPointF* end, unsigned numberBuckets);
+
+            /**
+             * Method that reduces data using the largest-triangle-three-buckets method.
+             *
+             * \param[in] begin        Pointer to the first point to be reduced.
+             *
+             * \param[in] end          Pointer past the last point to be reduced.
+             *
+             * \param[in] numberPoints The desired number of points.
+             *
+             * \return Returns the reduced points.
+             */
+            static QVector<QPointF> lttbDecimate(const QPointF* begin, const QPointF* end, unsigned numberPoints);
+
+        public slots:
+            /**
+             * Slot you can trigger to recalculate the reduced view sent to the series.
+             */
+            void updateView();
+
+        private slots:
+            /**
+             * Slot that is triggered when the horizontal axis range changes.
+             *
+             * \param[in] minimum The new axis minimum.
+             *
+             * \param[in] maximum The new axis maximum.
+             */
+            void axisRangeChanged(qreal minimum, qreal maximum);
+
+            /**
+             * Slot that is triggered when the chart plot area changes.
+             *
+             * \param[in] plotArea The new plot area.
+             */
+            void plotAreaChanged(const QRectF& plotArea);
+
+        private:
+            /**
+             * Method that locates and connects to the series' chart and horizontal axis.
+             */
+            void attach();
+
+            /**
+             * Method that rebuilds the min/max pyramid from the full resolution data.
+             */
+            void buildPyramid();
+
+            /**
+             * Method that reduces a range of the full resolution data using the min/max pyramid.
+             *
+             * \param[in] begin         Pointer to the first point to be reduced.
+             *
+             * \param[in] end           Pointer past the last point to be reduced.
+             *
+             * \param[in] numberBuckets The desired number of buckets.  Each bucket contributes at most two points.
+             *
+             * \return Returns the reduced points.
+             */
+            QVector<QPointF> pyramidDecimate(const QPointF* begin, const QPointF* end, unsigned numberBuckets) const;
+
+            /**
+             * The series receiving decimated data.
+             */
+            QPointer<QXYSeries> currentSeries;
+
+            /**
+             * The chart the series belongs to.
+             */
+            QPointer<QChart> currentChart;
+
+            /**
+             * The horizontal axis attached to the series.
+             */
+            QPointer<QValueAxis> currentAxis;
+
+            /**
+             * The current decimation method.
+             */
+            Method currentMethod;
+
+            /**
+             * The current number of points per pixel.
+             */
+            double currentPointsPerPixel;
+
+            /**
+             * The full resolution data.
+             */
+            QVector<QPointF> currentData;
+
+            /**
+             * The min/max pyramid.  Entry k holds the level whose buckets span 2^(k+1) points, storing the index of
+             * the minimum and then the maximum point of each bucket.  Only complete buckets are stored.
+             */
+            QVector<QVector<unsigned>> currentPyramid;
+    };
+}
+
+#endif
@@ -0,0 +1,321 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::ChartStreamingSeries class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_CHART_STREAMING_SERIES_H
+#define EQT_CHART_STREAMING_SERIES_H
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+
+#include "eqt_charts.h"
+#include "eqt_common.h"
+
+class QTimer;
+
+namespace EQt {
+    /**
+     * Class that feeds a QXYSeries from a fixed capacity ring buffer for live plotting.  Appending a sample is a
+     * constant time operation that never moves existing samples.  Once the buffer is full, each new sample replaces
+     * the oldest sample.
+     *
+     * Changes are published to the series at most once per frame, driven by a single shot timer, so any number of
+     * samples appended between frames result in a single repaint.  Only the samples within the range of the horizontal
+     * axis are published.  When more samples are visible than the plot is wide, the published points are reduced
+     * using \ref EQt::ChartSeriesDecimator::minMaxDecimate.  A frame is also published when the range of the horizontal
+     * axis or the plot area changes, so zooming or panning a paused stream shows the newly visible samples.
+     *
+     * Samples must be appended in order of increasing X value.
+     */
+    class EQT_PUBLIC_API ChartStreamingSeries:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * Enumeration of policies used to move the horizontal axis as samples arrive.
+             */
+            enum class ScrollPolicy {
+                /**
+                 * Value indicating that the axis is not modified.
+                 */
+                NONE,
+
+                /**
+                 * Value indicating that the axis keeps its current span and scrolls so the newest sample is at the
+                 * right edge.
+                 */
+                FOLLOW_NEWEST,
+
+                /**
+                 * Value indicating that the axis is adjusted to span every sample in the buffer.
+                 */
+                SHOW_ALL
+            };
+
+            /**
+             * The default interval between published frames, in milliseconds.
+             */
+            static const unsigned defaultFrameInterval;
+
+            /**
+             * Constructor
+             *
+             * \param[in] series   The series to receive the samples.
+             *
+             * \param[in] capacity The maximum number of samples held.
+             *
+             * \param[in] parent   Pointer to the parent object.
+             */
+            ChartStreamingSeries(QXYSeries* series, unsigned capacity, QObject* parent = Q_NULLPTR);
+
+            ~ChartStreamingSeries() override;
+
+            /**
+             * Method you can use to obtain the series receiving the samples.
+             *
+             * \return Returns the series.
+             */
+            QXYSeries* series() const;
+
+            /**
+             * Method you can use to change the buffer capacity.  The newest samples are retained.
+             *
+             * \param[in] newCapacity The new capacity.
+             */
+            void setCapacity(unsigned newCapacity);
+
+            /**
+             * Method you can use to obtain the buffer capacity.
+             *
+             * \return Returns the maximum number of samples held.
+             */
+            unsigned capacity() const;
+
+            /**
+             * Method you can use to determine the number of samples currently held.
+             *
+             * \return Returns the number of samples held.
+             */
+            unsigned numberSamples() const;
+
+            /**
+             * Method you can use to obtain a sample.
+             *
+             * \param[in] index The zero based index of the sample.  Index zero is the oldest sample.
+             *
+             * \return Returns the requested sample.
+             */
+            const QPointF& at(unsigned index) const;
+
+            /**
+             * Method you can use to set the axis scroll policy.
+             *
+             * \param[in] newScrollPolicy The new scroll policy.
+             */
+            void setScrollPolicy(ScrollPolicy newScrollPolicy);
+
+            /**
+             * Method you can use to obtain the axis scroll policy.
+             *
+             * \return Returns the current scroll policy.
+             */
+            ScrollPolicy scrollPolicy() const;
+
+            /**
+             * Method you can use to set the interval between published frames.
+             *
+             * \param[in] newFrameInterval The new frame interval, in milliseconds.
+             */
+            void setFrameInterval(unsigned newFrameInterval);
+
+            /**
+             * Method you can use to obtain the interval between published frames.
+             *
+             * \return Returns the frame interval, in milliseconds.
+             */
+            unsigned frameInterval() const;
+
+        public slots:
+            /**
+             * Slot you can use to append a sample.
+             *
+             * \param[in] sample The sample to be appended.
+             */
+            void append(const QPointF& sample);
+
+            /**
+             * Slot you can use to append a sample.
+             *
+             * \param[in] x The sample X value.
+             *
+             * \param[in] y The sample Y value.
+             */
+            void append(double x, double y);
+
+            /**
+             * Slot you can use to append a block of samples.
+             *
+             * \param[in] samples The samples to be appended, in order.
+             */
+            void append(const QVector<QPointF>& samples);
+
+            /**
+             * Slot you can use to remove every sample.
+             */
+            void clear();
+
+            /**
+             * Slot you can use to publish pending changes to the series immediately.  Call this method after adding
+             * the series to a chart or attaching it to an axis so that changes to the axis range and plot area are
+             * tracked before the next sample arrives.
+             */
+            void flush();
+
+        private slots:
+            /**
+             * Slot that is triggered when the frame timer expires.
+             */
+            void frameTimeout();
+
+            /**
+             * Slot that is triggered when the range of the horizontal axis changes.
+             *
+             * \param[in] minimum The new axis minimum.
+             *
+             * \param[in] maximum The new axis maximum.
+             */
+            void axisRangeChanged(qreal minimum, qreal maximum);
+
+            /**
+             * Slot that is triggered when the chart's plot area changes.
+             *
+             * \param[in] plotArea The new plot area.
+             */
+            void plotAreaChanged(const QRectF& plotArea);
+
+        private:
+            /**
+             * Method that schedules a frame if one is not already pending.
+             */
+            void scheduleFrame();
+
+            /**
+             * Method that connects to the chart holding the series and to its horizontal axis.  Connections to a
+             * previous chart or axis are removed if the series has moved.
+             */
+            void attach();
+
+            /**
+             * Method that locates the horizontal axis attached to the series.
+             *
+             * \return Returns the horizontal value axis, or a null pointer if there is no such axis.
+             */
+            QValueAxis* horizontalAxis() const;
+
+            /**
+             * Method that locates the first sample at or after an X value.
+             *
+             * \param[in] x The X value.
+             *
+             * \return Returns the zero based index of the first sample, oldest first, whose X value is not less than
+             *         the supplied value.
+             */
+            unsigned firstSampleAtOrAfter(double x) const;
+
+            /**
+             * Method that locates the first sample after an X value.
+             *
+             * \param[in] x The X value.
+             *
+             * \return Returns the zero based index of the first sample, oldest first, whose X value is greater than
+             *         the supplied value.
+             */
+            unsigned firstSampleAfter(double x) const;
+
+            /**
+             * The series receiving samples.
+             */
+            QPointer<QXYSeries> currentSeries;
+
+            /**
+             * The sample storage.  The buffer is allocated once, at full capacity.
+             */
+            QVector<QPointF> currentBuffer;
+
+            /**
+             * Index of the oldest sample in the buffer.
+             */
+            unsigned currentHead;
+
+            /**
+             * The number of samples held.
+             */
+            unsigned currentNumberSamples;
+
+            /**
+             * Scratch buffer used to present the visible samples in order when publishing a frame.  Retained between
+             * frames to avoid repeated allocation.
+             */
+            QVector<QPointF> publishBuffer;
+
+            /**
+             * The current scroll policy.
+             */
+            ScrollPolicy currentScrollPolicy;
+
+            /**
+             * Timer used to batch changes into frames.
+             */
+            QTimer* frameTimer;
+
+            /**
+             * Flag indicating that samples have changed since the last frame.
+             */
+            bool currentFrameIsPending;
+
+            /**
+             * Flag used to ignore axis range changes made while a frame is published.
+             */
+            bool publishingFrame;
+
+            /**
+             * The chart holding the series.
+             */
+            QPointer<QChart> currentChart;
+
+            /**
+             * The horizontal axis attached to the series.
+             */
+            QPointer<QValueAxis> currentAxis;
+    };
+}
+
+#endif
@@ -32,19 +32,33 @@
 
 #include <QWidget>
 #include <QString>
+#include <QVector>
+#include <QSharedPointer>
 #include <QPlainTextEdit>
 
 #include "eqt_common.h"
 
 class QResizeEvent;
 class QSyntaxHighlighter;
+class QScrollBar;
+class QTimer;
+
+class CodeEditorFileIndex;
 
 namespace EQt {
     class CodeEditorLineNumberArea;
+    class SyntaxRuleSet;
 
     /**
      * Class that extends QPlainTextEdit with support for line numbers.
      *
+     * The class also supports loading very large files.  The file is memory mapped and its lines are indexed on a
+     * worker thread.  The file can then either be inserted into the document in chunks, or displayed read-only through
+     * a virtualized view that only holds the lines near the viewport in the document.  In virtualized mode, the block
+     * state is recorded every \ref EQt::CodeEditor::linesPerStateCheckpoint lines by a pass that runs from the event
+     * loop, so an attached \ref EQt::SyntaxHighlighter or \ref EQt::BackgroundSyntaxHighlighter highlights each window
+     * as if the lines above it were present.
+     *
      * This code was heavily inspired by The Qt 4 code editor example.
      */
     class EQT_PUBLIC_API CodeEditor:public QPlainTextEdit {
@@ -53,6 +67,44 @@ namespace EQt {
         Q_OBJECT
 
         public:
+            /**
+             * Enumeration of modes used to load large files.
+             */
+            enum class LargeFileMode {
+                /**
+                 * Indicates no large file is loaded.  The document holds the entire text.
+                 */
+                DISABLED,
+
+                /**
+                 * Indicates the file is inserted into the document in chunks.  The editor is read-only while the file
+                 * is loaded and behaves as a normal editor once loading completes.
+                 */
+                CHUNKED,
+
+                /**
+                 * Indicates the file is displayed read-only.  The document only holds a window of lines around the
+                 * viewport and is refilled from the file as the view is scrolled.
+                 */
+                VIRTUALIZED
+            };
+
+            /**
+             * The number of lines inserted each time the event loop runs while loading in chunked mode.
+             */
+            static const unsigned linesPerChunk;
+
+            /**
+             * The number of lines held in the document when in virtualized mode.
+             */
+            static const unsigned virtualWindowLines;
+
+            /**
+             * The number of lines between recorded block states in virtualized mode.  This is also the number of
+             * lines scanned each time the event loop runs.
+             */
+            static const unsigned linesPerStateCheckpoint;
+
             /**
              * Constructor.
              *
@@ -78,6 +130,67 @@ namespace EQt {
              */
             CodeEditorLineNumberArea* lineNumberArea() const;
 
+            /**
+             * Method that loads a large file.  The file is memory mapped and indexed on a worker thread.  Progress is
+             * reported using the \ref EQt::CodeEditor::largeFileLoadProgress signal and completion is reported using
+             * the \ref EQt::CodeEditor::largeFileLoaded signal.  Any previously loaded large file is closed first.
+             * The file is assumed to be UTF-8 encoded.
+             *
+             * \param[in] filename The file to be loaded.
+             *
+             * \param[in] mode     The mode used to load the file.  \ref EQt::CodeEditor::LargeFileMode::DISABLED is
+             *                     treated as \ref EQt::CodeEditor::LargeFileMode::CHUNKED.
+             *
+             * \return Returns true if loading was started.  Returns false if the file could not be mapped.
+             */
+            bool loadLargeFile(const QString& filename, LargeFileMode mode = LargeFileMode::VIRTUALIZED);
+
+            /**
+             * Method you can use to determine the current large file mode.
+             *
+             * \return Returns the current large file mode.
+             */
+            LargeFileMode largeFileMode() const;
+
+            /**
+             * Method you can use to determine if a large file is being loaded.
+             *
+             * \return Returns true if a large file is being loaded.
+             */
+            bool largeFileIsLoading() const;
+
+            /**
+             * Method you can use to determine the number of lines in the editor.  In virtualized mode, this is the
+             * number of lines indexed in the file rather than the number of blocks in the document.
+             *
+             * \return Returns the number of lines.
+             */
+            unsigned long lineCount() const;
+
+            /**
+             * Method you can use to determine the line held in the first block of the document.  The value is only
+             * non-zero in virtualized mode.
+             *
+             * \return Returns the zero based line number of the first document block.
+             */
+            unsigned long firstLineNumber() const;
+
+            /**
+             * Method you can use to set the rule set used to record block states in virtualized mode.  The rule set
+             * should match the one used by the highlighter attached to this editor.
+             *
+             * \param[in] newRuleSet The new rule set.  A null pointer disables block state recording and each window
+             *                       is highlighted as if it started the file.
+             */
+            void setSyntaxRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet);
+
+            /**
+             * Method you can use to obtain the rule set used to record block states in virtualized mode.
+             *
+             * \return Returns the rule set.
+             */
+            QSharedPointer<const SyntaxRuleSet> syntaxRuleSet() const;
+
         public slots:
             /**
              * Slot you can use to update the line number area.
@@ -87,6 +200,36 @@ namespace EQt {
              */
             void setLineNumberArea(CodeEditorLineNumberArea* newLineNumberArea);
 
+            /**
+             * Slot you can trigger to cancel loading of a large file.  In chunked mode, the lines inserted so far are
+             * kept and the editor returns to normal operation.  In virtualized mode, the lines indexed so far remain
+             * viewable.  The \ref EQt::CodeEditor::largeFileLoaded signal is emitted with a value of false.
+             */
+            void cancelLargeFileLoad();
+
+            /**
+             * Slot you can trigger to close a large file.  Loading is canceled, the document is cleared, and the
+             * editor returns to normal operation.
+             */
+            void closeLargeFile();
+
+        signals:
+            /**
+             * Signal that is emitted as a large file is loaded.
+             *
+             * \param[in] bytesLoaded The number of bytes loaded so far.
+             *
+             * \param[in] totalBytes  The file size, in bytes.
+             */
+            void largeFileLoadProgress(qint64 bytesLoaded, qint64 totalBytes);
+
+            /**
+             * Signal that is emitted when loading of a large file ends.
+             *
+             * \param[in] success Holds true if the entire file was loaded.  Holds false if loading was canceled.
+             */
+            void largeFileLoaded(bool success);
+
         protected:
             /**
              * Method that is called when this widget is resized.
@@ -95,16 +238,194 @@ namespace EQt {
              */
             void resizeEvent(QResizeEvent* event) override;
 
+        private slots:
+            /**
+             * Slot that is triggered as the large file is indexed.
+             *
+             * \param[in] bytesIndexed The number of bytes indexed so far.
+             *
+             * \param[in] totalBytes   The file size, in bytes.
+             */
+            void fileIndexProgress(qint64 bytesIndexed, qint64 totalBytes);
+
+            /**
+             * Slot that is triggered once the large file has been fully indexed.
+             */
+            void fileIndexFinished();
+
+            /**
+             * Slot that inserts the next chunk of lines in chunked mode.
+             */
+            void insertNextChunk();
+
+            /**
+             * Slot that is triggered when the virtual scroll bar is moved.
+             *
+             * \param[in] newValue The new scroll bar value, in lines.
+             */
+            void virtualScrollBarMoved(int newValue);
+
+            /**
+             * Slot that is triggered when the document is scrolled in virtualized mode.
+             *
+             * \param[in] newValue The new document scroll bar value, in blocks.
+             */
+            void documentScrolled(int newValue);
+
+            /**
+             * Slot that records the block state at the end of the next \ref EQt::CodeEditor::linesPerStateCheckpoint
+             * lines in virtualized mode.
+             */
+            void scanNextCheckpoint();
+
         private:
             /**
              * Method that is called by the constructors to configure the widget.
              */
             void configureWidget();
 
+            /**
+             * Method that updates the viewport margins to make room for the line number area and the virtual scroll
+             * bar.
+             */
+            void updateViewportMargins();
+
+            /**
+             * Method that positions the line number area and the virtual scroll bar.
+             */
+            void updateSideWidgetGeometry();
+
+            /**
+             * Method that updates the range of the virtual scroll bar.
+             */
+            void updateVirtualScrollBar();
+
+            /**
+             * Method that refills the document with a window of lines from the large file.
+             *
+             * \param[in] firstLine The zero based first line of the window.
+             */
+            void materializeWindow(unsigned long firstLine);
+
+            /**
+             * Method that calculates the state entering the first line of the window, starting from the nearest
+             * recorded block state, and passes it to the highlighters attached to this editor.
+             */
+            void updateWindowInitialState();
+
+            /**
+             * Method that passes an initial block state to the highlighters attached to this editor.
+             *
+             * \param[in] initialState The state at the end of the line preceding the first document block.
+             */
+            void applyInitialBlockState(int initialState);
+
+            /**
+             * Method that scans a range of lines.
+             *
+             * \param[in] ruleSet The rule set used to scan the lines.
+             *
+             * \param[in] text    The lines, separated by newline characters.
+             *
+             * \param[in] state   The state at the end of the line preceding the range.
+             *
+             * \return Returns the state at the end of the last line.
+             */
+            static int scanLines(const SyntaxRuleSet& ruleSet, const QString& text, int state);
+
+            /**
+             * Method that ends loading, restoring the editor's prior settings.
+             *
+             * \param[in] success The value to report through the \ref EQt::CodeEditor::largeFileLoaded signal.
+             */
+            void endLargeFileLoad(bool success);
+
             /**
              * The current line number area.
              */
             CodeEditorLineNumberArea* currentLineNumberArea;
+
+            /**
+             * The current large file mode.
+             */
+            LargeFileMode currentLargeFileMode;
+
+            /**
+             * Flag indicating that a large file was loaded and has not been closed.
+             */
+            bool currentLargeFileIsOpen;
+
+            /**
+             * The index of the large file.
+             */
+            CodeEditorFileIndex* currentFileIndex;
+
+            /**
+             * Flag indicating that a large file is being loaded.
+             */
+            bool currentlyLoading;
+
+            /**
+             * Flag holding the read-only setting in effect before the large file was loaded.
+             */
+            bool wasReadOnly;
+
+            /**
+             * Flag holding the undo/redo setting in effect before the large file was loaded.
+             */
+            bool wasUndoRedoEnabled;
+
+            /**
+             * Timer used to insert chunks from the event loop.
+             */
+            QTimer* chunkTimer;
+
+            /**
+             * The next line to be inserted in chunked mode.
+             */
+            unsigned long nextChunkLine;
+
+            /**
+             * Scroll bar spanning every line of the file in virtualized mode.
+             */
+            QScrollBar* virtualScrollBar;
+
+            /**
+             * The zero based line held in the first document block in virtualized mode.
+             */
+            unsigned long windowFirstLine;
+
+            /**
+             * The number of lines currently held in the document in virtualized mode.
+             */
+            unsigned long windowNumberLines;
+
+            /**
+             * Flag used to suppress feedback between the virtual and document scroll bars.
+             */
+            bool synchronizingScrollBars;
+
+            /**
+             * The rule set used to record block states.
+             */
+            QSharedPointer<const SyntaxRuleSet> currentRuleSet;
+
+            /**
+             * The state entering every \ref EQt::CodeEditor::linesPerStateCheckpoint lines.  Entry N holds the state at
+             * the end of the line preceding line N times \ref EQt::CodeEditor::linesPerStateCheckpoint.
+             */
+            QVector<int> stateCheckpoints;
+
+            /**
+             * Timer used to record block states from the event loop.
+             */
+            QTimer* checkpointTimer;
+
+            /**
+             * Flag indicating that the state entering the window was calculated from a recorded block state.  When
+             * false, the state is calculated again once the block states reach the window.
+             */
+            bool windowStateIsExact;
     };
 }
 
@@ -36,6 +36,7 @@
 #include <QSize>
 #include <QRect>
 #include <QTextBlock>
+#include <QStaticText>
 
 #include "eqt_common.h"
 
@@ -194,7 +195,8 @@ namespace EQt {
 
             /**
              * Slot you can trigger when the block count changes.  The default implementation will quickly calculate
-             * the number of required digits and trigger a geometry update, if needed.
+             * the number of required digits and trigger a geometry update, if needed.  When the editor is showing a
+             * virtualized large file, the digits are calculated from the number of lines in the file.
              *
              * \param[in] newBlockCount The new number of lines in the editor window.
              */
@@ -263,6 +265,11 @@ namespace EQt {
              */
             void updateWidth();
 
+            /**
+             * Method that prepares the cached digit glyphs and advances for the current line number font.
+             */
+            void updateDigitGlyphs();
+
             /**
              * The editor this class is operating with.
              */
@@ -302,6 +309,17 @@ namespace EQt {
              * Value holding the current font line height.
              */
             unsigned currentLineNumberHeight;
+
+            /**
+             * Prepared glyphs for the digits 0 through 9, in the current line number font.  Line numbers are painted
+             * one cached digit at a time so that painting does not lay out or allocate any text.
+             */
+            QStaticText currentDigitGlyphs[10];
+
+            /**
+             * The horizontal advance of each digit in the current line number font.
+             */
+            qreal currentDigitAdvances[10];
     };
 }
 
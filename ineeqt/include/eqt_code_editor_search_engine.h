@@ -0,0 +1,538 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::CodeEditorSearchEngine class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_CODE_EDITOR_SEARCH_ENGINE_H
+#define EQT_CODE_EDITOR_SEARCH_ENGINE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <QRegularExpression>
+#include <QTextCharFormat>
+
+#include "eqt_common.h"
+
+class QTimer;
+class QThreadPool;
+class QTextDocument;
+
+namespace EQt {
+    class CodeEditor;
+    class SearchLineEdit;
+
+    /**
+     * Class that finds every match of a search string in a \ref EQt::CodeEditor on a worker thread.
+     *
+     * The engine keeps a snapshot of the block texts and the matches found in each block.  Blocks are scanned on a
+     * worker thread, visible blocks first, and the matches are sent back to the GUI thread in batches.  After an
+     * edit, only the edited blocks are scanned again.  Only matches in the visible blocks are highlighted, using the
+     * editor's extra selections, so the cost of highlighting does not depend on the number of matches.  The engine
+     * replaces the editor's extra selections while a search string is set.
+     *
+     * The engine can be driven by a \ref EQt::SearchLineEdit, in which case the search string follows the line
+     * editor's text and the search options follow the line editor's case sensitive, whole words only, and regular
+     * expression actions.
+     */
+    class EQT_PUBLIC_API CodeEditorSearchEngine:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * The number of blocks delivered to the GUI thread in each batch.
+             */
+            static const unsigned blocksPerBatch;
+
+            /**
+             * Constructor.  The engine is a child of the editor.
+             *
+             * \param[in] editor         The editor to be searched.
+             *
+             * \param[in] searchLineEdit An optional search line editor used to drive the engine.
+             */
+            CodeEditorSearchEngine(CodeEditor* editor, SearchLineEdit* searchLineEdit = Q_NULLPTR);
+
+            ~CodeEditorSearchEngine() override;
+
+            /**
+             * Method you can use to obtain the editor.
+             *
+             * \return Returns the editor being searched.
+             */
+            CodeEditor* editor() const;
+
+            /**
+             * Method you can use to attach a search line editor to this engine.  The current text and options of the
+             * line editor are adopted immediately.
+             *
+             * \param[in] newSearchLineEdit The new search line editor.  A null pointer detaches the current line
+             *                              editor.
+             */
+            void setSearchLineEdit(SearchLineEdit* newSearchLineEdit);
+
+            /**
+             * Method you can use to obtain the search line editor driving this engine.
+             *
+             * \return Returns the search line editor.  A null pointer is returned if no line editor is attached.
+             */
+            SearchLineEdit* searchLineEdit() const;
+
+            /**
+             * Method you can use to obtain the current search string.
+             *
+             * \return Returns the current search string.
+             */
+            QString searchText() const;
+
+            /**
+             * Method you can use to determine if searches are case sensitive.
+             *
+             * \return Returns true if searches are case sensitive.
+             */
+            bool caseSensitiveSearchEnabled() const;
+
+            /**
+             * Method you can use to determine if only whole words are matched.
+             *
+             * \return Returns true if only whole words are matched.
+             */
+            bool wholeWordsOnlyEnabled() const;
+
+            /**
+             * Method you can use to determine if the search string is treated as a regular expression.
+             *
+             * \return Returns true if the search string is a regular expression.
+             */
+            bool regularExpressionSearchEnabled() const;
+
+            /**
+             * Method you can use to determine if the current search string is valid.
+             *
+             * \return Returns true if the search string is valid.  Returns false if the search string is an invalid
+             *         regular expression.
+             */
+            bool searchIsValid() const;
+
+            /**
+             * Method you can use to set the format used to highlight matches.
+             *
+             * \param[in] newFormat The new match format.
+             */
+            void setMatchFormat(const QTextCharFormat& newFormat);
+
+            /**
+             * Method you can use to obtain the format used to highlight matches.
+             *
+             * \return Returns the match format.
+             */
+            QTextCharFormat matchFormat() const;
+
+            /**
+             * Method you can use to set the format used to highlight the current match.
+             *
+             * \param[in] newFormat The new current match format.
+             */
+            void setCurrentMatchFormat(const QTextCharFormat& newFormat);
+
+            /**
+             * Method you can use to obtain the format used to highlight the current match.
+             *
+             * \return Returns the current match format.
+             */
+            QTextCharFormat currentMatchFormat() const;
+
+            /**
+             * Method you can use to set the thread pool used to scan the document.
+             *
+             * \param[in] newThreadPool The new thread pool.  A null pointer will cause the global thread pool to be
+             *                          used.
+             */
+            void setThreadPool(QThreadPool* newThreadPool);
+
+            /**
+             * Method you can use to obtain the thread pool used to scan the document.
+             *
+             * \return Returns the thread pool used to scan the document.
+             */
+            QThreadPool* threadPool() const;
+
+            /**
+             * Method you can use to determine the number of matches found so far.
+             *
+             * \return Returns the number of matches.
+             */
+            unsigned long numberMatches() const;
+
+            /**
+             * Method you can use to determine the index of the current match.
+             *
+             * \return Returns the zero based index of the current match.  A value of -1 is returned if there is no
+             *         current match.
+             */
+            long currentMatchIndex() const;
+
+            /**
+             * Method you can use to determine if the match list is up to date.
+             *
+             * \return Returns true if every block has been searched.  Returns false if a scan is underway or pending.
+             */
+            bool isIdle() const;
+
+        signals:
+            /**
+             * Signal that is emitted when the number of matches changes.
+             *
+             * \param[in] newNumberMatches The new number of matches.
+             */
+            void numberMatchesChanged(unsigned long newNumberMatches);
+
+            /**
+             * Signal that is emitted when a different match becomes the current match.
+             *
+             * \param[in] newIndex The zero based index of the new current match, or -1 if there is no current match.
+             */
+            void currentMatchChanged(long newIndex);
+
+            /**
+             * Signal that is emitted when every block has been searched.
+             */
+            void searchFinished();
+
+        public slots:
+            /**
+             * Slot you can use to set the search string.
+             *
+             * \param[in] newSearchText The new search string.
+             */
+            void setSearchText(const QString& newSearchText);
+
+            /**
+             * Slot you can use to enable or disable case sensitive searches.
+             *
+             * \param[in] nowEnabled If true, searches will be case sensitive.
+             */
+            void setCaseSensitiveSearchEnabled(bool nowEnabled = true);
+
+            /**
+             * Slot you can use to disable or enable case sensitive searches.
+             *
+             * \param[in] nowDisabled If true, searches will be case insensitive.
+             */
+            void setCaseSensitiveSearchDisabled(bool nowDisabled = true);
+
+            /**
+             * Slot you can use to enable or disable whole word matching.
+             *
+             * \param[in] nowEnabled If true, only whole words will be matched.
+             */
+            void setWholeWordsOnlyEnabled(bool nowEnabled = true);
+
+            /**
+             * Slot you can use to disable or enable whole word matching.
+             *
+             * \param[in] nowDisabled If true, matches may start or end within words.
+             */
+            void setWholeWordsOnlyDisabled(bool nowDisabled = true);
+
+            /**
+             * Slot you can use to enable or disable regular expression searches.
+             *
+             * \param[in] nowEnabled If true, the search string will be treated as a regular expression.
+             */
+            void setRegularExpressionSearchEnabled(bool nowEnabled = true);
+
+            /**
+             * Slot you can use to disable or enable regular expression searches.
+             *
+             * \param[in] nowDisabled If true, the search string will be treated as literal text.
+             */
+            void setRegularExpressionSearchDisabled(bool nowDisabled = true);
+
+            /**
+             * Slot you can use to select the first match following the editor's cursor.  The search wraps to the
+             * start of the document.
+             */
+            void findNext();
+
+            /**
+             * Slot you can use to select the last match preceding the editor's cursor.  The search wraps to the end of
+             * the document.
+             */
+            void findPrevious();
+
+            /**
+             * Slot you can use to search the entire document again.
+             */
+            void research();
+
+        private slots:
+            /**
+             * Slot that is triggered when the document contents change.
+             *
+             * \param[in] position     The position of the change.
+             *
+             * \param[in] charsRemoved The number of characters removed.
+             *
+             * \param[in] charsAdded   The number of characters added.
+             */
+            void contentsChange(int position, int charsRemoved, int charsAdded);
+
+            /**
+             * Slot that is triggered to start a scan of the dirty blocks.
+             */
+            void startScan();
+
+            /**
+             * Slot that is triggered by the worker thread when batches are waiting to be applied.
+             */
+            void batchesReady();
+
+            /**
+             * Slot that is triggered to update the highlighted matches in the visible blocks.
+             */
+            void updateVisibleSelections();
+
+            /**
+             * Slot that is triggered when an action on the search line editor is toggled.
+             */
+            void searchOptionsChanged();
+
+        private:
+            /**
+             * Class that holds the location of a match within a block.
+             */
+            class Match {
+                public:
+                    /**
+                     * Constructor
+                     *
+                     * \param[in] matchStart  The offset of the match from the start of the block.
+                     *
+                     * \param[in] matchLength The length of the match.
+                     */
+                    Match(int matchStart = 0, int matchLength = 0) {
+                        start  = matchStart;
+                        length = matchLength;
+                    }
+
+                    /**
+                     * The offset of the match from the start of the block.
+                     */
+                    int start;
+
+                    /**
+                     * The length of the match.
+                     */
+                    int length;
+            };
+
+            class Batch;
+            class Context;
+            class Scanner;
+
+            /**
+             * Method that builds the search expression from the search string and options.
+             */
+            void updateSearchExpression();
+
+            /**
+             * Method that cancels any scan underway, folding its unscanned blocks back into the dirty range.
+             */
+            void cancelScan();
+
+            /**
+             * Method that adds a range of blocks to the dirty range.
+             *
+             * \param[in] firstBlock The first dirty block.
+             *
+             * \param[in] lastBlock  The last dirty block.
+             */
+            void markDirty(int firstBlock, int lastBlock);
+
+            /**
+             * Method that applies a batch of matches.
+             *
+             * \param[in] batch The batch to apply.
+             */
+            void applyBatch(const Batch& batch);
+
+            /**
+             * Method that selects a match in the editor and makes it the current match.
+             *
+             * \param[in] block The zero based block holding the match.
+             *
+             * \param[in] index The index of the match within the block.
+             */
+            void selectMatch(int block, int index);
+
+            /**
+             * Method that forgets the current match.
+             */
+            void clearCurrentMatch();
+
+            /**
+             * Method that removes the highlighted matches from the editor.
+             */
+            void clearVisibleSelections();
+
+            /**
+             * Method that counts the matches in the blocks preceding a block.  The count starts from whichever of the
+             * start of the document, the end of the document, or the current match is nearest the block.
+             *
+             * \param[in] block The zero based block.
+             *
+             * \return Returns the number of matches preceding the block.
+             */
+            unsigned long countMatchesBefore(int block) const;
+
+            /**
+             * The editor being searched.
+             */
+            QPointer<CodeEditor> currentEditor;
+
+            /**
+             * The document being searched.
+             */
+            QPointer<QTextDocument> currentDocument;
+
+            /**
+             * The search line editor driving this engine.
+             */
+            QPointer<SearchLineEdit> currentSearchLineEdit;
+
+            /**
+             * The current search string.
+             */
+            QString currentSearchText;
+
+            /**
+             * Flag indicating that searches are case sensitive.
+             */
+            bool currentCaseSensitive;
+
+            /**
+             * Flag indicating that only whole words are matched.
+             */
+            bool currentWholeWordsOnly;
+
+            /**
+             * Flag indicating that the search string is a regular expression.
+             */
+            bool currentRegularExpression;
+
+            /**
+             * The compiled search expression.
+             */
+            QRegularExpression currentExpression;
+
+            /**
+             * The format used to highlight matches.
+             */
+            QTextCharFormat currentMatchHighlightFormat;
+
+            /**
+             * The format used to highlight the current match.
+             */
+            QTextCharFormat currentMatchSelectedFormat;
+
+            /**
+             * The current thread pool.
+             */
+            QThreadPool* currentThreadPool;
+
+            /**
+             * Timer used to coalesce edits and option changes before a scan starts.
+             */
+            QTimer* scanTimer;
+
+            /**
+             * Timer used to coalesce updates to the highlighted matches.
+             */
+            QTimer* selectionTimer;
+
+            /**
+             * Snapshot of the block texts.
+             */
+            QVector<QString> blockTexts;
+
+            /**
+             * The matches found in each block.
+             */
+            QVector<QVector<Match>> blockMatches;
+
+            /**
+             * The total number of matches held in blockMatches.
+             */
+            unsigned long currentNumberMatches;
+
+            /**
+             * The first block needing a scan, or -1 if no blocks are dirty.
+             */
+            int firstDirtyBlock;
+
+            /**
+             * The last block needing a scan.
+             */
+            int lastDirtyBlock;
+
+            /**
+             * Context shared with the worker thread for the scan underway.
+             */
+            QSharedPointer<Context> currentContext;
+
+            /**
+             * The next block the scan underway will deliver in order.  Visible blocks delivered ahead of the in-order
+             * pass are searched again if the scan is canceled before the in-order pass moves past them.
+             */
+            int scanNextBlock;
+
+            /**
+             * The last block of the scan underway.
+             */
+            int scanLastBlock;
+
+            /**
+             * The block holding the current match, or -1 if there is no current match.
+             */
+            int currentMatchBlock;
+
+            /**
+             * The index of the current match within its block.
+             */
+            int currentMatchBlockIndex;
+
+            /**
+             * The number of matches in the blocks preceding the block holding the current match.
+             */
+            unsigned long currentMatchesBefore;
+    };
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::CppLexer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_CPP_LEXER_H
+#define EQT_CPP_LEXER_H
+
+#include <QString>
+#include <QVector>
+
+#include "eqt_common.h"
+
+namespace EQt {
+    /**
+     * Class that scans a single block of C++ source in one pass and reports the ranges to be highlighted.  The lexer
+     * holds no state and can safely be used from any thread.
+     *
+     * Spans are reported in the order they should be applied.  A later span replaces the format of any earlier span
+     * it overlaps.  The results match the regular expression rules formerly used by \ref EQt::CppSyntaxHighlighter,
+     * including their quirks, such as keywords being highlighted inside strings.
+     */
+    class EQT_PUBLIC_API CppLexer {
+        public:
+            /**
+             * Enumeration of token types.
+             */
+            enum class TokenType : unsigned char {
+                /**
+                 * Indicates a C++ keyword.
+                 */
+                KEYWORD = 0,
+
+                /**
+                 * Indicates a single line comment.
+                 */
+                SINGLE_LINE_COMMENT = 1,
+
+                /**
+                 * Indicates a quoted string.
+                 */
+                QUOTATION = 2,
+
+                /**
+                 * Indicates a function name.
+                 */
+                FUNCTION = 3,
+
+                /**
+                 * Indicates a multi-line comment.
+                 */
+                MULTI_LINE_COMMENT = 4
+            };
+
+            /**
+             * The block state used for blocks that do not end inside a multi-line comment.
+             */
+            static const int normalState;
+
+            /**
+             * The block state used for blocks that end inside a multi-line comment.
+             */
+            static const int multiLineCommentState;
+
+            /**
+             * Class that describes a highlighted range within a block.
+             */
+            class EQT_PUBLIC_API Span {
+                public:
+                    Span();
+
+                    /**
+                     * Constructor
+                     *
+                     * \param[in] start     The zero based index of the first character.
+                     *
+                     * \param[in] length    The number of characters.
+                     *
+                     * \param[in] tokenType The type of token.
+                     */
+                    Span(int start, int length, TokenType tokenType);
+
+                    ~Span();
+
+                    /**
+                     * Method you can use to obtain the index of the first character.
+                     *
+                     * \return Returns the zero based index of the first character.
+                     */
+                    inline int start() const {
+                        return currentStart;
+                    }
+
+                    /**
+                     * Method you can use to obtain the number of characters.
+                     *
+                     * \return Returns the number of characters.
+                     */
+                    inline int length() const {
+                        return currentLength;
+                    }
+
+                    /**
+                     * Method you can use to obtain the token type.
+                     *
+                     * \return Returns the token type.
+                     */
+                    inline TokenType tokenType() const {
+                        return currentTokenType;
+                    }
+
+                    /**
+                     * Comparison operator.
+                     *
+                     * \param[in] other The instance to compare against.
+                     *
+                     * \return Returns true if the spans are identical.
+                     */
+                    bool operator==(const Span& other) const;
+
+                    /**
+                     * Comparison operator.
+                     *
+                     * \param[in] other The instance to compare against.
+                     *
+                     * \return Returns true if the spans differ.
+                     */
+                    bool operator!=(const Span& other) const;
+
+                private:
+                    int       currentStart;
+                    int       currentLength;
+                    TokenType currentTokenType;
+            };
+
+            /**
+             * Type used to hold a list of spans.
+             */
+            typedef QVector<Span> Spans;
+
+            /**
+             * Method that scans a block.
+             *
+             * \param[in]  text               The text of the block.
+             *
+             * \param[in]  previousBlockState The state at the end of the previous block.  Values other than
+             *                                \ref EQt::CppLexer::multiLineCommentState are treated as
+             *                                \ref EQt::CppLexer::normalState.
+             *
+             * \param[out] spans              The spans to be highlighted, in the order they should be applied.  Any
+             *                                existing contents are replaced.
+             *
+             * \return Returns the state at the end of this block.
+             */
+            static int lex(const QString& text, int previousBlockState, Spans& spans);
+
+            /**
+             * Method you can use to determine if a word is a highlighted keyword.
+             *
+             * \param[in] word The word to check.
+             *
+             * \return Returns true if the word is a keyword.
+             */
+            static bool isKeyword(const QString& word);
+    };
+}
+
+#endif
@@ -32,10 +32,9 @@
 
 #include <QWidget>
 #include <QString>
-#include <QSyntaxHighlighter>
-#include <QVector>
 
 #include "eqt_common.h"
+#include "eqt_syntax_highlighter.h"
 
 class QTextDocument;
 
@@ -44,9 +43,10 @@ namespace EQt {
      * Class you can use in conjuction with a QPlainTextEdit instance or \ref EQt::CodeEditor instance to provide
      * syntax highlighting of C++ code.
      *
-     * This code was heavily inspired by The Qt 5 syntax highlighter example.
+     * This code was heavily inspired by The Qt 5 syntax highlighter example.  Highlighting uses the shared rule set
+     * returned by \ref EQt::SyntaxRuleSet::cppRuleSet.
      */
-    class EQT_PUBLIC_API CppSyntaxHighlighter:public QSyntaxHighlighter {
+    class EQT_PUBLIC_API CppSyntaxHighlighter:public SyntaxHighlighter {
         Q_OBJECT
 
         public:
@@ -58,15 +58,6 @@ namespace EQt {
             CppSyntaxHighlighter(QTextDocument* parent = Q_NULLPTR);
 
             ~CppSyntaxHighlighter() override;
-
-        protected:
-            /**
-             * Method that is called to highlight a given block of text.  See the Qt 5 QSyntaxHighlighter documentation
-             * for details.
-             *
-             * \param[in] text The text to be highlighed.
-             */
-            void highlightBlock(const QString &text) override;
     };
 }
 
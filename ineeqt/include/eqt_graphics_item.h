@@ -43,6 +43,7 @@ class QTimer;
 
 namespace EQt {
     class Application;
+    class GraphicsScene;
 
     /**
      * Base class for EQt::GraphicsItem* classes.  This class provides a few additional capabilties to be shared across
@@ -50,6 +51,7 @@ namespace EQt {
      */
     class EQT_PUBLIC_API GraphicsItem {
         friend class Application;
+        friend class GraphicsScene;
 
         public:
             /**
@@ -69,20 +71,25 @@ namespace EQt {
             virtual void removeFromScene() = 0;
 
             /**
-             * Method you can use to defer updates.  The default implementation does nothing.
+             * Method you can use to defer updates.  While updates are deferred, repaint requests are collected.  The
+             * scene is notified of the first geometry change immediately and again once updates are restored so the
+             * scene index always holds the final geometry.  Calls may be nested.
+             *
+             * Updates are also deferred automatically while the item's \ref EQt::GraphicsScene has an update
+             * transaction open.
              */
             virtual void deferUpdates();
 
             /**
-             * Method you can use to restore updates.  The default implementation does nothing.
+             * Method you can use to restore updates.  Collected updates are applied once the outermost call to
+             * \ref EQt::GraphicsItem::deferUpdates is matched.
              */
             virtual void restoreUpdates();
 
             /**
              * Method you can use to determine if updates are deferred.
              *
-             * \return Returns true if updates are currently deferred.  Returns false if updates are not deferred.  The
-             *         default implementation returns false.
+             * \return Returns true if updates are currently deferred.  Returns false if updates are not deferred.
              */
             virtual bool updatesAreDeferred() const;
 
@@ -111,7 +118,59 @@ namespace EQt {
              */
             static void removeGraphicsItemFromScene(QGraphicsItem* graphicsItem);
 
+            /**
+             * Method derived classes should call immediately before changing their bounding rectangle.  The method
+             * determines if the scene needs to be told of the change.  Derived classes that call this method must
+             * also overload \ref EQt::GraphicsItem::notifyDeferredGeometryChange.
+             *
+             * \return Returns true if the derived class should call QGraphicsItem::prepareGeometryChange.  Returns
+             *         false if the scene has already been notified of a geometry change while updates are deferred.
+             */
+            bool reportGeometryChange();
+
+            /**
+             * Method that is called when updates are restored after geometry changes were collected.  The scene may
+             * have re-indexed the item between collected changes, so derived classes that call
+             * \ref EQt::GraphicsItem::reportGeometryChange should overload this method to call
+             * QGraphicsItem::prepareGeometryChange.  The default implementation does nothing.
+             */
+            virtual void notifyDeferredGeometryChange();
+
+            /**
+             * Method derived classes should call to request a repaint.  The repaint is collected if updates are
+             * deferred.
+             */
+            void requestUpdate();
+
+            /**
+             * Method derived classes can call to determine if changes should be collected rather than applied.  This
+             * method will join any open update transaction on the item's scene.
+             *
+             * \return Returns true if updates are being deferred.  Returns false if updates should be applied
+             *         immediately.
+             */
+            bool deferringUpdates();
+
+            /**
+             * Method that is called to apply collected updates once updates are restored.  The default implementation
+             * requests a repaint of the item.  Derived classes that collect other state should overload this method
+             * and call the base class implementation.
+             */
+            virtual void applyDeferredUpdates();
+
         private:
+            /**
+             * Method that obtains the QGraphicsItem this class is mixed into.  The cast is performed once and cached.
+             *
+             * \return Returns the QGraphicsItem for this item.
+             */
+            QGraphicsItem* graphicsItem();
+
+            /**
+             * Method that places this item under the control of its scene's open update transaction, if any.
+             */
+            void joinSceneTransaction();
+
             /**
              * Method that is triggered when the cleanup timer fires.
              */
@@ -126,6 +185,31 @@ namespace EQt {
              * Timer used to queue up clean-up operations.
              */
             static QTimer* cleanupTimer;
+
+            /**
+             * The number of outstanding calls to \ref EQt::GraphicsItem::deferUpdates.
+             */
+            unsigned currentDeferralDepth;
+
+            /**
+             * Flag indicating that the scene was notified of a geometry change while updates were deferred.
+             */
+            bool currentGeometryChangeIsPending;
+
+            /**
+             * Flag indicating that a repaint was requested while updates were deferred.
+             */
+            bool currentUpdateIsPending;
+
+            /**
+             * The scene whose update transaction is currently deferring updates to this item.
+             */
+            GraphicsScene* currentTransactionScene;
+
+            /**
+             * The QGraphicsItem this class is mixed into.  Null until first needed.
+             */
+            QGraphicsItem* currentGraphicsItem;
     };
 }
 
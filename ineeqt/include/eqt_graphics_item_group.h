@@ -133,6 +133,12 @@ namespace EQt {
              */
             bool isGroup() const final;
 
+            /**
+             * Method that is called when updates are restored after geometry changes were collected.  This version
+             * notifies the scene so the scene index holds the final geometry.
+             */
+            void notifyDeferredGeometryChange() override;
+
         private:
             /**
              * The current forced geometry.
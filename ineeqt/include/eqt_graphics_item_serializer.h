@@ -0,0 +1,129 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::GraphicsItemSerializer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_GRAPHICS_ITEM_SERIALIZER_H
+#define EQT_GRAPHICS_ITEM_SERIALIZER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+
+#include "eqt_common.h"
+
+namespace EQt {
+    class GraphicsItemGroup;
+
+    /**
+     * Class that converts trees of EQt graphics item groups to and from a compact, versioned, binary format.  The
+     * format is intended for copy and paste, undo snapshots, and drag and drop between processes.
+     *
+     * The following item types are supported: \ref EQt::GraphicsItemGroup, \ref EQt::GraphicsMultiTextGroup,
+     * \ref EQt::GraphicsMathGroup, \ref EQt::GraphicsMathGroupWithLine, and
+     * \ref EQt::GraphicsMathGroupWithPainterPath.  Fonts are written once per stream, in a table, and referenced by
+     * index from each text entry.  Pens and brushes are limited to solid colors; gradient and texture brushes are
+     * written as solid brushes using the brush color.
+     *
+     * All values are written in little endian byte order.  Reading works directly from the supplied buffer so data
+     * can be read from a memory mapped file without first being copied.
+     */
+    class EQT_PUBLIC_API GraphicsItemSerializer {
+        public:
+            /**
+             * The current format version.  Streams with a newer version are rejected.
+             */
+            static const unsigned formatVersion;
+
+            /**
+             * The maximum depth of an item tree.  A root item has a depth of one.  Deeper trees are not serialized
+             * and streams holding deeper trees are rejected.
+             */
+            static const unsigned maximumNestingDepth;
+
+            /**
+             * The MIME type you should use when placing serialized items on the clipboard or in drag and drop
+             * operations.
+             */
+            static const QString mimeType;
+
+            /**
+             * Method you can use to serialize a single tree of items.
+             *
+             * \param[in] item The root of the tree to be serialized.
+             *
+             * \return Returns the serialized data.  An empty byte array is returned if the tree contains an item
+             *         type that is not supported or is nested more deeply than
+             *         \ref EQt::GraphicsItemSerializer::maximumNestingDepth.
+             */
+            static QByteArray serialize(const GraphicsItemGroup* item);
+
+            /**
+             * Method you can use to serialize a collection of item trees.
+             *
+             * \param[in] items The roots of the trees to be serialized.
+             *
+             * \return Returns the serialized data.  An empty byte array is returned if any tree contains an item type
+             *         that is not supported or is nested more deeply than
+             *         \ref EQt::GraphicsItemSerializer::maximumNestingDepth.
+             */
+            static QByteArray serialize(const QList<const GraphicsItemGroup*>& items);
+
+            /**
+             * Method you can use to rebuild item trees from serialized data.  Each item is fully populated before it
+             * is attached to its parent so each tree is built with a single geometry change per item.  The caller
+             * takes ownership of the returned items.
+             *
+             * \param[in] data The serialized data.
+             *
+             * \return Returns the roots of the rebuilt trees.  An empty list is returned if the data is malformed,
+             *         holds an out of range enumerated value, is nested too deeply, or was written by a newer version
+             *         of this class.
+             */
+            static QList<GraphicsItemGroup*> deserialize(const QByteArray& data);
+
+            /**
+             * Method you can use to rebuild item trees from a raw buffer, such as a memory mapped file.  The buffer
+             * is read in place.  The caller takes ownership of the returned items.
+             *
+             * \param[in] data       Pointer to the serialized data.
+             *
+             * \param[in] dataLength The length of the serialized data, in bytes.
+             *
+             * \return Returns the roots of the rebuilt trees.  An empty list is returned if the data is malformed,
+             *         holds an out of range enumerated value, is nested too deeply, or was written by a newer version
+             *         of this class.
+             */
+            static QList<GraphicsItemGroup*> deserialize(const uchar* data, qint64 dataLength);
+
+        private:
+            class Writer;
+            class Reader;
+    };
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <QBrush>
 #include <QPen>
 #include <QRectF>
+#include <QPainterPath>
 
 #include "eqt_common.h"
 #include <eqt_graphics_multi_text_group.h>
@@ -54,6 +55,11 @@ namespace EQt {
              */
             enum { Type = QGraphicsItem::UserType + 6 };
 
+            /**
+             * The default maximum number of normalized parenthesis paths held in the shared parenthesis cache.
+             */
+            static const unsigned defaultParenthesisCacheSize;
+
             /**
              * Enumeration of different parenthesis styles.
              */
@@ -110,6 +116,41 @@ namespace EQt {
              */
             int type() const override;
 
+            /**
+             * Method you can use to set the maximum number of normalized parenthesis paths held in the cache shared
+             * by all math groups.
+             *
+             * \param[in] newCacheSize The new maximum number of cached paths.
+             */
+            static void setParenthesisCacheSize(unsigned newCacheSize);
+
+            /**
+             * Method you can use to obtain the maximum number of normalized parenthesis paths held in the cache
+             * shared by all math groups.
+             *
+             * \return Returns the maximum number of cached paths.
+             */
+            static unsigned parenthesisCacheSize();
+
+            /**
+             * Method you can use to empty the shared parenthesis cache and reset the cache statistics.
+             */
+            static void clearParenthesisCache();
+
+            /**
+             * Method you can use to obtain the number of parenthesis drawn using a cached path.
+             *
+             * \return Returns the number of cache hits since the cache was last cleared.
+             */
+            static unsigned long long parenthesisCacheHits();
+
+            /**
+             * Method you can use to obtain the number of parenthesis paths that had to be built.
+             *
+             * \return Returns the number of cache misses since the cache was last cleared.
+             */
+            static unsigned long long parenthesisCacheMisses();
+
             /**
              * Method you can use to set the left parenthesis style.
              *
@@ -307,12 +348,11 @@ namespace EQt {
             /**
              * Method that is called to draw a normalized parenthesis of a given style.
              *
-             * \param[in] painter          Painter used to draw the parenthesis.  This method expects a transform to be
-             *                             applied applied to the painter to correct position, scale, and rotate the
-             *                             parenthesis.  The transformation should assume that the default orientation
-             *                             is a normalized left side parenthesis.
+             * \param[in] painter          Painter used to draw the parenthesis.
              *
-             * \param[in] transform        The transform used to scale and position the parenthesis.
+             * \param[in] transform        The transform used to scale and position the parenthesis.  The
+             *                             transformation should assume that the default orientation is a normalized
+             *                             left side parenthesis.
              *
              * \param[in] heightToWidth    The ratio of the long side to the short side of the parenthesis.
              *
@@ -329,95 +369,73 @@ namespace EQt {
             );
 
             /**
-             * Method that is called to draw a normalized curved parenthesis.
+             * Method that obtains the normalized path for a parenthesis from the shared parenthesis cache, building
+             * the path if needed.  The height to width ratio and center line are quantized before use.
              *
-             * \param[in] painter       Painter used to draw the parenthesis.  This method expects a transform to be
-             *                          applied to the painter to correct position, scale, and rotate the parenthesis.
-             *                          The transformation should assume that the default orientation is a normalized
-             *                          left side parenthesis.
+             * \param[in] parenthesisStyle The parenthesis style.  Absolute value parenthesis are not supported.
              *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * \param[in] heightToWidth    The ratio of the long side to the short side of the parenthesis.
              *
-             * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
+             * \param[in] centerLine       The normalized center-line position.  The value is only used for braces.
+             *
+             * \return Returns the normalized path.
              */
-            void drawNormalizedCurvedParenthesis(QPainter* painter, const QTransform& transform, float heightToWidth);
+            static QPainterPath normalizedParenthesisPath(
+                ParenthesisStyle parenthesisStyle,
+                float            heightToWidth,
+                float            centerLine
+            );
 
             /**
-             * Method that is called to draw a normalized bracket.
-             *
-             * \param[in] painter       Painter used to draw the bracket.  This method expects a transform to be
-             *                          applied to the painter to correct position, scale, and rotate the bracket.  The
-             *                          transformation should assume that the default orientation is a normalized left
-             *                          side bracket.
-             *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * Method that builds a normalized curved parenthesis.  The path represents a left side parenthesis
+             * within the unit square.
              *
              * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
+             *
+             * \return Returns the normalized path.
              */
-            void drawNormalizedBracket(QPainter* painter, const QTransform& transform, float heightToWidth);
+            static QPainterPath normalizedCurvedParenthesis(float heightToWidth);
 
             /**
-             * Method that is called to draw a normalized braces.
-             *
-             * \param[in] painter       Painter used to draw the brace.  This method expects a transform to be applied
-             *                          to the painter to correct position, scale, and rotate the brace.  The
-             *                          transformation should assume that the default orientation is a normalized left
-             *                          side brace.
-             *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * Method that builds a normalized bracket.  The path represents a left side bracket within the unit
+             * square.
              *
              * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
              *
-             * \param[in] centerLine    The normalized center-line position.
+             * \return Returns the normalized path.
              */
-            void drawNormalizedBrace(
-                QPainter*         painter,
-                const QTransform& transform,
-                float             heightToWidth,
-                float             centerLine
-            );
+            static QPainterPath normalizedBracket(float heightToWidth);
 
             /**
-             * Method that is called to draw a normalized floor symbol.
+             * Method that builds a normalized brace.  The path represents a left side brace within the unit square.
              *
-             * \param[in] painter       Painter used to draw the floor symbol.  This method expects a transform to be
-             *                          applied to the painter to correct position, scale, and rotate the floor symbol.
-             *                          the transformation should assume that the default orientation is a normalized
-             *                          left side floor symbol.
+             * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
              *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * \param[in] centerLine    The normalized center-line position.
              *
-             * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
+             * \return Returns the normalized path.
              */
-            void drawNormalizedFloor(QPainter* painter, const QTransform& transform, float heightToWidth);
+            static QPainterPath normalizedBrace(float heightToWidth, float centerLine);
 
             /**
-             * Method that is called to draw a normalized ceiling symbol.
-             *
-             * \param[in] painter       Painter used to draw the ceiling symbol.  This method expects a transform to be
-             *                          applied to the painter to correct position, scale, and rotate the ceiling
-             *                          symbol.  The transformation should assume that the default orientation is a
-             *                          normalized left side ceiling symbol.
-             *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * Method that builds a normalized floor symbol.  The path represents a left side floor symbol within the
+             * unit square.
              *
              * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
+             *
+             * \return Returns the normalized path.
              */
-            void drawNormalizedCeiling(QPainter* painter, const QTransform& transform, float heightToWidth);
+            static QPainterPath normalizedFloor(float heightToWidth);
 
             /**
-             * Method that is called to draw a normalized absolute value symbol.
-             *
-             * \param[in] painter       Painter used to draw the absolute value symbol.  This method expects a
-             *                          transform to be applied to the painter to correct position, scale, and rotate
-             *                          the absolute value symbol.  The transformation should assume that the default
-             *                          orientation is a normalized absolute value symbol.
-             *
-             * \param[in] transform     The transform used to scale and position the parenthesis.
+             * Method that builds a normalized ceiling symbol.  The path represents a left side ceiling symbol within
+             * the unit square.
              *
              * \param[in] heightToWidth The ratio of the long side to the short side of the parenthesis.
+             *
+             * \return Returns the normalized path.
              */
-            void drawNormalizedAbsoluteValue(QPainter* painter, const QTransform& transform, float heightToWidth);
+            static QPainterPath normalizedCeiling(float heightToWidth);
 
             /**
              * The current parenthesis pen
@@ -32,12 +32,13 @@
 
 #include <QGraphicsItemGroup>
 #include <QString>
-#include <QList>
+#include <QVector>
 #include <QBrush>
 #include <QPen>
 #include <QFont>
 #include <QPointF>
 #include <QRectF>
+#include <QStaticText>
 
 #include "eqt_common.h"
 #include <eqt_graphics_item_group.h>
@@ -45,6 +46,7 @@
 class QWidget;
 class QAction;
 class QFocusEvent;
+class QPaintDevice;
 
 namespace EQt {
     /**
@@ -58,6 +60,17 @@ namespace EQt {
              */
             enum { Type = QGraphicsItem::UserType + 7 };
 
+            /**
+             * The maximum number of entries held in the shared cache of pixel sizes used when painting to devices
+             * other than widgets.
+             */
+            static const unsigned fontFitCacheSize;
+
+            /**
+             * Value returned by \ref EQt::GraphicsMultiTextGroup::textEntryAt when no text entry lies under a point.
+             */
+            static const unsigned noTextEntry;
+
             /**
              * Class that is used to track a text entry.
              */
@@ -92,6 +105,19 @@ namespace EQt {
                      */
                     TextEntry(const QString& text, const QFont& font, double x, double y);
 
+                    /**
+                     * Constructor
+                     *
+                     * \param[in] text      The text.
+                     *
+                     * \param[in] fontIndex The shared index of the font to apply to the text.  See
+                     *                      \ref EQt::GraphicsMultiTextGroup::internFont.
+                     *
+                     * \param[in] position  The position where the text should be placed.  The position represents
+                     *                      the left edge of the baseline of the text.
+                     */
+                    TextEntry(QString&& text, unsigned fontIndex, const QPointF& position);
+
                     /**
                      * Copy constructor
                      *
@@ -99,6 +125,13 @@ namespace EQt {
                      */
                     TextEntry(const TextEntry& other);
 
+                    /**
+                     * Move constructor
+                     *
+                     * \param[in] other The instance to be moved.
+                     */
+                    TextEntry(TextEntry&& other);
+
                     ~TextEntry();
 
                     /**
@@ -129,6 +162,13 @@ namespace EQt {
                      */
                     const QFont& font() const;
 
+                    /**
+                     * Method you can use to obtain the shared index of the text font.
+                     *
+                     * \return Returns the shared font index.
+                     */
+                    unsigned fontIndex() const;
+
                     /**
                      * Method you can use to set the position for the text within this group.
                      *
@@ -154,6 +194,25 @@ namespace EQt {
                      */
                     const QPointF& position() const;
 
+                    /**
+                     * Method you can use to obtain the bounding rectangle of this text entry.  The value is derived
+                     * from the cached text layout and is only recalculated when the text or font changes.
+                     *
+                     * \return Returns the bounding rectangle of the text, in group coordinates.
+                     */
+                    QRectF boundingRect() const;
+
+                    /**
+                     * Method you can use to determine the cursor position closest to a horizontal position.  Character
+                     * edges are measured once and cached until the text or font changes.
+                     *
+                     * \param[in] x The horizontal position, in group coordinates.
+                     *
+                     * \return Returns the zero based cursor position nearest to the supplied position.  The value
+                     *         will be between zero and the length of the text, inclusive.
+                     */
+                    unsigned characterOffsetAt(double x) const;
+
                     /**
                      * Assignment operator
                      *
@@ -163,11 +222,43 @@ namespace EQt {
                      */
                     TextEntry& operator=(const TextEntry& other);
 
+                    /**
+                     * Move assignment operator
+                     *
+                     * \param[in] other The instance to be moved.
+                     *
+                     * \return A reference to this object.
+                     */
+                    TextEntry& operator=(TextEntry&& other);
+
                 private:
                     /**
                      * Method that is called to trigger updates.
+                     *
+                     * \param[in] oldBoundingRectangle The bounding rectangle of this entry before the change.
+                     */
+                    void triggerUpdates(const QRectF& oldBoundingRectangle);
+
+                    /**
+                     * Method that rebuilds the cached text layout if the text or font has changed.
+                     */
+                    void updateLayout() const;
+
+                    /**
+                     * Method that returns the cached, pre-shaped text.
+                     *
+                     * \return Returns the cached static text instance.
                      */
-                    void triggerUpdates();
+                    const QStaticText& staticText() const;
+
+                    /**
+                     * Method that returns the cached horizontal offset of each cursor position, relative to the start
+                     * of the text.
+                     *
+                     * \return Returns the cursor position offsets.  The vector will contain one more entry than the
+                     *         text length.
+                     */
+                    const QVector<double>& characterEdges() const;
 
                     /**
                      * The current text.
@@ -175,15 +266,45 @@ namespace EQt {
                     QString currentText;
 
                     /**
-                     * The current font.
+                     * The shared index of the current font.
                      */
-                    QFont currentFont;
+                    unsigned currentFontIndex;
 
                     /**
                      * The current position.
                      */
                     QPointF currentPosition;
 
+                    /**
+                     * Flag indicating if the cached layout reflects the current text and font.
+                     */
+                    mutable bool currentLayoutIsValid;
+
+                    /**
+                     * The cached, pre-shaped text.
+                     */
+                    mutable QStaticText currentStaticText;
+
+                    /**
+                     * The cached text width.
+                     */
+                    mutable double currentTextWidth;
+
+                    /**
+                     * The cached font ascent.
+                     */
+                    mutable double currentTextAscent;
+
+                    /**
+                     * The cached font height.
+                     */
+                    mutable double currentTextHeight;
+
+                    /**
+                     * The cached cursor position offsets.  Empty until first needed.
+                     */
+                    mutable QVector<double> currentCharacterEdges;
+
                     /**
                      * Pointer to the group.
                      */
@@ -191,36 +312,44 @@ namespace EQt {
             };
 
             /**
-             * Iterator.
+             * Type used to hold a contiguous collection of text entries.  Entries are stored by value, so adding or
+             * removing entries may move existing entries and invalidate references and iterators to them.
              */
-            typedef QList<TextEntry>::iterator Iterator;
+            typedef QVector<TextEntry> TextEntries;
 
             /**
-             * Constant iterator.
+             * Iterator.
              */
-            typedef QList<TextEntry>::const_iterator ConstIterator;
-
-            GraphicsMultiTextGroup();
-
-            ~GraphicsMultiTextGroup() override;
+            typedef TextEntries::iterator Iterator;
 
             /**
-             * Method you can use to defer updates.  The default implementation does nothing.
+             * Constant iterator.
              */
-            void deferUpdates() override;
+            typedef TextEntries::const_iterator ConstIterator;
 
             /**
-             * Method you can use to restore updates.  The default implementation does nothing.
+             * Method you can use to obtain the shared index for a font.  Fonts are held in a table shared by every
+             * group so that each text entry need only store a small index.  Fonts are never removed from the table.
+             * The table is guarded by a mutex so text entries may be constructed on any thread.
+             *
+             * \param[in] font The font to locate or add.
+             *
+             * \return Returns the shared index for the font.
              */
-            void restoreUpdates() override;
+            static unsigned internFont(const QFont& font);
 
             /**
-             * Method you can use to determine if updates are deferred.
+             * Method you can use to obtain a font from the shared font table.
+             *
+             * \param[in] fontIndex The shared index of the desired font.
              *
-             * \return Returns true if updates are currently deferred.  Returns false if updates are not deferred.  The
-             *         default implementation returns false.
+             * \return Returns a reference to the font.  The reference remains valid for the life of the application.
              */
-            bool updatesAreDeferred() const override;
+            static const QFont& internedFont(unsigned fontIndex);
+
+            GraphicsMultiTextGroup();
+
+            ~GraphicsMultiTextGroup() override;
 
             /**
              * Method that returns the type ID of this QGraphicsItem.
@@ -320,6 +449,14 @@ namespace EQt {
              */
             void append(const QString& newText, const QFont& newFont, const QPointF& newPosition);
 
+            /**
+             * Method you can use to append a batch of text entries.  The entries are moved into this group and the
+             * scene is notified of a single geometry change for the entire batch.
+             *
+             * \param[in,out] newEntries The new text entries.  The container will be empty on return.
+             */
+            void append(TextEntries&& newEntries);
+
             /**
              * Method you can use to prepend a new text entry.
              *
@@ -350,7 +487,9 @@ namespace EQt {
              *
              * \param[in] index The zero based index of the desired text entry.
              *
-             * \return Returns a reference to the text entry.
+             * \return Returns a reference to the text entry.  The reference is invalidated by any call that adds or
+             *         removes text entries, such as \ref EQt::GraphicsMultiTextGroup::append or
+             *         \ref EQt::GraphicsMultiTextGroup::prepend.
              */
             const TextEntry& entry(unsigned index) const;
 
@@ -359,7 +498,9 @@ namespace EQt {
              *
              * \param[in] index The zero based index of the desired text entry.
              *
-             * \return Returns a reference to the text entry.
+             * \return Returns a reference to the text entry.  The reference is invalidated by any call that adds or
+             *         removes text entries, such as \ref EQt::GraphicsMultiTextGroup::append or
+             *         \ref EQt::GraphicsMultiTextGroup::prepend.
              */
             TextEntry& entry(unsigned index);
 
@@ -368,7 +509,9 @@ namespace EQt {
              *
              * \param[in] index The zero based index of the desired text entry.
              *
-             * \return Returns a reference to the text entry.
+             * \return Returns a reference to the text entry.  The reference is invalidated by any call that adds or
+             *         removes text entries, such as \ref EQt::GraphicsMultiTextGroup::append or
+             *         \ref EQt::GraphicsMultiTextGroup::prepend.
              */
             const TextEntry& operator[](unsigned index) const;
 
@@ -377,7 +520,9 @@ namespace EQt {
              *
              * \param[in] index The zero based index of the desired text entry.
              *
-             * \return Returns a reference to the text entry.
+             * \return Returns a reference to the text entry.  The reference is invalidated by any call that adds or
+             *         removes text entries, such as \ref EQt::GraphicsMultiTextGroup::append or
+             *         \ref EQt::GraphicsMultiTextGroup::prepend.
              */
             TextEntry& operator[](unsigned index);
 
@@ -409,6 +554,33 @@ namespace EQt {
              */
             ConstIterator constEnd();
 
+            /**
+             * Method you can use to locate the text entry under a point.  Queries use a grid of buckets over the text
+             * bounding rectangle, each listing the entries that overlap it.  The grid is built when first needed after
+             * the text geometry changes.  Child items are not considered.
+             *
+             * \param[in] position The position to test, in item coordinates.
+             *
+             * \return Returns the zero based index of the text entry under the point.  If entries overlap, the entry
+             *         painted last is returned.  Returns \ref EQt::GraphicsMultiTextGroup::noTextEntry if no text
+             *         entry lies under the point.
+             */
+            unsigned textEntryAt(const QPointF& position) const;
+
+            /**
+             * Method you can use to locate the text entry and cursor position under a point.
+             *
+             * \param[in]  position        The position to test, in item coordinates.
+             *
+             * \param[out] entryIndex      The zero based index of the text entry under the point.
+             *
+             * \param[out] characterOffset The zero based cursor position within the entry closest to the point.
+             *
+             * \return Returns true if a text entry lies under the point.  Returns false if no text entry lies under
+             *         the point.  The output parameters are not modified if false is returned.
+             */
+            bool textPositionAt(const QPointF& position, unsigned& entryIndex, unsigned& characterOffset) const;
+
             /**
              * Method that returns this item's bounding rectangle.
              *
@@ -429,14 +601,89 @@ namespace EQt {
 
         private:
             /**
-             * Method that updates the geometry data.
+             * Method that determines the pixel size that best matches the on-screen width of a string when drawn on
+             * a device other than a widget, such as a printer or image.  Results are held in a cache shared by all
+             * groups, keyed by font, text, and device resolution.
+             *
+             * \param[in] font   The font used to draw the text on screen.
+             *
+             * \param[in] text   The text to be drawn.
+             *
+             * \param[in] device The device the text will be drawn on.
+             *
+             * \return Returns the pixel size to apply to the font on the device.
              */
-            void updateGeometryNeeded();
+            static int fittedPixelSize(const QFont& font, const QString& text, QPaintDevice* device);
 
             /**
-             * Flag that indicates if updates are currently deferred.
+             * Method that associates text entries with this group.  Entries lose their association when copied or
+             * moved so this method must be called whenever the entries may have been relocated.
+             *
+             * \param[in] startingIndex The zero based index of the first entry to be associated.
+             */
+            void attachEntries(unsigned startingIndex);
+
+            /**
+             * Method that notifies the scene that the text geometry is about to change.  While updates are deferred,
+             * only the first notification is forwarded immediately and the scene is notified again when updates are
+             * restored.  The hit-testing index is also invalidated.
+             */
+            void prepareTextGeometryChange();
+
+            /**
+             * Method that determines if a rectangle reaches the edge of the cached text bounding rectangle.
+             *
+             * \param[in] rectangle The rectangle to be checked.
+             *
+             * \return Returns true if the rectangle touches or crosses the edge of the text bounding rectangle.
+             */
+            bool touchesTextBoundary(const QRectF& rectangle) const;
+
+            /**
+             * Method that is called after a text entry is added.
+             *
+             * \param[in] newBoundingRectangle The bounding rectangle of the new entry.
+             */
+            void textEntryAdded(const QRectF& newBoundingRectangle);
+
+            /**
+             * Method that is called after a text entry is removed.
+             *
+             * \param[in] oldBoundingRectangle The bounding rectangle of the removed entry.
+             */
+            void textEntryRemoved(const QRectF& oldBoundingRectangle);
+
+            /**
+             * Method that is called after a text entry is modified.
+             *
+             * \param[in] oldBoundingRectangle The bounding rectangle of the entry before the change.
+             *
+             * \param[in] newBoundingRectangle The bounding rectangle of the entry after the change.
              */
-            bool currentUpdatesAreDeferred;
+            void textEntryChanged(const QRectF& oldBoundingRectangle, const QRectF& newBoundingRectangle);
+
+            /**
+             * Method that rebuilds the hit-testing index if the text geometry has changed.
+             */
+            void updateHitTestIndex() const;
+
+            /**
+             * Method that determines the hit-testing grid column holding an X coordinate.
+             *
+             * \param[in] x The X coordinate, in item coordinates.
+             *
+             * \return Returns the zero based grid column, clamped to the grid.
+             */
+            unsigned hitTestColumn(double x) const;
+
+            /**
+             * Method that determines the hit-testing grid row holding a Y coordinate.
+             *
+             * \param[in] y The Y coordinate, in item coordinates.
+             *
+             * \return Returns the zero based grid row, clamped to the grid.
+             */
+            unsigned hitTestRow(double y) const;
 
             /**
              * The current background brush
@@ -454,14 +701,62 @@ namespace EQt {
             QPen currentTextPen;
 
             /**
-             * The current size.
+             * The union of the text entry bounding rectangles.
              */
             mutable QRectF currentTextBoundingRectangle;
 
             /**
-             * List of text entries.
+             * Flag indicating if the text bounding rectangle is up to date.
+             */
+            mutable bool currentTextBoundingRectangleIsValid;
+
+            /**
+             * Flag indicating if the hit-testing index is up to date.
+             */
+            mutable bool currentHitTestIndexIsValid;
+
+            /**
+             * The rectangle covered by the hit-testing grid.
+             */
+            mutable QRectF currentHitTestBounds;
+
+            /**
+             * The number of columns in the hit-testing grid.
+             */
+            mutable unsigned currentHitTestColumns;
+
+            /**
+             * The number of rows in the hit-testing grid.
+             */
+            mutable unsigned currentHitTestRows;
+
+            /**
+             * The width of a hit-testing grid cell.
+             */
+            mutable double currentHitTestCellWidth;
+
+            /**
+             * The height of a hit-testing grid cell.
+             */
+            mutable double currentHitTestCellHeight;
+
+            /**
+             * The offset of each grid cell's first entry in
+             * \ref EQt::GraphicsMultiTextGroup::currentHitTestCellEntries, in row major order.  The last value holds
+             * the total number of cell entries.
+             */
+            mutable QVector<unsigned> currentHitTestCellStarts;
+
+            /**
+             * The indexes of the entries overlapping each grid cell.  The entries for each cell are in ascending
+             * order.
+             */
+            mutable QVector<unsigned> currentHitTestCellEntries;
+
+            /**
+             * Contiguous array of text entries.
              */
-            QList<TextEntry> currentTextEntries;
+            TextEntries currentTextEntries;
     };
 }
 
@@ -32,6 +32,11 @@
 
 #include <QGraphicsPixmapItem>
 #include <QPixmap>
+#include <QString>
+#include <QSize>
+#include <QRectF>
+#include <QPointF>
+#include <QPainterPath>
 
 #include "eqt_common.h"
 #include "eqt_graphics_item.h"
@@ -42,11 +47,22 @@ class QPainter;
 class QStyleOptionGraphicsItem;
 class QWidget;
 
+class GraphicsPixmapPyramid;
+
 namespace EQt {
     /**
-     * Trivlal class that extends QGraphicsPixmapItem to bring it into the EQt framework.
+     * Class that extends QGraphicsPixmapItem to bring it into the EQt framework.
+     *
+     * In addition to displaying a pixmap, the item can display an image file that is decoded on a worker thread.  In
+     * this mode a placeholder is drawn until decoding completes, and the item then draws from a pyramid of
+     * successively halved pixmaps, choosing the level closest to the current transform.  If the image can not be
+     * decoded, the placeholder is removed and the item collapses to an empty size.  Pyramids share a memory
+     * budget; images that have not been painted recently release their larger levels and are decoded again when
+     * needed.
      */
     class EQT_PUBLIC_API GraphicsPixmapItem:public QGraphicsPixmapItem, public GraphicsItem {
+        friend class ::GraphicsPixmapPyramid;
+
         public:
             /**
              * The QGraphicsItem type ID.
@@ -78,11 +94,123 @@ namespace EQt {
              */
             int type() const override;
 
+            /**
+             * Method you can use to display an image file, decoded asynchronously.  The image header is read
+             * immediately so the item has its final size before decoding completes.  While the image file is in use,
+             * the pixmap returned by QGraphicsPixmapItem::pixmap is not used.
+             *
+             * \param[in] filename The image file to be displayed.  An empty string returns the item to displaying
+             *                     its pixmap.
+             */
+            void setImageFile(const QString& filename);
+
+            /**
+             * Method you can use to obtain the image file being displayed.
+             *
+             * \return Returns the image file.  An empty string is returned if the item displays its pixmap.
+             */
+            QString imageFile() const;
+
+            /**
+             * Method you can use to determine if the image file is still being decoded.
+             *
+             * \return Returns true if the image file is being decoded.
+             */
+            bool imageIsLoading() const;
+
+            /**
+             * Method you can use to determine if the image file could not be decoded.  A failed image is not drawn
+             * and has an empty bounding rectangle.
+             *
+             * \return Returns true if decoding completed without producing an image.
+             */
+            bool imageLoadFailed() const;
+
+            /**
+             * Method you can use to determine the size of the decoded pixmap used to draw the image file at a given
+             * scale.  The smallest pixmap at least as wide as the drawn image is used.
+             *
+             * \param[in] scale The number of device pixels per image pixel.
+             *
+             * \return Returns the pixmap size, in pixels.  An empty size is returned if the image has not been
+             *         decoded or the item displays its pixmap.
+             */
+            QSize imageLevelSize(double scale) const;
+
+            /**
+             * Method you can use to set the memory budget shared by all asynchronously decoded images.
+             *
+             * \param[in] newMemoryBudget The new budget, in KiB.
+             */
+            static void setImageMemoryBudget(unsigned newMemoryBudget);
+
+            /**
+             * Method you can use to obtain the memory budget shared by all asynchronously decoded images.
+             *
+             * \return Returns the budget, in KiB.
+             */
+            static unsigned imageMemoryBudget();
+
+            /**
+             * Method that returns the bounding rectangle of this item.
+             *
+             * \return Returns the bounding rectangle, in item coordinates.
+             */
+            QRectF boundingRect() const override;
+
+            /**
+             * Method that returns the shape of this item.
+             *
+             * \return Returns the shape, in item coordinates.
+             */
+            QPainterPath shape() const override;
+
+            /**
+             * Method that determines if a point lies within this item.
+             *
+             * \param[in] point The point to test, in item coordinates.
+             *
+             * \return Returns true if the point lies within this item.
+             */
+            bool contains(const QPointF& point) const override;
+
+            /**
+             * Method that paints this item.
+             *
+             * \param[in] painter The painter to use to paint this item.
+             *
+             * \param[in] option  Style options for this item.
+             *
+             * \param[in] widget  The widget being painted on.
+             */
+            void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
             /**
              * Method you can call to remove this graphics item from the scene.  You should overload this method in
              * derived classes to remove the graphics item from the scene.
              */
             void removeFromScene() override;
+
+        protected:
+            /**
+             * Method that is called when updates are restored after geometry changes were collected.  This version
+             * notifies the scene so the scene index holds the final geometry.
+             */
+            void notifyDeferredGeometryChange() override;
+
+        private:
+            /**
+             * Method that is called by the pyramid when decoding completes, before the image size is updated.
+             *
+             * \param[in] sizeChanged If true, the decoded image size differs from the size reported by the image
+             *                        header.
+             */
+            void imageDecoded(bool sizeChanged);
+
+            /**
+             * The pyramid holding the decoded image.  A null pointer indicates the item displays its pixmap.
+             */
+            GraphicsPixmapPyramid* currentPyramid;
     };
 }
 
@@ -0,0 +1,164 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::GraphicsRasterCacheEffect class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_GRAPHICS_RASTER_CACHE_EFFECT_H
+#define EQT_GRAPHICS_RASTER_CACHE_EFFECT_H
+
+#include <QObject>
+#include <QGraphicsEffect>
+#include <QPixmap>
+#include <QPoint>
+#include <QTransform>
+
+#include "eqt_common.h"
+
+class QPainter;
+
+namespace EQt {
+    /**
+     * Graphics effect that draws an item, and all of its children, from a cached pixmap.  The pixmap is rendered at
+     * the device resolution and is reused while the view scrolls, provided the visible part of the item was rendered.
+     * The pixmap is held by the effect, rather than in the global QPixmapCache, so it is not evicted by unrelated
+     * pixmaps.  The pixmap is discarded whenever the item or one of its children requests an update or changes
+     * geometry, and is re-rendered when the item is drawn at a different scale.
+     *
+     * Painting to devices other than widgets, such as printers and PDF files, always bypasses the cache so vector
+     * output is preserved.  The cache can also be bypassed while the user is interacting with the item.
+     */
+    class EQT_PUBLIC_API GraphicsRasterCacheEffect:public QGraphicsEffect {
+        Q_OBJECT
+
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] parent Pointer to the parent object.
+             */
+            GraphicsRasterCacheEffect(QObject* parent = Q_NULLPTR);
+
+            ~GraphicsRasterCacheEffect() override;
+
+            /**
+             * Method you can use to indicate that an interaction has started.  The item is drawn directly until
+             * every call to this method has been matched by a call to
+             * \ref EQt::GraphicsRasterCacheEffect::endInteraction.
+             */
+            void beginInteraction();
+
+            /**
+             * Method you can use to indicate that an interaction has ended.
+             */
+            void endInteraction();
+
+            /**
+             * Method you can use to determine if an interaction is in progress.
+             *
+             * \return Returns true if an interaction is in progress.  Returns false if the cache is in use.
+             */
+            bool interactionInProgress() const;
+
+            /**
+             * Method you can use to obtain the number of times the item was drawn from the cached pixmap.
+             *
+             * \return Returns the number of cache hits.
+             */
+            unsigned long long cacheHits() const;
+
+            /**
+             * Method you can use to obtain the number of times the cached pixmap had to be rendered.
+             *
+             * \return Returns the number of cache misses.
+             */
+            unsigned long long cacheMisses() const;
+
+            /**
+             * Method you can use to reset the cache hit and miss counts.
+             */
+            void resetCacheStatistics();
+
+        protected:
+            /**
+             * Method that is called to draw the item.
+             *
+             * \param[in] painter The painter used to draw the item.
+             */
+            void draw(QPainter* painter) override;
+
+            /**
+             * Method that is called when the source item changes.  This version discards the cached pixmap.
+             *
+             * \param[in] flags Flags indicating what changed.
+             */
+            void sourceChanged(QGraphicsEffect::ChangeFlags flags) override;
+
+        private:
+            /**
+             * Method that determines if two transforms differ only by a translation.
+             *
+             * \param[in] first  The first transform.
+             *
+             * \param[in] second The second transform.
+             *
+             * \return Returns true if the transforms scale, rotate, shear and project identically.
+             */
+            static bool differOnlyByTranslation(const QTransform& first, const QTransform& second);
+
+            /**
+             * The number of unmatched calls to \ref EQt::GraphicsRasterCacheEffect::beginInteraction.
+             */
+            unsigned currentInteractionDepth;
+
+            /**
+             * The cached pixmap.  Null if no pixmap is cached.
+             */
+            QPixmap currentPixmap;
+
+            /**
+             * The device position of the cached pixmap when it was rendered.
+             */
+            QPoint currentPixmapOffset;
+
+            /**
+             * The device transform used to render the cached pixmap.
+             */
+            QTransform currentPixmapTransform;
+
+            /**
+             * The number of times the item was drawn from the cached pixmap.
+             */
+            unsigned long long currentCacheHits;
+
+            /**
+             * The number of times the cached pixmap was rendered.
+             */
+            unsigned long long currentCacheMisses;
+    };
+}
+
+#endif
@@ -32,6 +32,7 @@
 
 #include <QObject>
 #include <QRectF>
+#include <QSet>
 #include <QGraphicsScene>
 
 #include "eqt_common.h"
@@ -41,14 +42,48 @@ class QAction;
 class QFocusEvent;
 
 namespace EQt {
+    class GraphicsItem;
+
     /**
      * Class that extends QGraphicsScene to change the child ownership rules.  Normally the QGraphicsScene
      * owns the child objects.  This complicates code that requires ownership to be maintained by external objects.
+     *
+     * The class also supports update transactions.  While a transaction is open, every \ref EQt::GraphicsItem in the
+     * scene that is modified defers its updates.  Setters apply their state immediately so getters and bounding
+     * rectangles always report the new values; only the repaint and the scene index notification are deferred, and
+     * each item repaints once when the transaction is committed.  Items whose state is held by the Qt base class,
+     * such as \ref EQt::GraphicsRectItem and \ref EQt::GraphicsTextItem, rely on Qt's own coalesced updates.
      */
     class EQT_PUBLIC_API GraphicsScene:public QGraphicsScene {
         Q_OBJECT
 
+        friend class GraphicsItem;
+
         public:
+            /**
+             * Class you can use to open an update transaction for the lifetime of a scope.
+             */
+            class EQT_PUBLIC_API UpdateTransaction {
+                public:
+                    /**
+                     * Constructor
+                     *
+                     * \param[in] scene The scene to open the transaction on.
+                     */
+                    UpdateTransaction(GraphicsScene* scene);
+
+                    ~UpdateTransaction();
+
+                private:
+                    UpdateTransaction(const UpdateTransaction&) = delete;
+                    UpdateTransaction& operator=(const UpdateTransaction&) = delete;
+
+                    /**
+                     * The scene holding the transaction.
+                     */
+                    GraphicsScene* currentScene;
+            };
+
             /**
              * Constructor
              *
@@ -81,6 +116,55 @@ namespace EQt {
             GraphicsScene(double x, double y, double width, double height, QObject* parent = Q_NULLPTR);
 
             ~GraphicsScene();
+
+            /**
+             * Method you can use to open an update transaction.  Transactions can be nested.  Changes are applied
+             * when the outermost transaction is committed.
+             */
+            void beginUpdateTransaction();
+
+            /**
+             * Method you can use to commit an update transaction.
+             */
+            void commitUpdateTransaction();
+
+            /**
+             * Method you can use to determine if an update transaction is open.
+             *
+             * \return Returns true if an update transaction is open.  Returns false if no transaction is open.
+             */
+            bool updateTransactionIsOpen() const;
+
+        private:
+            /**
+             * Method that is called by an item when it joins the current transaction.
+             *
+             * \param[in] item The item that is deferring updates.
+             */
+            void addDeferredItem(GraphicsItem* item);
+
+            /**
+             * Method that is called by an item that is destroyed while deferring updates.
+             *
+             * \param[in] item The item being destroyed.
+             */
+            void removeDeferredItem(GraphicsItem* item);
+
+            /**
+             * The number of transactions open across all scenes.  Used to keep the common, non-transactional, path
+             * inexpensive.
+             */
+            static unsigned numberOpenTransactions;
+
+            /**
+             * The current transaction nesting depth.
+             */
+            unsigned currentTransactionDepth;
+
+            /**
+             * The items deferring updates under the current transaction.
+             */
+            QSet<GraphicsItem*> deferredItems;
     };
 }
 
@@ -0,0 +1,275 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::GraphicsScenePageRenderer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_GRAPHICS_SCENE_PAGE_RENDERER_H
+#define EQT_GRAPHICS_SCENE_PAGE_RENDERER_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QPointer>
+#include <QList>
+#include <QMap>
+#include <QRectF>
+#include <QImage>
+#include <QColor>
+
+#include "eqt_common.h"
+
+class QGraphicsScene;
+class QThreadPool;
+
+namespace EQt {
+    /**
+     * Class that renders a collection of pages from a QGraphicsScene into QImage instances using a pool of worker
+     * threads.
+     *
+     * Each page is first recorded from the scene into a QPicture on the thread that owns the scene.  Recording walks
+     * the scene, calling each item's paint method, but performs no rasterization.  Item painting must stay on the
+     * scene's thread because QGraphicsItem instances are not thread safe.  The recorded pictures are then rasterized
+     * on the worker threads, overlapping with the recording of later pages.  Completed pages are reported, strictly in
+     * page order, through the \ref EQt::GraphicsScenePageRenderer::pageRendered signal.
+     *
+     * Pages are recorded just ahead of the worker threads.  The number of pages recorded, being rasterized or waiting
+     * to be reported is bounded by \ref EQt::GraphicsScenePageRenderer::maximumPagesInFlight so memory use does not
+     * grow with the number of pages.
+     */
+    class EQT_PUBLIC_API GraphicsScenePageRenderer:public QObject {
+        Q_OBJECT
+
+        public:
+            /**
+             * Value used to indicate that the number of pages in flight should be determined from the number of
+             * threads supported by the thread pool.
+             */
+            static const unsigned automaticPagesInFlight;
+
+            /**
+             * Constructor
+             *
+             * \param[in] parent Pointer to the parent object.
+             */
+            GraphicsScenePageRenderer(QObject* parent = Q_NULLPTR);
+
+            ~GraphicsScenePageRenderer() override;
+
+            /**
+             * Method you can use to set the thread pool used to rasterize pages.
+             *
+             * \param[in] newThreadPool The new thread pool.  A null pointer will cause the global thread pool to be
+             *                          used.
+             */
+            void setThreadPool(QThreadPool* newThreadPool);
+
+            /**
+             * Method you can use to obtain the thread pool used to rasterize pages.
+             *
+             * \return Returns the thread pool used to rasterize pages.
+             */
+            QThreadPool* threadPool() const;
+
+            /**
+             * Method you can use to set the maximum number of pages that can be rasterized or held pending delivery at
+             * any one time.
+             *
+             * \param[in] newMaximumPagesInFlight The new maximum number of pages in flight.  The value
+             *                                    \ref EQt::GraphicsScenePageRenderer::automaticPagesInFlight will
+             *                                    select twice the maximum thread count of the thread pool.
+             */
+            void setMaximumPagesInFlight(unsigned newMaximumPagesInFlight);
+
+            /**
+             * Method you can use to obtain the maximum number of pages that can be rasterized or held pending delivery
+             * at any one time.
+             *
+             * \return Returns the maximum number of pages in flight.
+             */
+            unsigned maximumPagesInFlight() const;
+
+            /**
+             * Method you can use to set the scale factor used to convert scene units to image pixels.
+             *
+             * \param[in] newScaleFactor The new scale factor, in pixels per scene unit.
+             */
+            void setScaleFactor(double newScaleFactor);
+
+            /**
+             * Method you can use to obtain the scale factor used to convert scene units to image pixels.
+             *
+             * \return Returns the scale factor, in pixels per scene unit.
+             */
+            double scaleFactor() const;
+
+            /**
+             * Method you can use to set the color used to fill each image before the page is drawn.
+             *
+             * \param[in] newBackgroundColor The new background color.
+             */
+            void setBackgroundColor(const QColor& newBackgroundColor);
+
+            /**
+             * Method you can use to obtain the color used to fill each image before the page is drawn.
+             *
+             * \return Returns the background color.
+             */
+            const QColor& backgroundColor() const;
+
+            /**
+             * Method you can use to determine if pages are currently being rendered.
+             *
+             * \return Returns true if a render operation is underway.  Returns false if the renderer is idle.
+             */
+            bool isActive() const;
+
+        signals:
+            /**
+             * Signal that is emitted each time a page is ready.  Pages are always reported in page order.
+             *
+             * \param[in] pageIndex The zero based index of the page.
+             *
+             * \param[in] image     The rendered page.
+             */
+            void pageRendered(unsigned pageIndex, const QImage& image);
+
+            /**
+             * Signal that is emitted each time a page has been reported.
+             *
+             * \param[in] numberPagesCompleted The number of pages reported so far.
+             *
+             * \param[in] numberPages          The total number of pages being rendered.
+             */
+            void progress(unsigned numberPagesCompleted, unsigned numberPages);
+
+            /**
+             * Signal that is emitted when the render operation ends.
+             *
+             * \param[in] completed Holds true if every page was reported.  Holds false if the operation was
+             *                      canceled.
+             */
+            void finished(bool completed);
+
+        public slots:
+            /**
+             * Slot you can use to start rendering pages.  Pages are recorded from the scene as the render
+             * progresses so the scene should not be modified until the \ref EQt::GraphicsScenePageRenderer::finished
+             * signal is emitted.  The render is canceled if the scene is destroyed.
+             *
+             * \param[in] scene          The scene to be rendered.
+             *
+             * \param[in] pageRectangles The regions of the scene, in scene coordinates, to be rendered as pages.
+             *
+             * \return Returns true on success.  Returns false if a render operation is already underway.
+             */
+            bool render(QGraphicsScene* scene, const QList<QRectF>& pageRectangles);
+
+            /**
+             * Slot you can use to cancel the current render operation.  Pages that have not yet been reported will
+             * be discarded.
+             */
+            void cancel();
+
+        private slots:
+            /**
+             * Slot that is triggered by the worker threads when a page has been rasterized.
+             *
+             * \param[in] pageIndex The zero based index of the page.
+             *
+             * \param[in] image     The rasterized page.
+             */
+            void pageRasterized(unsigned pageIndex, const QImage& image);
+
+        private:
+            class Context;
+            class PageRasterizer;
+
+            /**
+             * Method that records pages and starts rasterizing them until the maximum number of pages in flight has
+             * been reached.
+             */
+            void startPages();
+
+            /**
+             * Method that ends the current render operation.
+             *
+             * \param[in] completed Flag indicating if the render operation ran to completion.
+             */
+            void endRender(bool completed);
+
+            /**
+             * Context shared with the worker threads.
+             */
+            QSharedPointer<Context> currentContext;
+
+            /**
+             * The current thread pool.
+             */
+            QThreadPool* currentThreadPool;
+
+            /**
+             * The current maximum number of pages in flight.
+             */
+            unsigned currentMaximumPagesInFlight;
+
+            /**
+             * The current scale factor.
+             */
+            double currentScaleFactor;
+
+            /**
+             * The current background color.
+             */
+            QColor currentBackgroundColor;
+
+            /**
+             * The scene being rendered.
+             */
+            QPointer<QGraphicsScene> currentScene;
+
+            /**
+             * The regions of the scene to be rendered as pages, in scene coordinates.
+             */
+            QList<QRectF> currentPageRectangles;
+
+            /**
+             * Rasterized pages waiting for earlier pages to be reported, keyed by page index.
+             */
+            QMap<unsigned, QImage> completedPages;
+
+            /**
+             * The index of the next page to be handed to a worker thread.
+             */
+            unsigned nextPageToStart;
+
+            /**
+             * The index of the next page to be reported.
+             */
+            unsigned nextPageToReport;
+    };
+}
+
+#endif
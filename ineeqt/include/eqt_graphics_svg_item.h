@@ -32,6 +32,8 @@
 
 #include <QGraphicsSvgItem>
 #include <QPixmap>
+#include <QSharedPointer>
+#include <QByteArray>
 
 #include "eqt_common.h"
 #include "eqt_graphics_item.h"
@@ -41,10 +43,18 @@ class QFont;
 class QPainter;
 class QStyleOptionGraphicsItem;
 class QWidget;
+class QSvgRenderer;
 
 namespace EQt {
     /**
-     * Trivlal class that extends QGraphicsSvgItem to bring it into the EQt framework.
+     * Class that extends QGraphicsSvgItem to bring it into the EQt framework.
+     *
+     * Items constructed from a filename share a single QSvgRenderer per distinct SVG document, keyed by the content
+     * of the file, so repeated glyphs and logos are parsed once.  When drawn to a widget, items also share rasterized
+     * pixmaps keyed by document, element and size in device pixels.  Pixmaps are held in a cache with a memory
+     * budget; printing and export continue to render the vector data.  Items using the shared pixmaps disable the
+     * per-item QGraphicsItem cache so each image is held in memory only once.  Files are read and hashed each time
+     * an item is loaded so edited files are never mistaken for their earlier content.
      */
     class EQT_PUBLIC_API GraphicsSvgItem:public QGraphicsSvgItem, public GraphicsItem {
         public:
@@ -53,6 +63,11 @@ namespace EQt {
              */
             enum { Type = QGraphicsItem::UserType + 5 };
 
+            /**
+             * The default raster cache budget, in KiB.
+             */
+            static const unsigned defaultRasterCacheSize;
+
             /**
              * Constructor
              *
@@ -78,11 +93,99 @@ namespace EQt {
              */
             int type() const override;
 
+            /**
+             * Method you can use to set the memory budget for the rasterized pixmaps shared by all SVG items.  A
+             * budget of zero disables the raster cache.
+             *
+             * \param[in] newCacheSize The new budget, in KiB.
+             */
+            static void setRasterCacheSize(unsigned newCacheSize);
+
+            /**
+             * Method you can use to obtain the memory budget for the rasterized pixmaps shared by all SVG items.
+             *
+             * \return Returns the budget, in KiB.
+             */
+            static unsigned rasterCacheSize();
+
+            /**
+             * Method you can use to empty the shared raster cache and reset the raster cache statistics.
+             */
+            static void clearRasterCache();
+
+            /**
+             * Method you can use to obtain the number of times an item was drawn using a cached pixmap.
+             *
+             * \return Returns the number of raster cache hits since the cache was last cleared.
+             */
+            static unsigned long long rasterCacheHits();
+
+            /**
+             * Method you can use to obtain the number of pixmaps that had to be rendered.
+             *
+             * \return Returns the number of raster cache misses since the cache was last cleared.
+             */
+            static unsigned long long rasterCacheMisses();
+
+            /**
+             * Method you can use to obtain the number of distinct SVG documents currently held by shared renderers.
+             *
+             * \return Returns the number of live shared renderers.
+             */
+            static unsigned numberSharedRenderers();
+
+            /**
+             * Method you can use to obtain the number of items that reused an existing shared renderer.
+             *
+             * \return Returns the number of renderer cache hits.
+             */
+            static unsigned long long rendererCacheHits();
+
+            /**
+             * Method you can use to obtain the number of SVG documents that had to be parsed.
+             *
+             * \return Returns the number of renderer cache misses.
+             */
+            static unsigned long long rendererCacheMisses();
+
+            /**
+             * Method that paints this item.  A cached pixmap is used when drawing to a widget with a transform that
+             * only scales and translates.
+             *
+             * \param[in] painter The painter to use to paint this item.
+             *
+             * \param[in] option  Style options for this item.
+             *
+             * \param[in] widget  The widget being painted on.  A null pointer indicates that the item is being
+             *                    printed or exported.
+             */
+            void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
             /**
              * Method you can call to remove this graphics item from the scene.  You should overload this method in
              * derived classes to remove the graphics item from the scene.
              */
             void removeFromScene() override;
+
+        private:
+            /**
+             * Method that obtains a shared renderer for a file, parsing the file only if no renderer for identical
+             * content is alive.  The per-item cache is disabled when the shared renderer is used.
+             *
+             * \param[in] filename The filename of the SVG file.
+             */
+            void loadSharedRenderer(const QString& filename);
+
+            /**
+             * The shared renderer used by this item.  The renderer is destroyed when the last item using it is
+             * destroyed.
+             */
+            QSharedPointer<QSvgRenderer> currentSharedRenderer;
+
+            /**
+             * Hash of the SVG document content used to key the shared caches.
+             */
+            QByteArray currentContentHash;
     };
 }
 
@@ -35,6 +35,7 @@
 #include <QString>
 #include <QBrush>
 #include <QPen>
+#include <QPointer>
 
 #include "eqt_common.h"
 #include "eqt_charts.h"
@@ -47,6 +48,8 @@ class QStyleOptionGraphicsItem;
 class QWidget;
 
 namespace EQt {
+    class GraphicsRasterCacheEffect;
+
     /**
      * Class that extends QPolarChart class (in the QtCharts frameworks) to address ownership management issues as well
      * as more cleanly handle insertion and removal from the graphics scene.
@@ -70,7 +73,8 @@ namespace EQt {
             ~Polar2DChartItem() override;
 
             /**
-             * Method you can use to set the geometry for the widget.
+             * Method you can use to set the geometry for the widget.  If updates are deferred, only the last geometry
+             * is applied when updates are restored.
              *
              * \param[in] rectangle The new bounding rectangle for the plot.
              */
@@ -111,7 +115,71 @@ namespace EQt {
              */
             void removeFromScene() override;
 
+            /**
+             * Method you can use to enable or disable the raster cache.  When enabled, the chart is rendered once into
+             * a pixmap at device resolution and drawn from that pixmap until the data, theme, or geometry changes.
+             * This is intended for charts embedded in documents that rarely change.
+             *
+             * \param[in] nowEnabled If true, the raster cache will be enabled.  If false, the chart will be drawn
+             *                       directly.
+             */
+            void setRasterCacheEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable the raster cache.
+             *
+             * \param[in] nowDisabled If true, the chart will be drawn directly.  If false, the raster cache will be
+             *                        enabled.
+             */
+            void setRasterCacheDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if the raster cache is enabled.
+             *
+             * \return Returns true if the raster cache is enabled.  Returns false if the raster cache is disabled.
+             */
+            bool rasterCacheEnabled() const;
+
+            /**
+             * Method you can use to determine if the raster cache is disabled.
+             *
+             * \return Returns true if the raster cache is disabled.  Returns false if the raster cache is enabled.
+             */
+            bool rasterCacheDisabled() const;
+
+            /**
+             * Method you can call when the user starts interacting with the chart, for example when zooming or
+             * panning.  The chart is drawn directly until the interaction ends.  Calls may be nested.
+             */
+            void beginInteraction();
+
+            /**
+             * Method you can call when the user stops interacting with the chart.
+             */
+            void endInteraction();
+
+        protected:
+            /**
+             * Method that is called to apply collected updates once updates are restored.
+             */
+            void applyDeferredUpdates() override;
+
         private:
+            /**
+             * The geometry to be applied once updates are restored.
+             */
+            QRectF currentPendingGeometry;
+
+            /**
+             * Flag indicating that a geometry change is waiting for updates to be restored.
+             */
+            bool currentGeometryIsPending;
+
+            /**
+             * The raster cache effect.  The effect is owned by the chart.
+             */
+            QPointer<GraphicsRasterCacheEffect> currentRasterCacheEffect;
+
             /**
              * The enforced bounding rectangle for the plot.
              */
@@ -33,6 +33,7 @@
 #include <QApplication>
 #include <QString>
 #include <QList>
+#include <QSet>
 
 #include "eqt_common.h"
 #include "eqt_unique_application.h"
@@ -42,6 +43,7 @@ class QAction;
 
 namespace EQt {
     class BuilderBase;
+    class Builder;
 
     /**
      * An application base class.  This class provides a thin wrapper on the \ref EQt::UniqueApplication class
@@ -49,6 +51,9 @@ namespace EQt {
      *
      *     * Support for plug-in modules.
      *     * Support for a database of builder instances that are used to create and extend the GUI.
+     *     * Concurrent preparation of builders on worker threads.
+     *
+     * Time spent in each builder phase is recorded by \ref EQt::BuilderProfiler when profiling is enabled.
      */
     class EQT_PUBLIC_API ProgrammaticApplication:public UniqueApplication {
         Q_OBJECT
@@ -116,15 +121,44 @@ namespace EQt {
             }
 
             /**
-             * Processes all the builders to register builder specific resources with the application.
+             * Returns the ordered list of builders derived from \ref EQt::Builder.  The list is maintained as builders
+             * are added so callers don't need to cast each builder.
+             *
+             * \return Returns the ordered list of builders.
+             */
+            static inline const QList<Builder*>& builders() {
+                return typedBuilderList;
+            }
+
+            /**
+             * Runs the \ref EQt::Builder::prepare method of every builder that has not yet been prepared.  Builders
+             * are prepared concurrently on worker threads.  This method returns once every builder has been prepared.
+             */
+            static void prepareBuilders();
+
+            /**
+             * Processes all the builders to register builder specific resources with the application.  Builders are
+             * prepared first.
              */
             void runBuilders();
 
         private:
+            class Preparer;
+
             /**
              * List of builder classes that have been instantiated with the application.
              */
             static QList<BuilderBase*> builderList;
+
+            /**
+             * List of builders derived from \ref EQt::Builder, in the same order as the builder list.
+             */
+            static QList<Builder*> typedBuilderList;
+
+            /**
+             * Set of builders that have already been prepared.
+             */
+            static QSet<Builder*> preparedBuilders;
     };
 }
 
@@ -36,7 +36,8 @@
 #include <QStringList>
 #include <QMap>
 #include <QSet>
-#include <QMultiMap>
+#include <QHash>
+#include <QVector>
 #include <QMainWindow>
 
 #include <cstdint>
@@ -68,6 +69,10 @@ namespace EQt {
      * The class also provides support for main window global actions, including the ability to group and manage
      * actions based on flags.
      *
+     * Menu entries are recorded as they're added and each menu is built the first time it's about to be shown, so
+     * large menu trees add little to start-up time.  Menu actions are also added to the window so their shortcuts are
+     * available before their menus are built.
+     *
      * Note that this class includes hacks specific to MacOS to disable and hide several MacOS specific menu items:
      *
      *     * "Edit | Start Dictation..."
@@ -563,7 +568,8 @@ namespace EQt {
             /**
              * Method you can use to set the action state.  The value will be AND'd against the state mask registered
              * with each action.  Actions with non-zero results will be enabled.  Actions with zero results will be
-             * disabled.
+             * disabled.  Only actions whose masks include a bit that changed are updated, so the cost of this method
+             * depends on the number of actions affected rather than the number of actions registered.
              *
              * This method will also call the \ref ProgrammaticMainWindowProxy::actionStateChanged method in each proxy
              * class.
@@ -620,6 +626,29 @@ namespace EQt {
              */
             Util::BitSet actionMask(const QString& actionName);
 
+            /**
+             * Method you can use to start a batch of action state changes.  Until the matching call to
+             * \ref EQt::ProgrammaticMainWindow::endActionStateUpdate, changes made by
+             * \ref EQt::ProgrammaticMainWindow::setActionState and \ref EQt::ProgrammaticMainWindow::setActionMask
+             * only record the desired enabled state of each action.  Calls may be nested.
+             */
+            void beginActionStateUpdate();
+
+            /**
+             * Method you can use to end a batch of action state changes.  When the outermost batch ends, the final
+             * recorded state of each affected action is applied once, so each affected action emits at most a single
+             * QAction::changed signal.  The state is applied even to hidden actions, which always report themselves
+             * as disabled, so they keep the correct state when shown again.
+             */
+            void endActionStateUpdate();
+
+            /**
+             * Method you can use to determine if a batch of action state changes is underway.
+             *
+             * \return Returns true if a batch is underway.
+             */
+            bool actionStateUpdateInProgress() const;
+
         protected:
             /**
              * Method that can be called from derived class constructors to run any registered builders.
@@ -698,6 +727,12 @@ namespace EQt {
              */
             void restackDockWidgets();
 
+            /**
+             * Slot that is triggered when a menu that has not yet been filled in is about to be shown.  The menu's
+             * entries are added and menus are created for its submenus.
+             */
+            void menuAboutToShow();
+
         private:
             class EQT_PUBLIC_API Node;
 
@@ -717,9 +752,14 @@ namespace EQt {
             static constexpr unsigned dockWidgetRestackingDelay = 300;
 
             /**
-             * Type containing a multi-map of actions indexed by action state.
+             * Type used to represent a set of actions.
              */
-            typedef QMultiMap<Util::BitSet, QAction*> ActionStateMap;
+            typedef QSet<QAction*> ActionSet;
+
+            /**
+             * Type used to index actions by each action state bit set in their action masks.
+             */
+            typedef QHash<unsigned long, ActionSet> ActionsByBit;
 
             /**
              * Type used to represent a set of programmatic docks.
@@ -768,35 +808,40 @@ namespace EQt {
             ProgrammaticMainWindow::Node* locateNode(const QStringList& menuTree, bool includeLastItem = false);
 
             /**
-             * Method that adjusts a multimap based on an action state.
+             * Method that builds the menus along the path to a menu node, including the menu node itself.
              *
-             * \param[in]     actionState  The action state that should be used to detemrine the adjustment.
-             *
-             * \param[in,out] multiMap     The map containing the actions to be traversed.  Actions that intersect the
-             *                             action state value will be removed from the map.
+             * \param[in] node The menu node to be built.
+             */
+            void materializeNode(ProgrammaticMainWindow::Node* node);
+
+            /**
+             * Method that adds an action to a menu node.  The action is also added to the window so that shortcuts
+             * work before the menu is built.
              *
-             * \param[in]     enableAction If true, the action will be enabled when removed.  If false, the action will
-             *                             be disabled when removed.
+             * \param[in] node   The menu node to receive the action.
              *
-             * \return Returns a multimap containing the removed actions.
+             * \param[in] action The action to be added.
              */
-            ActionStateMap processActionState(
-                const Util::BitSet& actionState,
-                ActionStateMap*     multiMap,
-                bool                enableAction
-            );
+            void addMenuEntry(ProgrammaticMainWindow::Node* node, QAction* action);
 
             /**
-             * Method that removes an action from an action map.
+             * Method that obtains the indexes of the bits set in a bit set.
              *
-             * \param[in] action    The action to be removed.
+             * \param[in] bitSet The bit set to be examined.
              *
-             * \param[in] actionMap The action map containing the action.
+             * \return Returns the indexes of the set bits, in ascending order.
+             */
+            static QVector<unsigned long> setBitIndexes(const Util::BitSet& bitSet);
+
+            /**
+             * Method that enables or disables an action.  If a batch of action state changes is underway, the desired
+             * state is recorded and applied when the batch ends.
+             *
+             * \param[in] action     The action to be updated.
              *
-             * \return Returns true if the action was found in the map and removed.  Returns false if the action was
-             *         not in the map.
+             * \param[in] nowEnabled If true, the action should be enabled.  If false, the action should be disabled.
              */
-            static bool removeFromMap(const QAction* action, ActionStateMap& actionMap);
+            void updateActionEnabled(QAction* action, bool nowEnabled);
 
             /**
              * Method that will combine two docks, taking into account tabbing.
@@ -847,6 +892,11 @@ namespace EQt {
              */
             QMap<QString, Node*> rootNodes;
 
+            /**
+             * Menus that have been created but not yet filled in, mapped to their menu nodes.
+             */
+            QHash<QMenu*, Node*> unpopulatedMenus;
+
             /**
              * Tool bars.
              */
@@ -865,22 +915,23 @@ namespace EQt {
             /**
              * Map of action masks by actions.
              */
-            QMap<QAction*, Util::BitSet> currentMasksByAction;
+            QHash<QAction*, Util::BitSet> currentMasksByAction;
 
             /**
-             * Dynamic map of currently enabled actions.
+             * Inverted index of the actions that depend on each action state bit.  A change in action state only
+             * visits the actions registered under the bits that changed.
              */
-            ActionStateMap currentlyEnabledActions;
+            ActionsByBit currentActionsByBit;
 
             /**
-             * Dynamic map of currently disabled actions.
+             * The nesting depth of action state batches.
              */
-            ActionStateMap currentlyDisabledActions;
+            unsigned currentActionUpdateDepth;
 
             /**
-             * Map of actions that have multiple set mask bits.
+             * The desired enabled state of actions changed during the current batch.
              */
-            ActionStateMap currentMultiBitMaskActions;
+            QHash<QAction*, bool> pendingActionEnables;
     };
 
     #if (defined(Q_OS_WIN))
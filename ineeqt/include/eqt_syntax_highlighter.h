@@ -0,0 +1,121 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::SyntaxHighlighter class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_SYNTAX_HIGHLIGHTER_H
+#define EQT_SYNTAX_HIGHLIGHTER_H
+
+#include <QString>
+#include <QSharedPointer>
+#include <QSyntaxHighlighter>
+
+#include "eqt_common.h"
+#include "eqt_syntax_rule_set.h"
+
+class QTextDocument;
+
+namespace EQt {
+    /**
+     * Class that highlights a document using a shared \ref EQt::SyntaxRuleSet.  Each highlighter keeps its own
+     * per-document state while the rule set itself is shared.
+     */
+    class EQT_PUBLIC_API SyntaxHighlighter:public QSyntaxHighlighter {
+        Q_OBJECT
+
+        public:
+            /**
+             * Constructor.
+             *
+             * \param[in] ruleSet The rule set used to highlight the document.
+             *
+             * \param[in] parent  The document to be highlighted.
+             */
+            SyntaxHighlighter(QSharedPointer<const SyntaxRuleSet> ruleSet, QTextDocument* parent = Q_NULLPTR);
+
+            ~SyntaxHighlighter() override;
+
+            /**
+             * Method you can use to obtain the rule set used by this highlighter.
+             *
+             * \return Returns the rule set.
+             */
+            QSharedPointer<const SyntaxRuleSet> ruleSet() const;
+
+            /**
+             * Method you can use to change the rule set used by this highlighter.  The document is highlighted again.
+             *
+             * \param[in] newRuleSet The new rule set.
+             */
+            void setRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet);
+
+            /**
+             * Method you can use to set the state assumed at the end of the block preceding the first block.  Use
+             * this when the document holds a window into a larger file so that the first block is highlighted as if
+             * the lines above it were present.  Blocks are highlighted again, starting with the first block, until
+             * their states match.
+             *
+             * \param[in] newInitialBlockState The new initial block state.  A value of -1 indicates the start of the
+             *                                 file.
+             */
+            void setInitialBlockState(int newInitialBlockState);
+
+            /**
+             * Method you can use to obtain the state assumed at the end of the block preceding the first block.
+             *
+             * \return Returns the initial block state.
+             */
+            int initialBlockState() const;
+
+        protected:
+            /**
+             * Method that is called to highlight a given block of text.  See the Qt 5 QSyntaxHighlighter documentation
+             * for details.
+             *
+             * \param[in] text The text to be highlighed.
+             */
+            void highlightBlock(const QString& text) override;
+
+        private:
+            /**
+             * The current rule set.
+             */
+            QSharedPointer<const SyntaxRuleSet> currentRuleSet;
+
+            /**
+             * Ranges reused between blocks to avoid repeated allocation.
+             */
+            SyntaxRuleSet::FormatRanges currentFormatRanges;
+
+            /**
+             * The state assumed at the end of the block preceding the first block.
+             */
+            int currentInitialBlockState;
+    };
+}
+
+#endif
@@ -0,0 +1,266 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref EQt::SyntaxRuleSet class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef EQT_SYNTAX_RULE_SET_H
+#define EQT_SYNTAX_RULE_SET_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QSharedPointer>
+#include <QRegularExpression>
+#include <QTextCharFormat>
+#include <QTextLayout>
+
+#include "eqt_common.h"
+
+namespace EQt {
+    /**
+     * Class that holds a compiled set of syntax highlighting rules.  A rule set is immutable once constructed, so a
+     * single instance can be shared by any number of highlighters, on any thread, without locking.  Patterns are
+     * compiled and optimized once, and each format is held once and shared by every highlighted range.
+     *
+     * Rule sets can be registered by file type and looked up by file type or filename suffix.  A rule set for C++,
+     * backed by \ref EQt::CppLexer, is registered under the file type "cpp".
+     */
+    class EQT_PUBLIC_API SyntaxRuleSet {
+        public:
+            /**
+             * Class that describes a single pattern to be highlighted.
+             */
+            class EQT_PUBLIC_API Rule {
+                public:
+                    Rule();
+
+                    /**
+                     * Constructor
+                     *
+                     * \param[in] pattern The regular expression to be highlighted.
+                     *
+                     * \param[in] format  The format to apply to each match.
+                     */
+                    Rule(const QString& pattern, const QTextCharFormat& format);
+
+                    ~Rule();
+
+                    /**
+                     * Method you can use to obtain the regular expression.
+                     *
+                     * \return Returns the regular expression.
+                     */
+                    QString pattern() const;
+
+                    /**
+                     * Method you can use to obtain the format.
+                     *
+                     * \return Returns the format applied to each match.
+                     */
+                    QTextCharFormat format() const;
+
+                private:
+                    QString         currentPattern;
+                    QTextCharFormat currentFormat;
+            };
+
+            /**
+             * Type used to hold a list of rules.
+             */
+            typedef QList<Rule> Rules;
+
+            /**
+             * Type used to report the highlighted ranges within a block.
+             */
+            typedef QVector<QTextLayout::FormatRange> FormatRanges;
+
+            /**
+             * The block state used for blocks that do not end inside a multi-line construct.
+             */
+            static const int normalState;
+
+            /**
+             * The block state used for blocks that end inside a multi-line construct.
+             */
+            static const int multiLineState;
+
+            /**
+             * Constructor.  Rules are applied in order with later rules replacing the format applied by earlier
+             * rules.  The multi-line construct, if any, is applied last.
+             *
+             * \param[in] name                  A descriptive name for the rule set.
+             *
+             * \param[in] rules                 The rules to apply.
+             *
+             * \param[in] multiLineStartPattern Regular expression that starts a multi-line construct such as a block
+             *                                  comment.  An empty string indicates no multi-line construct.
+             *
+             * \param[in] multiLineEndPattern   Regular expression that ends the multi-line construct.
+             *
+             * \param[in] multiLineFormat       The format applied to the multi-line construct.
+             */
+            SyntaxRuleSet(
+                const QString&         name,
+                const Rules&           rules,
+                const QString&         multiLineStartPattern = QString(),
+                const QString&         multiLineEndPattern = QString(),
+                const QTextCharFormat& multiLineFormat = QTextCharFormat()
+            );
+
+            ~SyntaxRuleSet();
+
+            /**
+             * Method you can use to obtain the name of this rule set.
+             *
+             * \return Returns the rule set name.
+             */
+            const QString& name() const;
+
+            /**
+             * Method you can use to determine if every pattern in this rule set compiled successfully.
+             *
+             * \return Returns true if the rule set is valid.
+             */
+            bool isValid() const;
+
+            /**
+             * Method that highlights a single block.
+             *
+             * \param[in]  text               The text of the block.
+             *
+             * \param[in]  previousBlockState The state at the end of the previous block.
+             *
+             * \param[out] formatRanges       Non-overlapping ranges to be highlighted, in order.  Any existing
+             *                                contents are replaced.
+             *
+             * \return Returns the state at the end of this block.
+             */
+            int highlightBlock(const QString& text, int previousBlockState, FormatRanges& formatRanges) const;
+
+            /**
+             * Method you can use to obtain the shared C++ rule set.
+             *
+             * \return Returns the C++ rule set.
+             */
+            static QSharedPointer<const SyntaxRuleSet> cppRuleSet();
+
+            /**
+             * Method you can use to register a rule set.  Any rule set previously registered for the file type or
+             * suffixes is replaced.
+             *
+             * \param[in] fileType     The file type, for example "cpp".
+             *
+             * \param[in] fileSuffixes Filename suffixes, without the leading period, that map to the file type.
+             *
+             * \param[in] ruleSet      The rule set to register.
+             */
+            static void registerRuleSet(
+                const QString&                      fileType,
+                const QStringList&                  fileSuffixes,
+                QSharedPointer<const SyntaxRuleSet> ruleSet
+            );
+
+            /**
+             * Method you can use to obtain the rule set registered for a file type.
+             *
+             * \param[in] fileType The file type.
+             *
+             * \return Returns the rule set.  A null pointer is returned if no rule set is registered.
+             */
+            static QSharedPointer<const SyntaxRuleSet> ruleSetForFileType(const QString& fileType);
+
+            /**
+             * Method you can use to obtain the rule set for a file, based on the filename suffix.
+             *
+             * \param[in] filename The filename.
+             *
+             * \return Returns the rule set.  A null pointer is returned if no rule set is registered for the suffix.
+             */
+            static QSharedPointer<const SyntaxRuleSet> ruleSetForFile(const QString& filename);
+
+            /**
+             * Method you can use to obtain the registered file types.
+             *
+             * \return Returns the registered file types.
+             */
+            static QStringList fileTypes();
+
+        private:
+            /**
+             * Constructor used for the C++ rule set.
+             *
+             * \param[in] name         A descriptive name for the rule set.
+             *
+             * \param[in] tokenFormats The format for each \ref EQt::CppLexer::TokenType value.
+             */
+            SyntaxRuleSet(const QString& name, const QVector<QTextCharFormat>& tokenFormats);
+
+            /**
+             * Method that registers the built-in rule sets.  The caller must hold the registry lock.
+             */
+            static void registerBuiltInRuleSets();
+
+            /**
+             * The rule set name.
+             */
+            QString currentName;
+
+            /**
+             * Flag indicating that blocks are scanned by \ref EQt::CppLexer rather than by regular expressions.
+             */
+            bool currentUsesCppLexer;
+
+            /**
+             * Flag indicating that every pattern compiled.
+             */
+            bool currentIsValid;
+
+            /**
+             * The compiled rule patterns.
+             */
+            QVector<QRegularExpression> currentExpressions;
+
+            /**
+             * The compiled pattern that starts a multi-line construct.
+             */
+            QRegularExpression currentMultiLineStartExpression;
+
+            /**
+             * The compiled pattern that ends a multi-line construct.
+             */
+            QRegularExpression currentMultiLineEndExpression;
+
+            /**
+             * The interned formats.  For regular expression rule sets, entry N is used by rule N and the final
+             * entry is used by the multi-line construct.
+             */
+            QVector<QTextCharFormat> currentFormats;
+    };
+}
+
+#endif
@@ -62,6 +62,7 @@ API_HEADERS = include/eqt_common.h \
               include/eqt_font_data.h \
               include/eqt_dock_widget_defaults.h \
               include/eqt_graphics_scene.h \
+              include/eqt_graphics_scene_page_renderer.h \
               include/eqt_graphics_item.h \
               include/eqt_graphics_text_item.h \
               include/eqt_graphics_rect_item.h \
@@ -72,9 +73,14 @@ API_HEADERS = include/eqt_common.h \
               include/eqt_graphics_math_group.h \
               include/eqt_graphics_math_group_with_line.h \
               include/eqt_graphics_math_group_with_painter_path.h \
+              include/eqt_graphics_item_serializer.h \
               include/eqt_stacking_layout.h \
               include/eqt_chart_item.h \
               include/eqt_polar_2d_chart_item.h \
+              include/eqt_chart_series_decimator.h \
+              include/eqt_chart_streaming_series.h \
+              include/eqt_graphics_raster_cache_effect.h \
+              include/eqt_chart_function_sampler.h \
               include/eqt_paragraph_diagram.h \
               include/eqt_paragraph_dimension_widget.h \
               include/eqt_line_sample_widget.h \
@@ -110,7 +116,12 @@ API_HEADERS = include/eqt_common.h \
               include/eqt_progress_bar.h \
               include/eqt_code_editor.h \
               include/eqt_code_editor_line_number_area.h \
+              include/eqt_code_editor_search_engine.h \
+              include/eqt_cpp_lexer.h \
+              include/eqt_syntax_rule_set.h \
+              include/eqt_syntax_highlighter.h \
               include/eqt_cpp_syntax_highlighter.h \
+              include/eqt_background_syntax_highlighter.h \
 \
               include/eqt_programmatic_application.h \
               include/eqt_programmatic_widget.h \
@@ -127,6 +138,7 @@ API_HEADERS = include/eqt_common.h \
               include/eqt_programmatic_view_proxy.h \
               include/eqt_builder_base.h \
               include/eqt_builder.h \
+              include/eqt_builder_profiler.h \
 
 ########################################################################################################################
 # Source files
@@ -142,19 +154,26 @@ SOURCES = source/eqt_application.cpp \
           source/dock_widget_location.cpp \
           source/dock_widget_locations.cpp \
           source/eqt_graphics_scene.cpp \
+          source/eqt_graphics_scene_page_renderer.cpp \
           source/eqt_graphics_item.cpp \
           source/eqt_graphics_text_item.cpp \
           source/eqt_graphics_rect_item.cpp \
           source/eqt_graphics_pixmap_item.cpp \
+          source/graphics_pixmap_pyramid.cpp \
           source/eqt_graphics_svg_item.cpp \
           source/eqt_graphics_item_group.cpp \
           source/eqt_graphics_multi_text_group.cpp \
           source/eqt_graphics_math_group.cpp \
           source/eqt_graphics_math_group_with_line.cpp \
           source/eqt_graphics_math_group_with_painter_path.cpp \
+          source/eqt_graphics_item_serializer.cpp \
           source/eqt_stacking_layout.cpp \
           source/eqt_chart_item.cpp \
           source/eqt_polar_2d_chart_item.cpp \
+          source/eqt_chart_series_decimator.cpp \
+          source/eqt_chart_streaming_series.cpp \
+          source/eqt_graphics_raster_cache_effect.cpp \
+          source/eqt_chart_function_sampler.cpp \
           source/eqt_paragraph_diagram.cpp \
           source/eqt_paragraph_dimension_widget.cpp \
           source/eqt_line_sample_widget.cpp \
@@ -189,7 +208,13 @@ SOURCES = source/eqt_application.cpp \
           source/eqt_progress_bar.cpp \
           source/eqt_code_editor.cpp \
           source/eqt_code_editor_line_number_area.cpp \
+          source/code_editor_file_index.cpp \
+          source/eqt_code_editor_search_engine.cpp \
+          source/eqt_cpp_lexer.cpp \
+          source/eqt_syntax_rule_set.cpp \
+          source/eqt_syntax_highlighter.cpp \
           source/eqt_cpp_syntax_highlighter.cpp \
+          source/eqt_background_syntax_highlighter.cpp \
 \
           source/eqt_programmatic_application.cpp \
           source/eqt_programmatic_widget.cpp \
@@ -205,6 +230,7 @@ SOURCES = source/eqt_application.cpp \
           source/eqt_programmatic_view_proxy.cpp \
           source/eqt_builder_base.cpp \
           source/eqt_builder.cpp \
+          source/eqt_builder_profiler.cpp \
 
 ########################################################################################################################
 # Private includes
@@ -213,6 +239,8 @@ SOURCES = source/eqt_application.cpp \
 INCLUDEPATH += source
 PRIVATE_HEADERS = source/dock_widget_location.h \
                   source/dock_widget_locations.h \
+                  source/graphics_pixmap_pyramid.h \
+                  source/code_editor_file_index.h \
 
 ########################################################################################################################
 # Setup headers and installation
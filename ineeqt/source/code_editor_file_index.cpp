@@ -0,0 +1,410 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref CodeEditorFileIndex class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QLatin1String>
+#include <QLatin1Char>
+#include <QVector>
+#include <QList>
+#include <QFile>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+
+#include <algorithm>
+#include <cstring>
+
+#include "code_editor_file_index.h"
+
+/***********************************************************************************************************************
+ * CodeEditorFileIndex::Batch
+ */
+
+/**
+ * Class that holds the line offsets found in one span of the file.
+ */
+class CodeEditorFileIndex::Batch {
+    public:
+        /**
+         * Constructor
+         */
+        Batch() {
+            bytesIndexed = 0;
+            isFinal      = false;
+        }
+
+        /**
+         * The offsets of the lines that start within the span.
+         */
+        QVector<qint64> lineStarts;
+
+        /**
+         * The number of bytes indexed once this batch is applied.
+         */
+        qint64 bytesIndexed;
+
+        /**
+         * Flag indicating that this is the last batch.
+         */
+        bool isFinal;
+};
+
+/***********************************************************************************************************************
+ * CodeEditorFileIndex::Context
+ */
+
+/**
+ * Class that holds state shared between an index and the worker thread.  Batches are queued here and the index is
+ * told when the queue becomes non-empty.
+ */
+class CodeEditorFileIndex::Context {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] index The index that should receive batches.
+         */
+        Context(CodeEditorFileIndex* index) {
+            currentIndex = index;
+        }
+
+        /**
+         * Method that is called by the worker thread to deliver a batch.  The batch is discarded if indexing was
+         * canceled.
+         *
+         * \param[in] batch The batch to deliver.
+         */
+        void deliver(const Batch& batch) {
+            QMutexLocker locker(&mutex);
+            if (currentIndex != Q_NULLPTR && !isCanceled()) {
+                bool notify = pendingBatches.isEmpty();
+                pendingBatches.append(batch);
+
+                if (notify) {
+                    QMetaObject::invokeMethod(currentIndex, "batchesReady", Qt::QueuedConnection);
+                }
+            }
+        }
+
+        /**
+         * Method that is called by the index to obtain the queued batches.
+         *
+         * \return Returns the queued batches, oldest first.
+         */
+        QList<Batch> takeBatches() {
+            QMutexLocker locker(&mutex);
+
+            QList<Batch> result;
+            result.swap(pendingBatches);
+
+            return result;
+        }
+
+        /**
+         * Method that is called to detach the index from this context.
+         */
+        void detach() {
+            QMutexLocker locker(&mutex);
+            currentIndex = Q_NULLPTR;
+            canceled.storeRelease(1);
+            pendingBatches.clear();
+        }
+
+        /**
+         * Method that is called to determine if indexing has been canceled.
+         *
+         * \return Returns true if indexing has been canceled.
+         */
+        bool isCanceled() const {
+            return canceled.loadAcquire() != 0;
+        }
+
+    private:
+        /**
+         * Mutex used to guard the index pointer and the batch queue.
+         */
+        QMutex mutex;
+
+        /**
+         * The index to receive batches.
+         */
+        CodeEditorFileIndex* currentIndex;
+
+        /**
+         * Batches waiting to be applied.
+         */
+        QList<Batch> pendingBatches;
+
+        /**
+         * Flag indicating that indexing has been canceled.
+         */
+        QAtomicInt canceled;
+};
+
+/***********************************************************************************************************************
+ * CodeEditorFileIndex::Indexer
+ */
+
+/**
+ * Runnable that locates the line terminators in the mapped file.
+ */
+class CodeEditorFileIndex::Indexer:public QRunnable {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] context  The shared context used to deliver batches.
+         *
+         * \param[in] file     The mapped file.  Holding the file keeps the mapping valid.
+         *
+         * \param[in] data     Pointer to the mapped file contents.
+         *
+         * \param[in] fileSize The file size, in bytes.
+         */
+        Indexer(
+                QSharedPointer<Context> context,
+                QSharedPointer<QFile>   file,
+                const char*             data,
+                qint64                  fileSize
+            ):currentContext(
+                context
+            ),currentFile(
+                file
+            ),currentData(
+                data
+            ),currentFileSize(
+                fileSize
+            ) {}
+
+        /**
+         * Method that performs the indexing.
+         */
+        void run() override {
+            qint64 offset = 0;
+            bool   done   = false;
+
+            while (!done && !currentContext->isCanceled()) {
+                Batch  batch;
+                qint64 end = std::min(offset + static_cast<qint64>(bytesPerBatch), currentFileSize);
+
+                const char* position    = currentData + offset;
+                const char* endPosition = currentData + end;
+                while (position < endPosition) {
+                    const void* newline = std::memchr(position, '\n', static_cast<std::size_t>(endPosition - position));
+                    if (newline != Q_NULLPTR) {
+                        position = static_cast<const char*>(newline) + 1;
+                        batch.lineStarts.append(position - currentData);
+                    } else {
+                        position = endPosition;
+                    }
+                }
+
+                done               = (end >= currentFileSize);
+                batch.bytesIndexed = end;
+                batch.isFinal      = done;
+
+                currentContext->deliver(batch);
+                offset = end;
+            }
+        }
+
+    private:
+        QSharedPointer<Context> currentContext;
+        QSharedPointer<QFile>   currentFile;
+        const char*             currentData;
+        qint64                  currentFileSize;
+};
+
+/***********************************************************************************************************************
+ * CodeEditorFileIndex
+ */
+
+const unsigned CodeEditorFileIndex::bytesPerBatch = 4 * 1024 * 1024;
+
+CodeEditorFileIndex::CodeEditorFileIndex(QObject* parent):QObject(parent) {
+    currentData         = Q_NULLPTR;
+    currentFileSize     = 0;
+    currentBytesIndexed = 0;
+    currentComplete     = false;
+}
+
+
+CodeEditorFileIndex::~CodeEditorFileIndex() {
+    cancel();
+}
+
+
+bool CodeEditorFileIndex::open(const QString& filename) {
+    bool success = false;
+
+    cancel();
+
+    currentFilename     = filename;
+    currentData         = Q_NULLPTR;
+    currentFileSize     = 0;
+    currentBytesIndexed = 0;
+    currentComplete     = false;
+
+    lineStarts.clear();
+    lineStarts.append(0);
+
+    // The file is released through deleteLater so that a worker thread holding the last reference never destroys
+    // the QFile outside of its own thread.
+
+    currentFile = QSharedPointer<QFile>(new QFile(filename), &QObject::deleteLater);
+    if (currentFile->open(QFile::ReadOnly)) {
+        currentFileSize = currentFile->size();
+        if (currentFileSize > 0) {
+            currentData = reinterpret_cast<const char*>(currentFile->map(0, currentFileSize));
+        }
+
+        if (currentFileSize == 0 || currentData != Q_NULLPTR) {
+            currentContext.reset(new Context(this));
+            QThreadPool::globalInstance()->start(
+                new Indexer(currentContext, currentFile, currentData, currentFileSize)
+            );
+
+            success = true;
+        }
+    }
+
+    if (!success) {
+        currentFile.reset();
+        currentData     = Q_NULLPTR;
+        currentFileSize = 0;
+    }
+
+    return success;
+}
+
+
+void CodeEditorFileIndex::cancel() {
+    if (!currentContext.isNull()) {
+        currentContext->detach();
+        currentContext.reset();
+    }
+}
+
+
+const QString& CodeEditorFileIndex::filename() const {
+    return currentFilename;
+}
+
+
+qint64 CodeEditorFileIndex::fileSize() const {
+    return currentFileSize;
+}
+
+
+qint64 CodeEditorFileIndex::bytesIndexed() const {
+    return currentBytesIndexed;
+}
+
+
+bool CodeEditorFileIndex::isIndexing() const {
+    return !currentContext.isNull();
+}
+
+
+bool CodeEditorFileIndex::isComplete() const {
+    return currentComplete;
+}
+
+
+unsigned long CodeEditorFileIndex::lineCount() const {
+    // Until the file is complete, the last entry marks the start of a line whose end is not yet known.
+    return currentComplete ? lineStarts.size() : lineStarts.size() - 1;
+}
+
+
+qint64 CodeEditorFileIndex::lineOffset(unsigned long line) const {
+    return line < static_cast<unsigned long>(lineStarts.size()) ? lineStarts.at(line) : currentFileSize;
+}
+
+
+QString CodeEditorFileIndex::lines(unsigned long firstLine, unsigned long numberLines) const {
+    QString result;
+
+    unsigned long numberAvailable = lineCount();
+    if (firstLine < numberAvailable && numberLines > 0) {
+        unsigned long lastLine = std::min(firstLine + numberLines, numberAvailable) - 1;
+        qint64        start    = lineStarts.at(firstLine);
+        qint64        end      = lineEnd(lastLine);
+
+        result = QString::fromUtf8(currentData + start, static_cast<int>(end - start));
+        if (result.contains(QLatin1Char('\r'))) {
+            result.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+        }
+    }
+
+    return result;
+}
+
+
+void CodeEditorFileIndex::batchesReady() {
+    if (!currentContext.isNull()) {
+        QList<Batch> batches = currentContext->takeBatches();
+
+        bool finalBatch = false;
+        for (QList<Batch>::const_iterator it=batches.constBegin(),end=batches.constEnd() ; it!=end ; ++it) {
+            lineStarts          += it->lineStarts;
+            currentBytesIndexed  = it->bytesIndexed;
+            finalBatch           = finalBatch || it->isFinal;
+        }
+
+        if (finalBatch) {
+            currentComplete = true;
+            currentContext.reset();
+        }
+
+        emit progress(currentBytesIndexed, currentFileSize);
+
+        if (finalBatch) {
+            emit finished();
+        }
+    }
+}
+
+
+qint64 CodeEditorFileIndex::lineEnd(unsigned long line) const {
+    qint64 end = (
+          line + 1 < static_cast<unsigned long>(lineStarts.size())
+        ? lineStarts.at(line + 1) - 1
+        : currentFileSize
+    );
+
+    if (end > lineStarts.at(line) && currentData[end - 1] == '\r') {
+        --end;
+    }
+
+    return end;
+}
@@ -0,0 +1,220 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref CodeEditorFileIndex class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef CODE_EDITOR_FILE_INDEX_H
+#define CODE_EDITOR_FILE_INDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+
+class QFile;
+
+/**
+ * Class that memory maps a text file and builds an index of line start offsets on a worker thread.  The index is
+ * used by \ref EQt::CodeEditor to load large files in chunks or to display a window of lines without loading the
+ * entire file.  Files are assumed to be UTF-8 encoded.
+ */
+class CodeEditorFileIndex:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * The number of bytes scanned by the worker thread between progress reports.
+         */
+        static const unsigned bytesPerBatch;
+
+        /**
+         * Constructor
+         *
+         * \param[in] parent The parent object.
+         */
+        CodeEditorFileIndex(QObject* parent = Q_NULLPTR);
+
+        ~CodeEditorFileIndex() override;
+
+        /**
+         * Method that maps a file and starts indexing it on the global thread pool.
+         *
+         * \param[in] filename The file to be indexed.
+         *
+         * \return Returns true on success.  Returns false if the file could not be opened or mapped.
+         */
+        bool open(const QString& filename);
+
+        /**
+         * Method that stops indexing.  Lines that were indexed before the call remain available.  The
+         * \ref CodeEditorFileIndex::finished signal is not emitted.
+         */
+        void cancel();
+
+        /**
+         * Method you can use to obtain the filename.
+         *
+         * \return Returns the filename.
+         */
+        const QString& filename() const;
+
+        /**
+         * Method you can use to obtain the size of the file.
+         *
+         * \return Returns the file size, in bytes.
+         */
+        qint64 fileSize() const;
+
+        /**
+         * Method you can use to determine how much of the file has been indexed.
+         *
+         * \return Returns the number of bytes indexed.
+         */
+        qint64 bytesIndexed() const;
+
+        /**
+         * Method you can use to determine if indexing is underway.
+         *
+         * \return Returns true if the worker thread is still indexing the file.
+         */
+        bool isIndexing() const;
+
+        /**
+         * Method you can use to determine if the entire file has been indexed.
+         *
+         * \return Returns true if the file has been fully indexed.
+         */
+        bool isComplete() const;
+
+        /**
+         * Method you can use to obtain the number of lines indexed so far.  While indexing is underway, only lines
+         * whose terminating newline has been found are counted.
+         *
+         * \return Returns the number of available lines.
+         */
+        unsigned long lineCount() const;
+
+        /**
+         * Method you can use to obtain the byte offset of the start of a line.
+         *
+         * \param[in] line The zero based line number.  Passing \ref CodeEditorFileIndex::lineCount returns the
+         *                 offset just past the last available line.
+         *
+         * \return Returns the byte offset of the line.
+         */
+        qint64 lineOffset(unsigned long line) const;
+
+        /**
+         * Method that decodes a range of lines.
+         *
+         * \param[in] firstLine   The zero based first line.
+         *
+         * \param[in] numberLines The number of lines to decode.
+         *
+         * \return Returns the lines, separated by newline characters.  Carriage returns preceding newlines are
+         *         removed.  No newline follows the last line.
+         */
+        QString lines(unsigned long firstLine, unsigned long numberLines) const;
+
+    signals:
+        /**
+         * Signal that is emitted each time more of the file has been indexed.
+         *
+         * \param[in] bytesIndexed The number of bytes indexed so far.
+         *
+         * \param[in] totalBytes   The file size, in bytes.
+         */
+        void progress(qint64 bytesIndexed, qint64 totalBytes);
+
+        /**
+         * Signal that is emitted once the entire file has been indexed.
+         */
+        void finished();
+
+    private slots:
+        /**
+         * Slot that is triggered when the worker thread has queued results.
+         */
+        void batchesReady();
+
+    private:
+        class Batch;
+        class Context;
+        class Indexer;
+
+        /**
+         * Method that returns the byte offset just past the end of a line, excluding the line terminator.
+         *
+         * \param[in] line The zero based line number.
+         *
+         * \return Returns the end offset.
+         */
+        qint64 lineEnd(unsigned long line) const;
+
+        /**
+         * The filename.
+         */
+        QString currentFilename;
+
+        /**
+         * The mapped file.  The file is shared with the worker thread so the mapping remains valid until the worker
+         * exits.
+         */
+        QSharedPointer<QFile> currentFile;
+
+        /**
+         * Pointer to the mapped file contents.
+         */
+        const char* currentData;
+
+        /**
+         * The file size, in bytes.
+         */
+        qint64 currentFileSize;
+
+        /**
+         * The number of bytes indexed so far.
+         */
+        qint64 currentBytesIndexed;
+
+        /**
+         * The byte offset of the start of each line.
+         */
+        QVector<qint64> lineStarts;
+
+        /**
+         * Flag indicating that the entire file has been indexed.
+         */
+        bool currentComplete;
+
+        /**
+         * Context shared with the worker thread for the indexing underway.
+         */
+        QSharedPointer<Context> currentContext;
+};
+
+#endif
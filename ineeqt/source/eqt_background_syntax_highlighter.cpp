@@ -0,0 +1,639 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::BackgroundSyntaxHighlighter class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QPoint>
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QTextLayout>
+#include <QTextCursor>
+#include <QPlainTextEdit>
+
+#include <algorithm>
+
+#include "eqt_syntax_rule_set.h"
+#include "eqt_background_syntax_highlighter.h"
+
+/***********************************************************************************************************************
+ * EQt::BackgroundSyntaxHighlighter::Batch
+ */
+
+namespace EQt {
+    /**
+     * Class that holds the results for a run of consecutive blocks.
+     */
+    class BackgroundSyntaxHighlighter::Batch {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] speculative If true, the batch was scanned using previously known block states and only the
+             *                        formats should be applied.
+             *
+             * \param[in] firstBlock  The first block in the batch.
+             */
+            Batch(bool speculative = false, int firstBlock = 0) {
+                isSpeculative = speculative;
+                isFinal       = false;
+                startBlock    = firstBlock;
+            }
+
+            /**
+             * Flag indicating that only the formats should be applied.
+             */
+            bool isSpeculative;
+
+            /**
+             * Flag indicating that this is the last batch of the scan.
+             */
+            bool isFinal;
+
+            /**
+             * The first block in the batch.
+             */
+            int startBlock;
+
+            /**
+             * Non-overlapping ranges to be highlighted, by block.
+             */
+            QVector<SyntaxRuleSet::FormatRanges> blockRanges;
+
+            /**
+             * The state at the end of each block.
+             */
+            QVector<int> blockStates;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::BackgroundSyntaxHighlighter::Context
+ */
+
+namespace EQt {
+    /**
+     * Class that holds state shared between the highlighter and the worker thread.  Batches are queued here and the
+     * highlighter is told when the queue becomes non-empty.
+     */
+    class BackgroundSyntaxHighlighter::Context {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] highlighter The highlighter that should receive batches.
+             */
+            Context(BackgroundSyntaxHighlighter* highlighter) {
+                currentHighlighter = highlighter;
+            }
+
+            /**
+             * Method that is called by the worker thread to deliver a batch.  The batch is discarded if the scan was
+             * canceled.
+             *
+             * \param[in] batch The batch to deliver.
+             */
+            void deliver(const Batch& batch) {
+                QMutexLocker locker(&mutex);
+                if (currentHighlighter != Q_NULLPTR && !isCanceled()) {
+                    bool notify = pendingBatches.isEmpty();
+                    pendingBatches.append(batch);
+
+                    if (notify) {
+                        QMetaObject::invokeMethod(currentHighlighter, "batchesReady", Qt::QueuedConnection);
+                    }
+                }
+            }
+
+            /**
+             * Method that is called by the highlighter to obtain the queued batches.
+             *
+             * \return Returns the queued batches, oldest first.
+             */
+            QList<Batch> takeBatches() {
+                QMutexLocker locker(&mutex);
+
+                QList<Batch> result;
+                result.swap(pendingBatches);
+
+                return result;
+            }
+
+            /**
+             * Method that is called to detach the highlighter from this context.
+             */
+            void detach() {
+                QMutexLocker locker(&mutex);
+                currentHighlighter = Q_NULLPTR;
+                canceled.storeRelease(1);
+                pendingBatches.clear();
+            }
+
+            /**
+             * Method that is called to determine if outstanding work has been canceled.
+             *
+             * \return Returns true if outstanding work has been canceled.
+             */
+            bool isCanceled() const {
+                return canceled.loadAcquire() != 0;
+            }
+
+        private:
+            /**
+             * Mutex used to guard the highlighter pointer and the batch queue.
+             */
+            QMutex mutex;
+
+            /**
+             * The highlighter to receive batches.
+             */
+            BackgroundSyntaxHighlighter* currentHighlighter;
+
+            /**
+             * Batches waiting to be applied.
+             */
+            QList<Batch> pendingBatches;
+
+            /**
+             * Flag indicating that outstanding work has been canceled.
+             */
+            QAtomicInt canceled;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::BackgroundSyntaxHighlighter::Scanner
+ */
+
+namespace EQt {
+    /**
+     * Runnable that scans a snapshot of the document.
+     */
+    class BackgroundSyntaxHighlighter::Scanner:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] context      The shared context used to deliver batches.
+             *
+             * \param[in] ruleSet      The rule set used to highlight the blocks.
+             *
+             * \param[in] texts        Snapshot of the block texts.
+             *
+             * \param[in] states       Snapshot of the block states from the previous scan.
+             *
+             * \param[in] firstBlock   The first dirty block.
+             *
+             * \param[in] lastBlock    The last dirty block.
+             *
+             * \param[in] visibleFirst The first visible block, or -1 if unknown.
+             *
+             * \param[in] visibleLast  The last visible block, or -1 if unknown.
+             *
+             * \param[in] initialState The state at the end of the block preceding the first block.
+             */
+            Scanner(
+                    QSharedPointer<Context>             context,
+                    QSharedPointer<const SyntaxRuleSet> ruleSet,
+                    const QVector<QString>&             texts,
+                    const QVector<int>&                 states,
+                    int                                 firstBlock,
+                    int                                 lastBlock,
+                    int                                 visibleFirst,
+                    int                                 visibleLast,
+                    int                                 initialState
+                ):currentContext(
+                    context
+                ),currentRuleSet(
+                    ruleSet
+                ),currentTexts(
+                    texts
+                ),currentStates(
+                    states
+                ),currentFirstBlock(
+                    firstBlock
+                ),currentLastBlock(
+                    lastBlock
+                ),currentVisibleFirst(
+                    visibleFirst
+                ),currentVisibleLast(
+                    visibleLast
+                ),currentInitialState(
+                    initialState
+                ) {}
+
+            /**
+             * Method that performs the scan.
+             */
+            void run() override {
+                int numberBlocks = currentTexts.size();
+
+                // Highlight the visible blocks below the edit first, assuming the state entering them is unchanged.
+                // The in-order pass below corrects them if that assumption turns out to be wrong.
+
+                int previewFirst = std::max(currentVisibleFirst, currentFirstBlock + 1);
+                int previewLast  = std::min(currentVisibleLast, numberBlocks - 1);
+                if (previewFirst <= previewLast) {
+                    Batch preview(true, previewFirst);
+
+                    int state = currentStates.at(previewFirst - 1);
+                    int block = previewFirst;
+                    while (block <= previewLast && !currentContext->isCanceled()) {
+                        state = scanBlock(block, state, preview);
+                        ++block;
+                    }
+
+                    currentContext->deliver(preview);
+                }
+
+                Batch batch(false, currentFirstBlock);
+
+                int  state = currentFirstBlock > 0 ? currentStates.at(currentFirstBlock - 1) : currentInitialState;
+                int  block = currentFirstBlock;
+                bool done  = false;
+                while (!done && !currentContext->isCanceled()) {
+                    state = scanBlock(block, state, batch);
+
+                    bool converged = (block >= currentLastBlock && state == currentStates.at(block));
+                    done = converged || block + 1 >= numberBlocks;
+
+                    if (done                                                                 ||
+                        static_cast<unsigned>(batch.blockStates.size()) >= blocksPerBatch    ||
+                        block == currentVisibleLast                                             ) {
+                        batch.isFinal = done;
+                        currentContext->deliver(batch);
+
+                        batch = Batch(false, block + 1);
+                    }
+
+                    ++block;
+                }
+            }
+
+        private:
+            /**
+             * Method that scans a single block and appends the results to a batch.
+             *
+             * \param[in]     block The zero based block index.
+             *
+             * \param[in]     state The state at the end of the previous block.
+             *
+             * \param[in,out] batch The batch to receive the results.
+             *
+             * \return Returns the state at the end of the block.
+             */
+            int scanBlock(int block, int state, Batch& batch) {
+                SyntaxRuleSet::FormatRanges ranges;
+                int newState = currentRuleSet->highlightBlock(currentTexts.at(block), state, ranges);
+
+                batch.blockRanges.append(ranges);
+                batch.blockStates.append(newState);
+
+                return newState;
+            }
+
+            QSharedPointer<Context>             currentContext;
+            QSharedPointer<const SyntaxRuleSet> currentRuleSet;
+            QVector<QString>                    currentTexts;
+            QVector<int>                        currentStates;
+            int                                 currentFirstBlock;
+            int                                 currentLastBlock;
+            int                                 currentVisibleFirst;
+            int                                 currentVisibleLast;
+            int                                 currentInitialState;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::BackgroundSyntaxHighlighter
+ */
+
+namespace EQt {
+    const unsigned BackgroundSyntaxHighlighter::blocksPerBatch = 1000;
+
+    /**
+     * Block state used for blocks whose end state is not known.  The value never matches a lexer state.
+     */
+    static const int unknownBlockState = -2;
+
+    BackgroundSyntaxHighlighter::BackgroundSyntaxHighlighter(
+            QPlainTextEdit*                     editor,
+            QSharedPointer<const SyntaxRuleSet> ruleSet
+        ):QObject(
+            editor
+        ) {
+        currentEditor            = editor;
+        currentDocument          = editor->document();
+        currentRuleSet           = ruleSet.isNull() ? SyntaxRuleSet::cppRuleSet() : ruleSet;
+        currentThreadPool        = Q_NULLPTR;
+        firstDirtyBlock          = -1;
+        lastDirtyBlock           = -1;
+        scanNextBlock            = 0;
+        scanLastDirtyBlock       = -1;
+        currentInitialBlockState = -1;
+        applyingBatch            = false;
+
+        scanTimer = new QTimer(this);
+        scanTimer->setSingleShot(true);
+        scanTimer->setInterval(0);
+
+        connect(scanTimer, SIGNAL(timeout()), this, SLOT(startScan()));
+        connect(
+            currentDocument.data(),
+            SIGNAL(contentsChange(int,int,int)),
+            this,
+            SLOT(contentsChange(int,int,int))
+        );
+
+        rehighlight();
+    }
+
+
+    BackgroundSyntaxHighlighter::~BackgroundSyntaxHighlighter() {
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+        }
+    }
+
+
+    QPlainTextEdit* BackgroundSyntaxHighlighter::editor() const {
+        return currentEditor.data();
+    }
+
+
+    QSharedPointer<const SyntaxRuleSet> BackgroundSyntaxHighlighter::ruleSet() const {
+        return currentRuleSet;
+    }
+
+
+    void BackgroundSyntaxHighlighter::setRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet) {
+        currentRuleSet = newRuleSet.isNull() ? SyntaxRuleSet::cppRuleSet() : newRuleSet;
+        rehighlight();
+    }
+
+
+    void BackgroundSyntaxHighlighter::setThreadPool(QThreadPool* newThreadPool) {
+        currentThreadPool = newThreadPool;
+    }
+
+
+    QThreadPool* BackgroundSyntaxHighlighter::threadPool() const {
+        return currentThreadPool != Q_NULLPTR ? currentThreadPool : QThreadPool::globalInstance();
+    }
+
+
+    bool BackgroundSyntaxHighlighter::isIdle() const {
+        return firstDirtyBlock < 0 && currentContext.isNull();
+    }
+
+
+    void BackgroundSyntaxHighlighter::setInitialBlockState(int newInitialBlockState) {
+        if (newInitialBlockState != currentInitialBlockState) {
+            cancelScan();
+            currentInitialBlockState = newInitialBlockState;
+
+            if (!blockTexts.isEmpty()) {
+                markDirty(0, 0);
+                scanTimer->start();
+            }
+        }
+    }
+
+
+    int BackgroundSyntaxHighlighter::initialBlockState() const {
+        return currentInitialBlockState;
+    }
+
+
+    void BackgroundSyntaxHighlighter::rehighlight() {
+        cancelScan();
+
+        if (!currentDocument.isNull()) {
+            int numberBlocks = currentDocument->blockCount();
+
+            blockTexts.clear();
+            blockTexts.reserve(numberBlocks);
+
+            for (QTextBlock block=currentDocument->firstBlock() ; block.isValid() ; block=block.next()) {
+                blockTexts.append(block.text());
+            }
+
+            blockStates.fill(unknownBlockState, blockTexts.size());
+
+            firstDirtyBlock = -1;
+            markDirty(0, blockTexts.size() - 1);
+
+            scanTimer->start();
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::contentsChange(int position, int charsRemoved, int charsAdded) {
+        if (!applyingBatch && !currentDocument.isNull() && (charsRemoved != 0 || charsAdded != 0)) {
+            cancelScan();
+
+            QTextBlock firstBlock = currentDocument->findBlock(position);
+            QTextBlock lastBlock  = currentDocument->findBlock(position + charsAdded);
+            if (!lastBlock.isValid()) {
+                lastBlock = currentDocument->lastBlock();
+            }
+
+            int first           = firstBlock.isValid() ? firstBlock.blockNumber() : 0;
+            int last            = std::max(first, lastBlock.blockNumber());
+            int numberNewBlocks = last - first + 1;
+            int delta           = currentDocument->blockCount() - blockTexts.size();
+            int numberOldBlocks = numberNewBlocks - delta;
+
+            if (numberOldBlocks < 1 || first + numberOldBlocks > blockTexts.size()) {
+                rehighlight();
+            } else {
+                // The block following the edit was last scanned using the state at the end of the last replaced
+                // block, so that state is carried over to allow the scan to stop early.
+
+                int carriedState = blockStates.at(first + numberOldBlocks - 1);
+
+                if (delta != 0) {
+                    blockTexts.remove(first, numberOldBlocks);
+                    blockTexts.insert(first, numberNewBlocks, QString());
+
+                    blockStates.remove(first, numberOldBlocks);
+                    blockStates.insert(first, numberNewBlocks, unknownBlockState);
+                } else {
+                    std::fill(blockStates.begin() + first, blockStates.begin() + last, unknownBlockState);
+                }
+
+                blockStates[last] = carriedState;
+
+                QTextBlock block = firstBlock;
+                for (int index=first ; index<=last && block.isValid() ; ++index) {
+                    blockTexts[index] = block.text();
+                    block = block.next();
+                }
+
+                if (firstDirtyBlock >= 0 && lastDirtyBlock >= first) {
+                    lastDirtyBlock = std::max(lastDirtyBlock + delta, first);
+                }
+
+                markDirty(first, last);
+                scanTimer->start();
+            }
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::startScan() {
+        if (!currentDocument.isNull() && firstDirtyBlock >= 0 && currentContext.isNull()) {
+            int numberBlocks = blockTexts.size();
+            int first        = firstDirtyBlock;
+            int last         = std::min(lastDirtyBlock, numberBlocks - 1);
+
+            firstDirtyBlock = -1;
+            lastDirtyBlock  = -1;
+
+            if (first < numberBlocks) {
+                int visibleFirst = -1;
+                int visibleLast  = -1;
+
+                if (!currentEditor.isNull()) {
+                    QPoint bottomLeft(0, currentEditor->viewport()->height() - 1);
+                    visibleFirst = currentEditor->cursorForPosition(QPoint(0, 0)).blockNumber();
+                    visibleLast  = currentEditor->cursorForPosition(bottomLeft).blockNumber();
+                }
+
+                currentContext     = QSharedPointer<Context>(new Context(this));
+                scanNextBlock      = first;
+                scanLastDirtyBlock = last;
+
+                threadPool()->start(
+                    new Scanner(
+                        currentContext,
+                        currentRuleSet,
+                        blockTexts,
+                        blockStates,
+                        first,
+                        last,
+                        visibleFirst,
+                        visibleLast,
+                        currentInitialBlockState
+                    )
+                );
+            } else {
+                emit highlightingFinished();
+            }
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::batchesReady() {
+        if (!currentContext.isNull()) {
+            QList<Batch> batches = currentContext->takeBatches();
+            for (QList<Batch>::const_iterator it=batches.constBegin(),end=batches.constEnd() ; it!=end ; ++it) {
+                applyBatch(*it);
+            }
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::cancelScan() {
+        scanTimer->stop();
+
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+            currentContext.reset();
+
+            if (scanNextBlock < blockTexts.size()) {
+                markDirty(scanNextBlock, std::max(scanLastDirtyBlock, scanNextBlock));
+            }
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::markDirty(int firstBlock, int lastBlock) {
+        if (firstDirtyBlock < 0) {
+            firstDirtyBlock = firstBlock;
+            lastDirtyBlock  = lastBlock;
+        } else {
+            firstDirtyBlock = std::min(firstDirtyBlock, firstBlock);
+            lastDirtyBlock  = std::max(lastDirtyBlock, lastBlock);
+        }
+    }
+
+
+    void BackgroundSyntaxHighlighter::applyBatch(const BackgroundSyntaxHighlighter::Batch& batch) {
+        int numberBlocks = batch.blockStates.size();
+        if (!currentDocument.isNull() && numberBlocks > 0) {
+            applyingBatch = true;
+
+            QTextBlock block         = currentDocument->findBlockByNumber(batch.startBlock);
+            int        startPosition = block.position();
+            int        endPosition   = startPosition;
+
+            int index = 0;
+            while (index < numberBlocks && block.isValid()) {
+                block.layout()->setFormats(batch.blockRanges.at(index));
+
+                if (!batch.isSpeculative) {
+                    int state = batch.blockStates.at(index);
+                    block.setUserState(state);
+                    blockStates[batch.startBlock + index] = state;
+                }
+
+                endPosition = block.position() + block.length();
+                block       = block.next();
+
+                ++index;
+            }
+
+            currentDocument->markContentsDirty(startPosition, endPosition - startPosition);
+            applyingBatch = false;
+
+            if (!batch.isSpeculative) {
+                scanNextBlock = batch.startBlock + numberBlocks;
+            }
+
+            if (batch.isFinal) {
+                currentContext.reset();
+
+                if (firstDirtyBlock >= 0) {
+                    scanTimer->start();
+                } else {
+                    emit highlightingFinished();
+                }
+            }
+        }
+    }
+}
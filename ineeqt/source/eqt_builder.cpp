@@ -47,6 +47,9 @@ namespace EQt {
     Builder::~Builder() {}
 
 
+    void Builder::prepare() {}
+
+
     void Builder::registerResources(ProgrammaticApplication*) {}
 
 
@@ -0,0 +1,229 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::BuilderProfiler class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+#include "eqt_common.h"
+#include "eqt_builder_base.h"
+#include "eqt_builder_profiler.h"
+
+/***********************************************************************************************************************
+ * Class BuilderProfiler::Timing
+ */
+
+namespace EQt {
+    BuilderProfiler::Timing::Timing() {
+        currentNumberCalls        = 0;
+        currentElapsedNanoseconds = 0;
+    }
+
+
+    BuilderProfiler::Timing::Timing(
+            const QString& builderIdentifier,
+            const QString& plugInName,
+            const QString& phase
+        ) {
+        currentBuilderIdentifier  = builderIdentifier;
+        currentPlugInName         = plugInName;
+        currentPhase              = phase;
+        currentNumberCalls        = 0;
+        currentElapsedNanoseconds = 0;
+    }
+
+
+    BuilderProfiler::Timing::~Timing() {}
+
+
+    const QString& BuilderProfiler::Timing::builderIdentifier() const {
+        return currentBuilderIdentifier;
+    }
+
+
+    const QString& BuilderProfiler::Timing::plugInName() const {
+        return currentPlugInName;
+    }
+
+
+    const QString& BuilderProfiler::Timing::phase() const {
+        return currentPhase;
+    }
+
+
+    unsigned long BuilderProfiler::Timing::numberCalls() const {
+        return currentNumberCalls;
+    }
+
+
+    qint64 BuilderProfiler::Timing::elapsedNanoseconds() const {
+        return currentElapsedNanoseconds;
+    }
+
+
+    void BuilderProfiler::Timing::addCall(qint64 nanoseconds) {
+        ++currentNumberCalls;
+        currentElapsedNanoseconds += nanoseconds;
+    }
+}
+
+/***********************************************************************************************************************
+ * Class BuilderProfiler::Scope
+ */
+
+namespace EQt {
+    BuilderProfiler::Scope::Scope(const BuilderBase* builder, const char* phase) {
+        if (profilingEnabled()) {
+            currentBuilder = builder;
+            currentPhase   = phase;
+
+            timer.start();
+        } else {
+            currentBuilder = Q_NULLPTR;
+            currentPhase   = Q_NULLPTR;
+        }
+    }
+
+
+    BuilderProfiler::Scope::~Scope() {
+        if (currentBuilder != Q_NULLPTR) {
+            record(currentBuilder, currentPhase, timer.nsecsElapsed());
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * Class BuilderProfiler
+ */
+
+namespace EQt {
+    QAtomicInt                                                  BuilderProfiler::currentProfilingEnabled(0);
+    QMutex                                                      BuilderProfiler::timingMutex;
+    QHash<BuilderProfiler::TimingKey, BuilderProfiler::Timing> BuilderProfiler::currentTimings;
+
+    void BuilderProfiler::setProfilingEnabled(bool nowEnabled) {
+        currentProfilingEnabled.storeRelease(nowEnabled ? 1 : 0);
+    }
+
+
+    void BuilderProfiler::setProfilingDisabled(bool nowDisabled) {
+        setProfilingEnabled(!nowDisabled);
+    }
+
+
+    bool BuilderProfiler::profilingEnabled() {
+        return currentProfilingEnabled.loadAcquire() != 0;
+    }
+
+
+    bool BuilderProfiler::profilingDisabled() {
+        return !profilingEnabled();
+    }
+
+
+    void BuilderProfiler::record(const BuilderBase* builder, const char* phase, qint64 elapsedNanoseconds) {
+        QString   builderIdentifier = QString::fromUtf8(builder->builderIdentifier());
+        QString   phaseName         = QString::fromUtf8(phase);
+        TimingKey key(builderIdentifier, phaseName);
+
+        QMutexLocker locker(&timingMutex);
+
+        QHash<TimingKey, Timing>::iterator it = currentTimings.find(key);
+        if (it == currentTimings.end()) {
+            it = currentTimings.insert(
+                key,
+                Timing(builderIdentifier, QString::fromUtf8(builder->plugInName()), phaseName)
+            );
+        }
+
+        it.value().addCall(elapsedNanoseconds);
+    }
+
+
+    QList<BuilderProfiler::Timing> BuilderProfiler::timings() {
+        QList<Timing> result;
+
+        {
+            QMutexLocker locker(&timingMutex);
+            result = currentTimings.values();
+        }
+
+        std::stable_sort(result.begin(), result.end(), slowerTiming);
+        return result;
+    }
+
+
+    QString BuilderProfiler::report() {
+        QList<Timing> sortedTimings = timings();
+
+        qint64 totalNanoseconds = 0;
+        for (  QList<Timing>::const_iterator it  = sortedTimings.constBegin(),
+                                             end = sortedTimings.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            totalNanoseconds += it->elapsedNanoseconds();
+        }
+
+        QString result = QString("Builder start-up report: %1 ms total\n").arg(totalNanoseconds / 1.0E6, 0, 'f', 3);
+        for (  QList<Timing>::const_iterator it  = sortedTimings.constBegin(),
+                                             end = sortedTimings.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            QString builderName = it->plugInName().isEmpty()
+                                  ? it->builderIdentifier()
+                                  : QString("%1 (%2)").arg(it->builderIdentifier(), it->plugInName());
+
+            result += QString("%1 ms  %2 calls  %3::%4\n")
+                      .arg(it->elapsedNanoseconds() / 1.0E6, 12, 'f', 3)
+                      .arg(it->numberCalls(), 6)
+                      .arg(builderName)
+                      .arg(it->phase());
+        }
+
+        return result;
+    }
+
+
+    void BuilderProfiler::clear() {
+        QMutexLocker locker(&timingMutex);
+        currentTimings.clear();
+    }
+
+
+    bool BuilderProfiler::slowerTiming(const Timing& first, const Timing& second) {
+        return first.elapsedNanoseconds() > second.elapsedNanoseconds();
+    }
+}
@@ -0,0 +1,609 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::ChartFunctionSampler class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
+#include <QList>
+#include <QPolygonF>
+#include <QPointF>
+#include <QRectF>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+#include "eqt_charts.h"
+#include "eqt_chart_function_sampler.h"
+
+/***********************************************************************************************************************
+ * EQt::ChartFunctionSampler::Context
+ */
+
+namespace EQt {
+    /**
+     * Class that holds state shared between the sampler and the worker threads for a single sampling run.
+     */
+    class ChartFunctionSampler::Context {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] sampler    The sampler that should receive sampled points.
+             *
+             * \param[in] generation The sampling run this context belongs to.
+             */
+            Context(ChartFunctionSampler* sampler, unsigned generation) {
+                currentSampler    = sampler;
+                currentGeneration = generation;
+            }
+
+            /**
+             * Method that is called by a worker thread to deliver sampled points.  The points are discarded if the
+             * run was canceled.
+             *
+             * \param[in] chunkIndex The zero based index of the part of the domain.
+             *
+             * \param[in] points     The sampled points.
+             */
+            void deliver(unsigned chunkIndex, const QPolygonF& points) {
+                QMutexLocker locker(&mutex);
+                if (currentSampler != Q_NULLPTR && !isCanceled()) {
+                    QMetaObject::invokeMethod(
+                        currentSampler,
+                        "chunkSampled",
+                        Qt::QueuedConnection,
+                        Q_ARG(unsigned, currentGeneration),
+                        Q_ARG(unsigned, chunkIndex),
+                        Q_ARG(QPolygonF, points)
+                    );
+                }
+            }
+
+            /**
+             * Method that is called to detach the sampler from this context.
+             */
+            void detach() {
+                QMutexLocker locker(&mutex);
+                currentSampler = Q_NULLPTR;
+                canceled.storeRelease(1);
+            }
+
+            /**
+             * Method that is called to cancel outstanding work.
+             */
+            void cancel() {
+                canceled.storeRelease(1);
+            }
+
+            /**
+             * Method that is called to determine if outstanding work has been canceled.
+             *
+             * \return Returns true if outstanding work has been canceled.
+             */
+            bool isCanceled() const {
+                return canceled.loadAcquire() != 0;
+            }
+
+        private:
+            /**
+             * Mutex used to guard the sampler pointer.
+             */
+            QMutex mutex;
+
+            /**
+             * The sampler to receive points.
+             */
+            ChartFunctionSampler* currentSampler;
+
+            /**
+             * The sampling run this context belongs to.
+             */
+            unsigned currentGeneration;
+
+            /**
+             * Flag indicating that outstanding work has been canceled.
+             */
+            QAtomicInt canceled;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::ChartFunctionSampler::ChunkSampler
+ */
+
+namespace EQt {
+    /**
+     * Runnable that samples a contiguous run of the initial segments.
+     */
+    class ChartFunctionSampler::ChunkSampler:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] context        The shared context used to deliver points.
+             *
+             * \param[in] function       The function to be sampled.
+             *
+             * \param[in] chunkIndex     The zero based index of this part of the domain.
+             *
+             * \param[in] minimum        The start of the full domain.
+             *
+             * \param[in] maximum        The end of the full domain.
+             *
+             * \param[in] numberSegments The number of initial segments across the full domain.
+             *
+             * \param[in] firstSegment   The first initial segment sampled by this runnable.
+             *
+             * \param[in] endSegment     One past the last initial segment sampled by this runnable.
+             *
+             * \param[in] xScale         Scale factor converting X values to plot pixels.
+             *
+             * \param[in] yScale         Scale factor converting Y values to plot pixels.
+             *
+             * \param[in] maximumAngle   The maximum bend between segments, in degrees.
+             *
+             * \param[in] maximumDepth   The maximum number of subdivisions of an initial segment.
+             */
+            ChunkSampler(
+                    QSharedPointer<Context> context,
+                    const Function&         function,
+                    unsigned                chunkIndex,
+                    double                  minimum,
+                    double                  maximum,
+                    unsigned                numberSegments,
+                    unsigned                firstSegment,
+                    unsigned                endSegment,
+                    double                  xScale,
+                    double                  yScale,
+                    double                  maximumAngle,
+                    unsigned                maximumDepth
+                ):currentContext(
+                    context
+                ),currentFunction(
+                    function
+                ),currentChunkIndex(
+                    chunkIndex
+                ),currentMinimum(
+                    minimum
+                ),currentMaximum(
+                    maximum
+                ),currentNumberSegments(
+                    numberSegments
+                ),currentFirstSegment(
+                    firstSegment
+                ),currentEndSegment(
+                    endSegment
+                ),currentXScale(
+                    xScale
+                ),currentYScale(
+                    yScale
+                ),currentMaximumDepth(
+                    maximumDepth
+                ) {
+                minimumCosine = std::cos(maximumAngle * 3.14159265358979323846 / 180.0);
+            }
+
+            /**
+             * Method that performs the sampling.
+             */
+            void run() override {
+                QPolygonF points;
+
+                QPointF start = evaluate(segmentStart(currentFirstSegment));
+
+                // Each chunk omits its starting point, which is the final point of the preceding chunk.
+
+                if (currentFirstSegment == 0) {
+                    append(points, start);
+                }
+
+                unsigned segment = currentFirstSegment;
+                while (segment < currentEndSegment && !currentContext->isCanceled()) {
+                    QPointF end = evaluate(segmentStart(segment + 1));
+                    refine(start, end, 0, points);
+
+                    start = end;
+                    ++segment;
+                }
+
+                if (!currentContext->isCanceled()) {
+                    currentContext->deliver(currentChunkIndex, points);
+                }
+            }
+
+        private:
+            /**
+             * Method that calculates the X value at the start of an initial segment.
+             *
+             * \param[in] segment The zero based segment index.
+             *
+             * \return Returns the X value at the start of the segment.
+             */
+            double segmentStart(unsigned segment) const {
+                double result;
+
+                if (segment >= currentNumberSegments) {
+                    result = currentMaximum;
+                } else {
+                    result = currentMinimum + (currentMaximum - currentMinimum) * segment / currentNumberSegments;
+                }
+
+                return result;
+            }
+
+            /**
+             * Method that evaluates the function.
+             *
+             * \param[in] x The X value.
+             *
+             * \return Returns the resulting point.
+             */
+            QPointF evaluate(double x) const {
+                return QPointF(x, currentFunction(x));
+            }
+
+            /**
+             * Method that appends a point, dropping points where the function is undefined.
+             *
+             * \param[in,out] points The points to append to.
+             *
+             * \param[in]     point  The point to be appended.
+             */
+            static void append(QPolygonF& points, const QPointF& point) {
+                if (std::isfinite(point.y())) {
+                    points.append(point);
+                }
+            }
+
+            /**
+             * Method that recursively subdivides a segment.  Every point after the start of the segment is appended.
+             *
+             * \param[in]     start  The start of the segment.
+             *
+             * \param[in]     end    The end of the segment.
+             *
+             * \param[in]     depth  The current subdivision depth.
+             *
+             * \param[in,out] points The points to append to.
+             */
+            void refine(const QPointF& start, const QPointF& end, unsigned depth, QPolygonF& points) const {
+                QPointF middle = evaluate(0.5 * (start.x() + end.x()));
+
+                if (depth < currentMaximumDepth           &&
+                    needsRefinement(start, middle, end)   &&
+                    !currentContext->isCanceled()            ) {
+                    refine(start, middle, depth + 1, points);
+                    refine(middle, end, depth + 1, points);
+                } else {
+                    append(points, middle);
+                    append(points, end);
+                }
+            }
+
+            /**
+             * Method that determines if a segment should be subdivided.
+             *
+             * \param[in] start  The start of the segment.
+             *
+             * \param[in] middle The midpoint of the segment.
+             *
+             * \param[in] end    The end of the segment.
+             *
+             * \return Returns true if the segment bends too sharply or crosses the edge of the defined region.
+             */
+            bool needsRefinement(const QPointF& start, const QPointF& middle, const QPointF& end) const {
+                bool result;
+
+                bool startIsFinite  = std::isfinite(start.y());
+                bool middleIsFinite = std::isfinite(middle.y());
+                bool endIsFinite    = std::isfinite(end.y());
+
+                if (!startIsFinite || !middleIsFinite || !endIsFinite) {
+                    // Close in on the edge of the region where the function is defined.
+                    result = startIsFinite || middleIsFinite || endIsFinite;
+                } else {
+                    double dx1 = (middle.x() - start.x()) * currentXScale;
+                    double dy1 = (middle.y() - start.y()) * currentYScale;
+                    double dx2 = (end.x() - middle.x()) * currentXScale;
+                    double dy2 = (end.y() - middle.y()) * currentYScale;
+
+                    double length1 = std::sqrt(dx1 * dx1 + dy1 * dy1);
+                    double length2 = std::sqrt(dx2 * dx2 + dy2 * dy2);
+
+                    if (length1 + length2 < minimumSegmentLength || length1 == 0 || length2 == 0) {
+                        result = false;
+                    } else {
+                        double cosine = (dx1 * dx2 + dy1 * dy2) / (length1 * length2);
+                        result = cosine < minimumCosine;
+                    }
+                }
+
+                return result;
+            }
+
+            /**
+             * Segments shorter than this, in pixels, are never subdivided.
+             */
+            static constexpr double minimumSegmentLength = 0.5;
+
+            QSharedPointer<Context> currentContext;
+            Function                currentFunction;
+            unsigned                currentChunkIndex;
+            double                  currentMinimum;
+            double                  currentMaximum;
+            unsigned                currentNumberSegments;
+            unsigned                currentFirstSegment;
+            unsigned                currentEndSegment;
+            double                  currentXScale;
+            double                  currentYScale;
+            unsigned                currentMaximumDepth;
+            double                  minimumCosine;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::ChartFunctionSampler
+ */
+
+namespace EQt {
+    const unsigned ChartFunctionSampler::defaultInitialNumberSamples   = 512;
+    const unsigned ChartFunctionSampler::defaultMaximumRefinementDepth = 10;
+    const double   ChartFunctionSampler::defaultMaximumAngle           = 2.0;
+
+    ChartFunctionSampler::ChartFunctionSampler(QXYSeries* series, QObject* parent):QObject(parent) {
+        currentSeries                     = series;
+        currentThreadPool                 = Q_NULLPTR;
+        currentInitialNumberSamples       = defaultInitialNumberSamples;
+        currentMaximumRefinementDepth     = defaultMaximumRefinementDepth;
+        currentMaximumAngle               = defaultMaximumAngle;
+        currentAutomaticResamplingEnabled = false;
+        currentGeneration                 = 0;
+        numberOutstandingChunks           = 0;
+    }
+
+
+    ChartFunctionSampler::~ChartFunctionSampler() {
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+        }
+    }
+
+
+    QXYSeries* ChartFunctionSampler::series() const {
+        return currentSeries.data();
+    }
+
+
+    void ChartFunctionSampler::setThreadPool(QThreadPool* newThreadPool) {
+        currentThreadPool = newThreadPool;
+    }
+
+
+    QThreadPool* ChartFunctionSampler::threadPool() const {
+        return currentThreadPool != Q_NULLPTR ? currentThreadPool : QThreadPool::globalInstance();
+    }
+
+
+    void ChartFunctionSampler::setInitialNumberSamples(unsigned newInitialNumberSamples) {
+        currentInitialNumberSamples = newInitialNumberSamples;
+    }
+
+
+    unsigned ChartFunctionSampler::initialNumberSamples() const {
+        return currentInitialNumberSamples;
+    }
+
+
+    void ChartFunctionSampler::setMaximumRefinementDepth(unsigned newMaximumRefinementDepth) {
+        currentMaximumRefinementDepth = newMaximumRefinementDepth;
+    }
+
+
+    unsigned ChartFunctionSampler::maximumRefinementDepth() const {
+        return currentMaximumRefinementDepth;
+    }
+
+
+    void ChartFunctionSampler::setMaximumAngle(double newMaximumAngle) {
+        currentMaximumAngle = newMaximumAngle;
+    }
+
+
+    double ChartFunctionSampler::maximumAngle() const {
+        return currentMaximumAngle;
+    }
+
+
+    void ChartFunctionSampler::setAutomaticResamplingEnabled(bool nowEnabled) {
+        currentAutomaticResamplingEnabled = nowEnabled;
+        if (nowEnabled) {
+            attach();
+        }
+    }
+
+
+    bool ChartFunctionSampler::automaticResamplingEnabled() const {
+        return currentAutomaticResamplingEnabled;
+    }
+
+
+    bool ChartFunctionSampler::isActive() const {
+        return !currentContext.isNull();
+    }
+
+
+    void ChartFunctionSampler::sample(const ChartFunctionSampler::Function& function, double minimum, double maximum) {
+        cancel();
+
+        if (!currentSeries.isNull() && function) {
+            attach();
+
+            currentFunction = function;
+            ++currentGeneration;
+            currentContext = QSharedPointer<Context>(new Context(this, currentGeneration));
+
+            // Determine the plot scale so bends are measured in pixels rather than in data units.
+
+            QChart* chart    = currentSeries->chart();
+            QRectF  plotArea = chart != Q_NULLPTR ? chart->plotArea() : QRectF();
+            double  xScale   = plotArea.width() > 0 && maximum > minimum ? plotArea.width() / (maximum - minimum) : 1;
+            double  yScale   = xScale;
+
+            QList<QAbstractAxis*> axes = currentSeries->attachedAxes();
+            for (QList<QAbstractAxis*>::const_iterator it=axes.constBegin(),end=axes.constEnd() ; it!=end ; ++it) {
+                QValueAxis* axis = qobject_cast<QValueAxis*>(*it);
+                if (axis != Q_NULLPTR && axis->orientation() == Qt::Vertical && axis->max() > axis->min()) {
+                    if (plotArea.height() > 0) {
+                        yScale = plotArea.height() / (axis->max() - axis->min());
+                    }
+                }
+            }
+
+            QThreadPool* pool           = threadPool();
+            unsigned     numberSegments = std::max(1U, currentInitialNumberSamples - 1);
+            unsigned     numberChunks   = std::min(
+                numberSegments,
+                4 * static_cast<unsigned>(std::max(1, pool->maxThreadCount()))
+            );
+
+            sampledChunks.clear();
+            sampledChunks.resize(static_cast<int>(numberChunks));
+            numberOutstandingChunks = numberChunks;
+
+            for (unsigned chunkIndex=0 ; chunkIndex<numberChunks ; ++chunkIndex) {
+                pool->start(
+                    new ChunkSampler(
+                        currentContext,
+                        function,
+                        chunkIndex,
+                        minimum,
+                        maximum,
+                        numberSegments,
+                        chunkIndex * numberSegments / numberChunks,
+                        (chunkIndex + 1) * numberSegments / numberChunks,
+                        xScale,
+                        yScale,
+                        currentMaximumAngle,
+                        currentMaximumRefinementDepth
+                    )
+                );
+            }
+        }
+    }
+
+
+    void ChartFunctionSampler::cancel() {
+        if (!currentContext.isNull()) {
+            currentContext->cancel();
+            currentContext.reset();
+            sampledChunks.clear();
+
+            emit finished(false);
+        }
+    }
+
+
+    void ChartFunctionSampler::chunkSampled(unsigned generation, unsigned chunkIndex, const QPolygonF& points) {
+        if (!currentContext.isNull() && generation == currentGeneration) {
+            sampledChunks[static_cast<int>(chunkIndex)] = points;
+            --numberOutstandingChunks;
+
+            if (numberOutstandingChunks == 0) {
+                int numberPoints = 0;
+                for (  QVector<QPolygonF>::const_iterator chunkIterator    = sampledChunks.constBegin(),
+                                                          chunkEndIterator = sampledChunks.constEnd()
+                     ; chunkIterator != chunkEndIterator
+                     ; ++chunkIterator
+                    ) {
+                    numberPoints += chunkIterator->size();
+                }
+
+                QPolygonF allPoints;
+                allPoints.reserve(numberPoints);
+
+                for (  QVector<QPolygonF>::const_iterator chunkIterator    = sampledChunks.constBegin(),
+                                                          chunkEndIterator = sampledChunks.constEnd()
+                     ; chunkIterator != chunkEndIterator
+                     ; ++chunkIterator
+                    ) {
+                    allPoints += *chunkIterator;
+                }
+
+                currentContext.reset();
+                sampledChunks.clear();
+
+                if (!currentSeries.isNull()) {
+                    currentSeries->replace(allPoints);
+                }
+
+                emit finished(true);
+            }
+        }
+    }
+
+
+    void ChartFunctionSampler::axisRangeChanged(qreal minimum, qreal maximum) {
+        if (currentAutomaticResamplingEnabled && currentFunction) {
+            sample(currentFunction, minimum, maximum);
+        }
+    }
+
+
+    void ChartFunctionSampler::attach() {
+        if (currentAxis.isNull() && !currentSeries.isNull()) {
+            QList<QAbstractAxis*> axes = currentSeries->attachedAxes();
+
+            QList<QAbstractAxis*>::const_iterator axisIterator    = axes.constBegin();
+            QList<QAbstractAxis*>::const_iterator axisEndIterator = axes.constEnd();
+            while (currentAxis.isNull() && axisIterator != axisEndIterator) {
+                QAbstractAxis* axis = *axisIterator;
+                if (axis->orientation() == Qt::Horizontal) {
+                    QValueAxis* valueAxis = qobject_cast<QValueAxis*>(axis);
+                    if (valueAxis != Q_NULLPTR) {
+                        currentAxis = valueAxis;
+                        connect(
+                            valueAxis,
+                            SIGNAL(rangeChanged(qreal,qreal)),
+                            this,
+                            SLOT(axisRangeChanged(qreal,qreal))
+                        );
+                    }
+                }
+
+                ++axisIterator;
+            }
+        }
+    }
+}
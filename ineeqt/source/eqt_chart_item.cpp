@@ -31,18 +31,28 @@
 
 #include "eqt_charts.h"
 #include "eqt_graphics_item.h"
+#include "eqt_graphics_raster_cache_effect.h"
 #include "eqt_chart_item.h"
 
 namespace EQt {
-    ChartItem::ChartItem(QGraphicsItem* parent, Qt::WindowFlags windowFlags):QChart(parent, windowFlags) {}
+    ChartItem::ChartItem(QGraphicsItem* parent, Qt::WindowFlags windowFlags):QChart(parent, windowFlags) {
+        currentGeometryIsPending = false;
+    }
 
 
     ChartItem::~ChartItem() {}
 
 
     void ChartItem::setGeometry(const QRectF& rectangle) {
-        currentEnforcedBoundingRectangle = rectangle;
-        QChart::setGeometry(rectangle);
+        if (deferringUpdates()) {
+            currentPendingGeometry   = rectangle;
+            currentGeometryIsPending = true;
+
+            requestUpdate();
+        } else {
+            currentEnforcedBoundingRectangle = rectangle;
+            QChart::setGeometry(rectangle);
+        }
     }
 
 
@@ -60,4 +70,55 @@ namespace EQt {
         prepareGeometryChange();
         removeGraphicsItemFromScene(this);
     }
+
+
+    void ChartItem::setRasterCacheEnabled(bool nowEnabled) {
+        if (nowEnabled && currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect = new GraphicsRasterCacheEffect;
+            setGraphicsEffect(currentRasterCacheEffect.data());
+        } else if (!nowEnabled && !currentRasterCacheEffect.isNull()) {
+            setGraphicsEffect(Q_NULLPTR);
+        }
+    }
+
+
+    void ChartItem::setRasterCacheDisabled(bool nowDisabled) {
+        setRasterCacheEnabled(!nowDisabled);
+    }
+
+
+    bool ChartItem::rasterCacheEnabled() const {
+        return !currentRasterCacheEffect.isNull();
+    }
+
+
+    bool ChartItem::rasterCacheDisabled() const {
+        return currentRasterCacheEffect.isNull();
+    }
+
+
+    void ChartItem::beginInteraction() {
+        if (!currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect->beginInteraction();
+        }
+    }
+
+
+    void ChartItem::endInteraction() {
+        if (!currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect->endInteraction();
+        }
+    }
+
+
+    void ChartItem::applyDeferredUpdates() {
+        if (currentGeometryIsPending) {
+            currentGeometryIsPending         = false;
+            currentEnforcedBoundingRectangle = currentPendingGeometry;
+
+            QChart::setGeometry(currentPendingGeometry);
+        }
+
+        GraphicsItem::applyDeferredUpdates();
+    }
 }
@@ -0,0 +1,510 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::ChartSeriesDecimator class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+#include "eqt_charts.h"
+#include "eqt_chart_series_decimator.h"
+
+namespace EQt {
+    /**
+     * Comparison function used to locate the first point at or after an X value.
+     *
+     * \param[in] point The point to be compared.
+     *
+     * \param[in] x     The X value to compare against.
+     *
+     * \return Returns true if the point lies before the X value.
+     */
+    static bool pointPrecedesX(const QPointF& point, double x) {
+        return point.x() < x;
+    }
+
+    /**
+     * Comparison function used to locate the first point after an X value.
+     *
+     * \param[in] x     The X value to compare against.
+     *
+     * \param[in] point The point to be compared.
+     *
+     * \return Returns true if the X value lies before the point.
+     */
+    static bool xPrecedesPoint(double x, const QPointF& point) {
+        return x < point.x();
+    }
+
+    /**
+     * Function that determines the min/max bucket holding an X value.
+     *
+     * \param[in] x             The X value.
+     *
+     * \param[in] minimumX      The X value at the start of the first bucket.
+     *
+     * \param[in] scale         The number of buckets per unit of X.
+     *
+     * \param[in] numberBuckets The number of buckets.
+     *
+     * \return Returns the zero based bucket index.
+     */
+    static unsigned bucketContaining(double x, double minimumX, double scale, unsigned numberBuckets) {
+        return std::min(numberBuckets - 1, static_cast<unsigned>((x - minimumX) * scale));
+    }
+
+    /**
+     * Function that appends a point unless it is the point appended last.
+     *
+     * \param[in]     result       The reduced points.
+     *
+     * \param[in]     point        The point to be appended.
+     *
+     * \param[in,out] lastAppended The point appended last.  Updated when the point is appended.
+     */
+    static void appendPoint(QVector<QPointF>& result, const QPointF* point, const QPointF*& lastAppended) {
+        if (point != lastAppended) {
+            result.append(*point);
+            lastAppended = point;
+        }
+    }
+
+    /**
+     * Function that appends the minimum and maximum points of a bucket in the order they occur.
+     *
+     * \param[in]     result       The reduced points.
+     *
+     * \param[in]     minimum      The point with the smallest Y value.
+     *
+     * \param[in]     maximum      The point with the largest Y value.
+     *
+     * \param[in,out] lastAppended The point appended last.
+     */
+    static void appendExtremes(
+            QVector<QPointF>& result,
+            const QPointF*    minimum,
+            const QPointF*    maximum,
+            const QPointF*&   lastAppended
+        ) {
+        if (minimum < maximum) {
+            appendPoint(result, minimum, lastAppended);
+            appendPoint(result, maximum, lastAppended);
+        } else {
+            appendPoint(result, maximum, lastAppended);
+            appendPoint(result, minimum, lastAppended);
+        }
+    }
+
+    /**
+     * Function that appends the minimum and maximum points of a range of points.
+     *
+     * \param[in]     result       The reduced points.
+     *
+     * \param[in]     begin        Pointer to the first point in the range.
+     *
+     * \param[in]     end          Pointer past the last point in the range.
+     *
+     * \param[in,out] lastAppended The point appended last.
+     */
+    static void appendRangeExtremes(
+            QVector<QPointF>& result,
+            const QPointF*    begin,
+            const QPointF*    end,
+            const QPointF*&   lastAppended
+        ) {
+        if (begin < end) {
+            const QPointF* minimum = begin;
+            const QPointF* maximum = begin;
+
+            for (const QPointF* point=begin+1 ; point<end ; ++point) {
+                if (point->y() < minimum->y()) {
+                    minimum = point;
+                } else if (point->y() > maximum->y()) {
+                    maximum = point;
+                }
+            }
+
+            appendExtremes(result, minimum, maximum, lastAppended);
+        }
+    }
+
+    const double ChartSeriesDecimator::defaultPointsPerPixel = 2.0;
+
+    ChartSeriesDecimator::ChartSeriesDecimator(QXYSeries* series, QObject* parent):QObject(parent) {
+        currentSeries         = series;
+        currentMethod         = Method::MIN_MAX;
+        currentPointsPerPixel = defaultPointsPerPixel;
+    }
+
+
+    ChartSeriesDecimator::~ChartSeriesDecimator() {}
+
+
+    QXYSeries* ChartSeriesDecimator::series() const {
+        return currentSeries.data();
+    }
+
+
+    void ChartSeriesDecimator::setMethod(ChartSeriesDecimator::Method newMethod) {
+        currentMethod = newMethod;
+        updateView();
+    }
+
+
+    ChartSeriesDecimator::Method ChartSeriesDecimator::method() const {
+        return currentMethod;
+    }
+
+
+    void ChartSeriesDecimator::setPointsPerPixel(double newPointsPerPixel) {
+        currentPointsPerPixel = newPointsPerPixel;
+        updateView();
+    }
+
+
+    double ChartSeriesDecimator::pointsPerPixel() const {
+        return currentPointsPerPixel;
+    }
+
+
+    void ChartSeriesDecimator::setData(const QVector<QPointF>& newData) {
+        currentData = newData;
+        buildPyramid();
+        updateView();
+    }
+
+
+    void ChartSeriesDecimator::setData(QVector<QPointF>&& newData) {
+        currentData = std::move(newData);
+        buildPyramid();
+        updateView();
+    }
+
+
+    const QVector<QPointF>& ChartSeriesDecimator::data() const {
+        return currentData;
+    }
+
+
+    QVector<QPointF> ChartSeriesDecimator::minMaxDecimate(
+            const QPointF* begin,
+            const QPointF* end,
+            unsigned       numberBuckets
+        ) {
+        QVector<QPointF> result;
+
+        if (begin < end && numberBuckets > 0) {
+            result.reserve(2 * numberBuckets + 2);
+
+            double minimumX = begin->x();
+            double spanX    = (end - 1)->x() - minimumX;
+            double scale    = spanX > 0 ? numberBuckets / spanX : 0;
+
+            // The end points are always kept so the reduced line spans the same range as the original data.
+
+            const QPointF* lastAppended = Q_NULLPTR;
+            appendPoint(result, begin, lastAppended);
+
+            const QPointF* point = begin;
+            while (point != end) {
+                unsigned       bucket  = bucketContaining(point->x(), minimumX, scale, numberBuckets);
+                const QPointF* minimum = point;
+                const QPointF* maximum = point;
+
+                ++point;
+                while (point != end && bucketContaining(point->x(), minimumX, scale, numberBuckets) == bucket) {
+                    if (point->y() < minimum->y()) {
+                        minimum = point;
+                    } else if (point->y() > maximum->y()) {
+                        maximum = point;
+                    }
+
+                    ++point;
+                }
+
+                appendExtremes(result, minimum, maximum, lastAppended);
+            }
+
+            appendPoint(result, end - 1, lastAppended);
+        }
+
+        return result;
+    }
+
+
+    QVector<QPointF> ChartSeriesDecimator::lttbDecimate(
+            const QPointF* begin,
+            const QPointF* end,
+            unsigned       numberPoints
+        ) {
+        QVector<QPointF> result;
+        long long        numberInputPoints = end - begin;
+
+        if (numberInputPoints <= static_cast<long long>(numberPoints) || numberPoints < 3) {
+            result.resize(static_cast<int>(numberInputPoints));
+            std::copy(begin, end, result.begin());
+        } else {
+            result.reserve(numberPoints);
+            result.append(*begin);
+
+            // Each bucket contributes the point that forms the largest triangle with the previously selected point
+            // and the average of the next bucket.
+
+            double    bucketSize    = static_cast<double>(numberInputPoints - 2) / (numberPoints - 2);
+            long long selectedIndex = 0;
+
+            for (unsigned bucketIndex=0 ; bucketIndex<numberPoints-2 ; ++bucketIndex) {
+                long long averageStart = static_cast<long long>(std::floor((bucketIndex + 1) * bucketSize)) + 1;
+                long long averageEnd   = std::min(
+                    static_cast<long long>(std::floor((bucketIndex + 2) * bucketSize)) + 1,
+                    numberInputPoints
+                );
+
+                double averageX = 0;
+                double averageY = 0;
+                for (long long i=averageStart ; i<averageEnd ; ++i) {
+                    averageX += begin[i].x();
+                    averageY += begin[i].y();
+                }
+
+                if (averageEnd > averageStart) {
+                    averageX /= (averageEnd - averageStart);
+                    averageY /= (averageEnd - averageStart);
+                }
+
+                long long bucketStart = static_cast<long long>(std::floor(bucketIndex * bucketSize)) + 1;
+                long long bucketEnd   = static_cast<long long>(std::floor((bucketIndex + 1) * bucketSize)) + 1;
+
+                const QPointF& selected     = begin[selectedIndex];
+                double         largestArea  = -1;
+                long long      largestIndex = bucketStart;
+
+                for (long long i=bucketStart ; i<bucketEnd ; ++i) {
+                    double area = std::abs(
+                          (selected.x() - averageX) * (begin[i].y() - selected.y())
+                        - (selected.x() - begin[i].x()) * (averageY - selected.y())
+                    );
+
+                    if (area > largestArea) {
+                        largestArea  = area;
+                        largestIndex = i;
+                    }
+                }
+
+                result.append(begin[largestIndex]);
+                selectedIndex = largestIndex;
+            }
+
+            result.append(*(end - 1));
+        }
+
+        return result;
+    }
+
+
+    void ChartSeriesDecimator::updateView() {
+        if (!currentSeries.isNull()) {
+            attach();
+
+            const QPointF* begin = currentData.constData();
+            const QPointF* end   = begin + currentData.size();
+
+            if (!currentAxis.isNull() && begin != end) {
+                // Keep one point beyond each edge of the axis range so lines run to the edge of the plot.
+
+                const QPointF* first = std::lower_bound(begin, end, currentAxis->min(), pointPrecedesX);
+                const QPointF* last  = std::upper_bound(first, end, currentAxis->max(), xPrecedesPoint);
+
+                begin = first != begin ? first - 1 : first;
+                end   = last != end ? last + 1 : last;
+            }
+
+            double   plotWidth    = currentChart.isNull() ? 0 : currentChart->plotArea().width();
+            unsigned targetPoints = static_cast<unsigned>(std::max(3.0, std::ceil(plotWidth * currentPointsPerPixel)));
+
+            QVector<QPointF> view;
+            if (end - begin <= static_cast<long long>(targetPoints) || plotWidth <= 0) {
+                view.resize(static_cast<int>(end - begin));
+                std::copy(begin, end, view.begin());
+            } else if (currentMethod == Method::MIN_MAX) {
+                view = pyramidDecimate(begin, end, std::max(1U, targetPoints / 2));
+            } else {
+                view = lttbDecimate(begin, end, targetPoints);
+            }
+
+            currentSeries->replace(view);
+        }
+    }
+
+
+    void ChartSeriesDecimator::axisRangeChanged(qreal, qreal) {
+        updateView();
+    }
+
+
+    void ChartSeriesDecimator::plotAreaChanged(const QRectF&) {
+        updateView();
+    }
+
+
+    void ChartSeriesDecimator::attach() {
+        if (currentChart.isNull() && currentSeries->chart() != Q_NULLPTR) {
+            currentChart = currentSeries->chart();
+            connect(currentChart.data(), SIGNAL(plotAreaChanged(QRectF)), this, SLOT(plotAreaChanged(QRectF)));
+        }
+
+        if (currentAxis.isNull()) {
+            QList<QAbstractAxis*> axes = currentSeries->attachedAxes();
+
+            QList<QAbstractAxis*>::const_iterator axisIterator    = axes.constBegin();
+            QList<QAbstractAxis*>::const_iterator axisEndIterator = axes.constEnd();
+            while (currentAxis.isNull() && axisIterator != axisEndIterator) {
+                QAbstractAxis* axis = *axisIterator;
+                if (axis->orientation() == Qt::Horizontal) {
+                    QValueAxis* valueAxis = qobject_cast<QValueAxis*>(axis);
+                    if (valueAxis != Q_NULLPTR) {
+                        currentAxis = valueAxis;
+                        connect(
+                            valueAxis,
+                            SIGNAL(rangeChanged(qreal,qreal)),
+                            this,
+                            SLOT(axisRangeChanged(qreal,qreal))
+                        );
+                    }
+                }
+
+                ++axisIterator;
+            }
+        }
+    }
+
+
+    void ChartSeriesDecimator::buildPyramid() {
+        currentPyramid.clear();
+
+        const QPointF* points        = currentData.constData();
+        unsigned       numberBuckets = static_cast<unsigned>(currentData.size()) / 2;
+
+        // Each level is built from the level below so the whole pyramid costs O(n).  Ties keep the earlier point,
+        // matching minMaxDecimate.
+
+        while (numberBuckets > 0) {
+            QVector<unsigned> level(static_cast<int>(2 * numberBuckets));
+
+            if (currentPyramid.isEmpty()) {
+                for (unsigned bucket=0 ; bucket<numberBuckets ; ++bucket) {
+                    unsigned left  = 2 * bucket;
+                    unsigned right = left + 1;
+
+                    level[2 * bucket]     = points[right].y() < points[left].y() ? right : left;
+                    level[2 * bucket + 1] = points[right].y() > points[left].y() ? right : left;
+                }
+            } else {
+                const QVector<unsigned> below = currentPyramid.last();
+                for (unsigned bucket=0 ; bucket<numberBuckets ; ++bucket) {
+                    unsigned leftMinimum  = below.at(4 * bucket);
+                    unsigned leftMaximum  = below.at(4 * bucket + 1);
+                    unsigned rightMinimum = below.at(4 * bucket + 2);
+                    unsigned rightMaximum = below.at(4 * bucket + 3);
+
+                    level[2 * bucket] =   points[rightMinimum].y() < points[leftMinimum].y()
+                                        ? rightMinimum
+                                        : leftMinimum;
+                    level[2 * bucket + 1] =   points[rightMaximum].y() > points[leftMaximum].y()
+                                            ? rightMaximum
+                                            : leftMaximum;
+                }
+            }
+
+            currentPyramid.append(level);
+            numberBuckets /= 2;
+        }
+    }
+
+
+    QVector<QPointF> ChartSeriesDecimator::pyramidDecimate(
+            const QPointF* begin,
+            const QPointF* end,
+            unsigned       numberBuckets
+        ) const {
+        QVector<QPointF> result;
+
+        const QPointF* points       = currentData.constData();
+        unsigned       firstIndex   = static_cast<unsigned>(begin - points);
+        unsigned       endIndex     = static_cast<unsigned>(end - points);
+        unsigned       numberPoints = endIndex - firstIndex;
+
+        // Use the finest level that yields no more than the desired number of buckets.
+
+        unsigned level = 0;
+        while (level < static_cast<unsigned>(currentPyramid.size()) && (numberPoints >> level) > numberBuckets) {
+            ++level;
+        }
+
+        unsigned firstBucket = 0;
+        unsigned endBucket   = 0;
+        if (level > 0) {
+            firstBucket = (firstIndex + (1U << level) - 1) >> level;
+            endBucket   = endIndex >> level;
+        }
+
+        if (firstBucket >= endBucket) {
+            result = minMaxDecimate(begin, end, numberBuckets);
+        } else {
+            const QVector<unsigned>& buckets      = currentPyramid.at(level - 1);
+            const QPointF*           lastAppended = Q_NULLPTR;
+
+            result.reserve(2 * (endBucket - firstBucket) + 6);
+
+            // Partial buckets at either edge of the range are scanned directly.  They hold fewer points than a
+            // bucket so the cost remains proportional to the number of buckets.
+
+            appendPoint(result, begin, lastAppended);
+            appendRangeExtremes(result, begin, points + (firstBucket << level), lastAppended);
+
+            for (unsigned bucket=firstBucket ; bucket<endBucket ; ++bucket) {
+                appendExtremes(
+                    result,
+                    points + buckets.at(2 * bucket),
+                    points + buckets.at(2 * bucket + 1),
+                    lastAppended
+                );
+            }
+
+            appendRangeExtremes(result, points + (endBucket << level), end, lastAppended);
+            appendPoint(result, end - 1, lastAppended);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,372 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::ChartStreamingSeries class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+
+#include "eqt_charts.h"
+#include "eqt_chart_series_decimator.h"
+#include "eqt_chart_streaming_series.h"
+
+namespace EQt {
+    const unsigned ChartStreamingSeries::defaultFrameInterval = 33;
+
+    ChartStreamingSeries::ChartStreamingSeries(
+            QXYSeries* series,
+            unsigned   capacity,
+            QObject*   parent
+        ):QObject(
+            parent
+        ) {
+        currentSeries         = series;
+        currentHead           = 0;
+        currentNumberSamples  = 0;
+        currentScrollPolicy   = ScrollPolicy::FOLLOW_NEWEST;
+        currentFrameIsPending = false;
+        publishingFrame       = false;
+
+        currentBuffer.resize(static_cast<int>(std::max(1U, capacity)));
+
+        frameTimer = new QTimer(this);
+        frameTimer->setSingleShot(true);
+        frameTimer->setInterval(static_cast<int>(defaultFrameInterval));
+
+        connect(frameTimer, SIGNAL(timeout()), this, SLOT(frameTimeout()));
+
+        if (!currentSeries.isNull()) {
+            attach();
+        }
+    }
+
+
+    ChartStreamingSeries::~ChartStreamingSeries() {}
+
+
+    QXYSeries* ChartStreamingSeries::series() const {
+        return currentSeries.data();
+    }
+
+
+    void ChartStreamingSeries::setCapacity(unsigned newCapacity) {
+        newCapacity = std::max(1U, newCapacity);
+
+        if (newCapacity != capacity()) {
+            unsigned         numberRetained = std::min(newCapacity, currentNumberSamples);
+            unsigned         firstRetained  = currentNumberSamples - numberRetained;
+            QVector<QPointF> newBuffer(static_cast<int>(newCapacity));
+
+            for (unsigned i=0 ; i<numberRetained ; ++i) {
+                newBuffer[i] = at(firstRetained + i);
+            }
+
+            currentBuffer.swap(newBuffer);
+            currentHead          = 0;
+            currentNumberSamples = numberRetained;
+
+            scheduleFrame();
+        }
+    }
+
+
+    unsigned ChartStreamingSeries::capacity() const {
+        return static_cast<unsigned>(currentBuffer.size());
+    }
+
+
+    unsigned ChartStreamingSeries::numberSamples() const {
+        return currentNumberSamples;
+    }
+
+
+    const QPointF& ChartStreamingSeries::at(unsigned index) const {
+        return currentBuffer.at((currentHead + index) % capacity());
+    }
+
+
+    void ChartStreamingSeries::setScrollPolicy(ChartStreamingSeries::ScrollPolicy newScrollPolicy) {
+        currentScrollPolicy = newScrollPolicy;
+    }
+
+
+    ChartStreamingSeries::ScrollPolicy ChartStreamingSeries::scrollPolicy() const {
+        return currentScrollPolicy;
+    }
+
+
+    void ChartStreamingSeries::setFrameInterval(unsigned newFrameInterval) {
+        frameTimer->setInterval(static_cast<int>(newFrameInterval));
+    }
+
+
+    unsigned ChartStreamingSeries::frameInterval() const {
+        return static_cast<unsigned>(frameTimer->interval());
+    }
+
+
+    void ChartStreamingSeries::append(const QPointF& sample) {
+        unsigned bufferCapacity = capacity();
+
+        if (currentNumberSamples < bufferCapacity) {
+            currentBuffer[(currentHead + currentNumberSamples) % bufferCapacity] = sample;
+            ++currentNumberSamples;
+        } else {
+            currentBuffer[currentHead] = sample;
+            currentHead = (currentHead + 1) % bufferCapacity;
+        }
+
+        scheduleFrame();
+    }
+
+
+    void ChartStreamingSeries::append(double x, double y) {
+        append(QPointF(x, y));
+    }
+
+
+    void ChartStreamingSeries::append(const QVector<QPointF>& samples) {
+        for (  QVector<QPointF>::const_iterator sampleIterator    = samples.constBegin(),
+                                                sampleEndIterator = samples.constEnd()
+             ; sampleIterator != sampleEndIterator
+             ; ++sampleIterator
+            ) {
+            append(*sampleIterator);
+        }
+    }
+
+
+    void ChartStreamingSeries::clear() {
+        currentHead          = 0;
+        currentNumberSamples = 0;
+
+        scheduleFrame();
+    }
+
+
+    void ChartStreamingSeries::flush() {
+        frameTimer->stop();
+        frameTimeout();
+    }
+
+
+    void ChartStreamingSeries::frameTimeout() {
+        // The series may have been added to a chart or attached to an axis since the last frame.
+
+        if (!currentSeries.isNull()) {
+            attach();
+        }
+
+        if (currentFrameIsPending && !currentSeries.isNull()) {
+            currentFrameIsPending = false;
+            publishingFrame       = true;
+
+            // The axis is scrolled first so the visible range used below is the range the frame will be drawn in.
+
+            QValueAxis* axis = currentAxis.data();
+            if (axis != Q_NULLPTR && currentScrollPolicy != ScrollPolicy::NONE && currentNumberSamples > 0) {
+                double newestX = at(currentNumberSamples - 1).x();
+
+                if (currentScrollPolicy == ScrollPolicy::FOLLOW_NEWEST) {
+                    double span = axis->max() - axis->min();
+                    if (newestX > axis->max()) {
+                        axis->setRange(newestX - span, newestX);
+                    }
+                } else {
+                    double oldestX = at(0).x();
+                    if (newestX > oldestX) {
+                        axis->setRange(oldestX, newestX);
+                    }
+                }
+            }
+
+            // Only the samples within the axis range are published, keeping one sample beyond each edge so lines
+            // run to the edge of the plot.  Samples are sorted so the range is located by binary search.
+
+            unsigned firstIndex = 0;
+            unsigned endIndex   = currentNumberSamples;
+            if (axis != Q_NULLPTR && currentNumberSamples > 0) {
+                firstIndex = firstSampleAtOrAfter(axis->min());
+                endIndex   = firstSampleAfter(axis->max());
+
+                if (firstIndex > 0) {
+                    --firstIndex;
+                }
+
+                if (endIndex < currentNumberSamples) {
+                    ++endIndex;
+                }
+
+                endIndex = std::max(firstIndex, endIndex);
+            }
+
+            // The visible slice of the ring is presented in order using a retained scratch buffer.  The samples held
+            // by the ring are never moved.
+
+            unsigned bufferCapacity = capacity();
+            unsigned numberVisible  = endIndex - firstIndex;
+            unsigned sliceStart     = (currentHead + firstIndex) % bufferCapacity;
+            unsigned firstLength    = std::min(numberVisible, bufferCapacity - sliceStart);
+
+            publishBuffer.resize(static_cast<int>(numberVisible));
+            std::copy(
+                currentBuffer.constBegin() + sliceStart,
+                currentBuffer.constBegin() + sliceStart + firstLength,
+                publishBuffer.begin()
+            );
+            std::copy(
+                currentBuffer.constBegin(),
+                currentBuffer.constBegin() + (numberVisible - firstLength),
+                publishBuffer.begin() + firstLength
+            );
+
+            double   plotWidth     = currentChart.isNull() ? 0 : currentChart->plotArea().width();
+            unsigned maximumPoints = static_cast<unsigned>(
+                std::ceil(plotWidth * ChartSeriesDecimator::defaultPointsPerPixel)
+            );
+
+            if (maximumPoints > 0 && numberVisible > maximumPoints) {
+                const QPointF* begin = publishBuffer.constData();
+                currentSeries->replace(
+                    ChartSeriesDecimator::minMaxDecimate(begin, begin + numberVisible, maximumPoints / 2)
+                );
+            } else {
+                currentSeries->replace(publishBuffer);
+            }
+
+            publishingFrame = false;
+        }
+    }
+
+
+    void ChartStreamingSeries::axisRangeChanged(qreal, qreal) {
+        if (!publishingFrame) {
+            scheduleFrame();
+        }
+    }
+
+
+    void ChartStreamingSeries::plotAreaChanged(const QRectF&) {
+        scheduleFrame();
+    }
+
+
+    void ChartStreamingSeries::scheduleFrame() {
+        currentFrameIsPending = true;
+
+        if (!frameTimer->isActive()) {
+            frameTimer->start();
+        }
+    }
+
+
+    void ChartStreamingSeries::attach() {
+        QChart* chart = currentSeries->chart();
+        if (chart != currentChart.data()) {
+            if (!currentChart.isNull()) {
+                disconnect(currentChart.data(), Q_NULLPTR, this, Q_NULLPTR);
+            }
+
+            currentChart = chart;
+
+            if (chart != Q_NULLPTR) {
+                connect(chart, SIGNAL(plotAreaChanged(QRectF)), this, SLOT(plotAreaChanged(QRectF)));
+            }
+        }
+
+        QValueAxis* axis = horizontalAxis();
+        if (axis != currentAxis.data()) {
+            if (!currentAxis.isNull()) {
+                disconnect(currentAxis.data(), Q_NULLPTR, this, Q_NULLPTR);
+            }
+
+            currentAxis = axis;
+
+            if (axis != Q_NULLPTR) {
+                connect(axis, SIGNAL(rangeChanged(qreal,qreal)), this, SLOT(axisRangeChanged(qreal,qreal)));
+            }
+        }
+    }
+
+
+    QValueAxis* ChartStreamingSeries::horizontalAxis() const {
+        QValueAxis*           result = Q_NULLPTR;
+        QList<QAbstractAxis*> axes   = currentSeries->attachedAxes();
+
+        QList<QAbstractAxis*>::const_iterator axisIterator    = axes.constBegin();
+        QList<QAbstractAxis*>::const_iterator axisEndIterator = axes.constEnd();
+        while (result == Q_NULLPTR && axisIterator != axisEndIterator) {
+            if ((*axisIterator)->orientation() == Qt::Horizontal) {
+                result = qobject_cast<QValueAxis*>(*axisIterator);
+            }
+
+            ++axisIterator;
+        }
+
+        return result;
+    }
+
+
+    unsigned ChartStreamingSeries::firstSampleAtOrAfter(double x) const {
+        unsigned low  = 0;
+        unsigned high = currentNumberSamples;
+
+        while (low < high) {
+            unsigned middle = low + (high - low) / 2;
+            if (at(middle).x() < x) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        return low;
+    }
+
+
+    unsigned ChartStreamingSeries::firstSampleAfter(double x) const {
+        unsigned low  = 0;
+        unsigned high = currentNumberSamples;
+
+        while (low < high) {
+            unsigned middle = low + (high - low) / 2;
+            if (at(middle).x() <= x) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        return low;
+    }
+}
@@ -27,14 +27,32 @@
 
 #include <QWidget>
 #include <QString>
+#include <QList>
+#include <QVector>
+#include <QSharedPointer>
 #include <QPlainTextEdit>
 #include <QResizeEvent>
 #include <QTextOption>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QScrollBar>
+#include <QTimer>
 
+#include <algorithm>
+
+#include "eqt_syntax_rule_set.h"
+#include "eqt_syntax_highlighter.h"
+#include "eqt_background_syntax_highlighter.h"
 #include "eqt_code_editor_line_number_area.h"
 #include "eqt_code_editor.h"
+#include "code_editor_file_index.h"
 
 namespace EQt {
+    const unsigned CodeEditor::linesPerChunk           = 2000;
+    const unsigned CodeEditor::virtualWindowLines      = 3000;
+    const unsigned CodeEditor::linesPerStateCheckpoint = 1000;
+
     CodeEditor::CodeEditor(QWidget* parent):QPlainTextEdit(parent) {
         configureWidget();
     }
@@ -94,9 +112,337 @@ namespace EQt {
     }
 
 
+    bool CodeEditor::loadLargeFile(const QString& filename, CodeEditor::LargeFileMode mode) {
+        closeLargeFile();
+
+        CodeEditorFileIndex* fileIndex = new CodeEditorFileIndex(this);
+        bool                 success   = fileIndex->open(filename);
+
+        if (success) {
+            wasReadOnly        = isReadOnly();
+            wasUndoRedoEnabled = isUndoRedoEnabled();
+
+            clear();
+            setUndoRedoEnabled(false);
+            setReadOnly(true);
+
+            currentFileIndex       = fileIndex;
+            currentLargeFileIsOpen = true;
+            currentlyLoading       = true;
+            nextChunkLine          = 0;
+            windowFirstLine        = 0;
+            windowNumberLines      = 0;
+            currentLargeFileMode   = (
+                  mode == LargeFileMode::VIRTUALIZED
+                ? LargeFileMode::VIRTUALIZED
+                : LargeFileMode::CHUNKED
+            );
+
+            if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+                virtualScrollBar = new QScrollBar(Qt::Vertical, this);
+                connect(virtualScrollBar, SIGNAL(valueChanged(int)), this, SLOT(virtualScrollBarMoved(int)));
+
+                setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+                updateViewportMargins();
+                updateSideWidgetGeometry();
+                updateVirtualScrollBar();
+
+                virtualScrollBar->show();
+
+                stateCheckpoints.clear();
+                stateCheckpoints.append(-1);
+                checkpointTimer->start();
+            }
+
+            connect(fileIndex, SIGNAL(progress(qint64,qint64)), this, SLOT(fileIndexProgress(qint64,qint64)));
+            connect(fileIndex, SIGNAL(finished()), this, SLOT(fileIndexFinished()));
+        } else {
+            delete fileIndex;
+        }
+
+        return success;
+    }
+
+
+    CodeEditor::LargeFileMode CodeEditor::largeFileMode() const {
+        return currentLargeFileMode;
+    }
+
+
+    bool CodeEditor::largeFileIsLoading() const {
+        return currentlyLoading;
+    }
+
+
+    unsigned long CodeEditor::lineCount() const {
+        unsigned long result;
+
+        if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            result = std::max(currentFileIndex->lineCount(), 1UL);
+        } else {
+            result = static_cast<unsigned long>(blockCount());
+        }
+
+        return result;
+    }
+
+
+    unsigned long CodeEditor::firstLineNumber() const {
+        return currentLargeFileMode == LargeFileMode::VIRTUALIZED ? windowFirstLine : 0;
+    }
+
+
+    void CodeEditor::setSyntaxRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet) {
+        currentRuleSet = newRuleSet;
+
+        if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            stateCheckpoints.clear();
+            stateCheckpoints.append(-1);
+
+            checkpointTimer->start();
+            updateWindowInitialState();
+        }
+    }
+
+
+    QSharedPointer<const SyntaxRuleSet> CodeEditor::syntaxRuleSet() const {
+        return currentRuleSet;
+    }
+
+
+    void CodeEditor::cancelLargeFileLoad() {
+        if (currentlyLoading) {
+            endLargeFileLoad(false);
+        }
+    }
+
+
+    void CodeEditor::closeLargeFile() {
+        if (currentLargeFileIsOpen) {
+            if (currentlyLoading) {
+                endLargeFileLoad(false);
+            }
+
+            if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+                currentLargeFileMode = LargeFileMode::DISABLED;
+
+                currentFileIndex->deleteLater();
+                currentFileIndex = Q_NULLPTR;
+
+                delete virtualScrollBar;
+                virtualScrollBar = Q_NULLPTR;
+
+                windowFirstLine   = 0;
+                windowNumberLines = 0;
+
+                checkpointTimer->stop();
+                stateCheckpoints.clear();
+
+                setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+                setReadOnly(wasReadOnly);
+                setUndoRedoEnabled(wasUndoRedoEnabled);
+                updateViewportMargins();
+            }
+
+            currentLargeFileIsOpen = false;
+
+            clear();
+            applyInitialBlockState(-1);
+        }
+    }
+
+
     void CodeEditor::resizeEvent(QResizeEvent* event) {
         QPlainTextEdit::resizeEvent(event);
 
+        updateSideWidgetGeometry();
+        updateVirtualScrollBar();
+    }
+
+
+    void CodeEditor::fileIndexProgress(qint64 bytesIndexed, qint64 totalBytes) {
+        if (currentLargeFileMode == LargeFileMode::CHUNKED) {
+            if (!chunkTimer->isActive()) {
+                chunkTimer->start();
+            }
+        } else if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            if (windowNumberLines < virtualWindowLines                                &&
+                windowFirstLine + windowNumberLines < currentFileIndex->lineCount()    ) {
+                materializeWindow(windowFirstLine);
+            } else if (currentLineNumberArea != Q_NULLPTR) {
+                currentLineNumberArea->blockCountChanged(blockCount());
+            }
+
+            updateVirtualScrollBar();
+
+            if (!checkpointTimer->isActive()) {
+                checkpointTimer->start();
+            }
+
+            emit largeFileLoadProgress(bytesIndexed, totalBytes);
+        }
+    }
+
+
+    void CodeEditor::fileIndexFinished() {
+        if (currentLargeFileMode == LargeFileMode::CHUNKED) {
+            if (!chunkTimer->isActive()) {
+                chunkTimer->start();
+            }
+        } else if (currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            if (!checkpointTimer->isActive()) {
+                checkpointTimer->start();
+            }
+
+            endLargeFileLoad(true);
+        }
+    }
+
+
+    void CodeEditor::insertNextChunk() {
+        if (currentLargeFileMode == LargeFileMode::CHUNKED) {
+            unsigned long numberAvailable = currentFileIndex->lineCount();
+            if (nextChunkLine < numberAvailable) {
+                unsigned long numberLines = std::min(
+                    static_cast<unsigned long>(linesPerChunk),
+                    numberAvailable - nextChunkLine
+                );
+
+                // Each chunk is appended using a separate cursor so the user's cursor and scroll position are not
+                // disturbed.  Undo is disabled while loading so the inserted text is not duplicated on the undo
+                // stack.
+
+                QTextCursor cursor(document());
+                cursor.movePosition(QTextCursor::End);
+                cursor.beginEditBlock();
+
+                if (nextChunkLine > 0) {
+                    cursor.insertBlock();
+                }
+
+                cursor.insertText(currentFileIndex->lines(nextChunkLine, numberLines));
+                cursor.endEditBlock();
+
+                nextChunkLine += numberLines;
+                emit largeFileLoadProgress(currentFileIndex->lineOffset(nextChunkLine), currentFileIndex->fileSize());
+            }
+
+            if (nextChunkLine < currentFileIndex->lineCount()) {
+                chunkTimer->start();
+            } else if (currentFileIndex->isComplete()) {
+                endLargeFileLoad(true);
+            }
+        }
+    }
+
+
+    void CodeEditor::virtualScrollBarMoved(int newValue) {
+        if (!synchronizingScrollBars && currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            unsigned long topLine   = static_cast<unsigned long>(newValue);
+            unsigned long pageLines = static_cast<unsigned long>(verticalScrollBar()->pageStep());
+
+            if (topLine < windowFirstLine || topLine + pageLines > windowFirstLine + windowNumberLines) {
+                unsigned long lead = (virtualWindowLines - std::min(pageLines, windowNumberLines)) / 2;
+                materializeWindow(topLine > lead ? topLine - lead : 0);
+            }
+
+            synchronizingScrollBars = true;
+            verticalScrollBar()->setValue(static_cast<int>(topLine - windowFirstLine));
+            synchronizingScrollBars = false;
+        }
+    }
+
+
+    void CodeEditor::documentScrolled(int newValue) {
+        if (!synchronizingScrollBars && currentLargeFileMode == LargeFileMode::VIRTUALIZED) {
+            unsigned long value     = static_cast<unsigned long>(newValue);
+            unsigned long topLine   = windowFirstLine + value;
+            unsigned long pageLines = static_cast<unsigned long>(verticalScrollBar()->pageStep());
+            unsigned long margin    = virtualWindowLines / 6;
+
+            // Refill the window before the view reaches either end so that scrolling by keyboard or wheel continues
+            // smoothly into lines that are not held in the document.
+
+            bool nearTop    = windowFirstLine > 0 && value < margin;
+            bool nearBottom = (
+                   windowFirstLine + windowNumberLines < currentFileIndex->lineCount()
+                && value + pageLines + margin > windowNumberLines
+            );
+
+            if (nearTop || nearBottom) {
+                unsigned long lead = (virtualWindowLines - std::min(pageLines, windowNumberLines)) / 2;
+                materializeWindow(topLine > lead ? topLine - lead : 0);
+            }
+
+            synchronizingScrollBars = true;
+            virtualScrollBar->setValue(static_cast<int>(topLine));
+            synchronizingScrollBars = false;
+        }
+    }
+
+
+    void CodeEditor::scanNextCheckpoint() {
+        if (currentLargeFileMode == LargeFileMode::VIRTUALIZED && !currentRuleSet.isNull()) {
+            unsigned long numberCheckpoints = static_cast<unsigned long>(stateCheckpoints.size());
+            unsigned long firstLine         = (numberCheckpoints - 1) * linesPerStateCheckpoint;
+
+            // The pass stops at the end of the indexed lines and is restarted as the index grows.
+
+            if (firstLine + linesPerStateCheckpoint <= currentFileIndex->lineCount()) {
+                QString text = currentFileIndex->lines(firstLine, linesPerStateCheckpoint);
+                stateCheckpoints.append(scanLines(*currentRuleSet, text, stateCheckpoints.last()));
+
+                if (!windowStateIsExact && windowFirstLine / linesPerStateCheckpoint <= numberCheckpoints) {
+                    updateWindowInitialState();
+                }
+
+                checkpointTimer->start();
+            }
+        }
+    }
+
+
+    void CodeEditor::configureWidget() {
+        currentLineNumberArea   = Q_NULLPTR;
+        currentLargeFileMode    = LargeFileMode::DISABLED;
+        currentLargeFileIsOpen  = false;
+        currentFileIndex        = Q_NULLPTR;
+        currentlyLoading        = false;
+        wasReadOnly             = false;
+        wasUndoRedoEnabled      = true;
+        nextChunkLine           = 0;
+        virtualScrollBar        = Q_NULLPTR;
+        windowFirstLine         = 0;
+        windowNumberLines       = 0;
+        synchronizingScrollBars = false;
+        windowStateIsExact      = true;
+
+        chunkTimer = new QTimer(this);
+        chunkTimer->setSingleShot(true);
+        chunkTimer->setInterval(0);
+
+        checkpointTimer = new QTimer(this);
+        checkpointTimer->setSingleShot(true);
+        checkpointTimer->setInterval(0);
+
+        connect(chunkTimer, SIGNAL(timeout()), this, SLOT(insertNextChunk()));
+        connect(checkpointTimer, SIGNAL(timeout()), this, SLOT(scanNextCheckpoint()));
+        connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(documentScrolled(int)));
+
+        setLineWrapMode(QPlainTextEdit::NoWrap);
+        setWordWrapMode(QTextOption::NoWrap);
+    }
+
+
+    void CodeEditor::updateViewportMargins() {
+        int leftMargin  = currentLineNumberArea != Q_NULLPTR ? currentLineNumberArea->sizeHint().width() : 0;
+        int rightMargin = virtualScrollBar != Q_NULLPTR ? virtualScrollBar->sizeHint().width() : 0;
+
+        setViewportMargins(leftMargin, 0, rightMargin, 0);
+    }
+
+
+    void CodeEditor::updateSideWidgetGeometry() {
         if (currentLineNumberArea != Q_NULLPTR) {
             QRect contentsRectangle  = CodeEditor::contentsRect();
             QSize lineNumberAreaSize = currentLineNumberArea->sizeHint();
@@ -107,13 +453,167 @@ namespace EQt {
                 contentsRectangle.height()
             );
         }
+
+        if (virtualScrollBar != Q_NULLPTR) {
+            QRect viewportRectangle = viewport()->geometry();
+            virtualScrollBar->setGeometry(
+                viewportRectangle.right() + 1,
+                viewportRectangle.top(),
+                virtualScrollBar->sizeHint().width(),
+                viewportRectangle.height()
+            );
+        }
     }
 
 
-    void CodeEditor::configureWidget() {
-        currentLineNumberArea = Q_NULLPTR;
+    void CodeEditor::updateVirtualScrollBar() {
+        if (virtualScrollBar != Q_NULLPTR) {
+            unsigned long numberLines = lineCount();
+            unsigned long pageLines   = static_cast<unsigned long>(std::max(verticalScrollBar()->pageStep(), 1));
+            unsigned long maximum     = numberLines > pageLines ? numberLines - pageLines : 0;
 
-        setLineWrapMode(QPlainTextEdit::NoWrap);
-        setWordWrapMode(QTextOption::NoWrap);
+            synchronizingScrollBars = true;
+            virtualScrollBar->setRange(0, static_cast<int>(maximum));
+            virtualScrollBar->setPageStep(static_cast<int>(pageLines));
+            virtualScrollBar->setSingleStep(1);
+            virtualScrollBar->setValue(static_cast<int>(windowFirstLine + verticalScrollBar()->value()));
+            synchronizingScrollBars = false;
+        }
+    }
+
+
+    void CodeEditor::materializeWindow(unsigned long firstLine) {
+        unsigned long numberLines = currentFileIndex->lineCount();
+
+        QTextCursor   cursor       = textCursor();
+        unsigned long topLine      = windowFirstLine + static_cast<unsigned long>(verticalScrollBar()->value());
+        unsigned long cursorLine   = windowFirstLine + static_cast<unsigned long>(cursor.blockNumber());
+        int           cursorColumn = cursor.positionInBlock();
+
+        if (firstLine + virtualWindowLines > numberLines) {
+            firstLine = numberLines > virtualWindowLines ? numberLines - virtualWindowLines : 0;
+        }
+
+        windowFirstLine   = firstLine;
+        windowNumberLines = std::min(static_cast<unsigned long>(virtualWindowLines), numberLines - firstLine);
+
+        synchronizingScrollBars = true;
+
+        setPlainText(currentFileIndex->lines(windowFirstLine, windowNumberLines));
+        updateWindowInitialState();
+
+        if (cursorLine >= windowFirstLine && cursorLine < windowFirstLine + windowNumberLines) {
+            QTextBlock block = document()->findBlockByNumber(static_cast<int>(cursorLine - windowFirstLine));
+            cursor = QTextCursor(block);
+            cursor.movePosition(
+                QTextCursor::Right,
+                QTextCursor::MoveAnchor,
+                std::min(cursorColumn, block.length() - 1)
+            );
+
+            setTextCursor(cursor);
+        }
+
+        verticalScrollBar()->setValue(topLine > windowFirstLine ? static_cast<int>(topLine - windowFirstLine) : 0);
+
+        synchronizingScrollBars = false;
+
+        if (currentLineNumberArea != Q_NULLPTR) {
+            currentLineNumberArea->blockCountChanged(blockCount());
+            currentLineNumberArea->update();
+        }
+    }
+
+
+    void CodeEditor::updateWindowInitialState() {
+        int initialState = -1;
+
+        windowStateIsExact = true;
+
+        if (!currentRuleSet.isNull() && windowFirstLine > 0) {
+            unsigned long checkpoint = windowFirstLine / linesPerStateCheckpoint;
+            if (checkpoint < static_cast<unsigned long>(stateCheckpoints.size())) {
+                unsigned long checkpointLine = checkpoint * linesPerStateCheckpoint;
+
+                initialState = stateCheckpoints.at(static_cast<int>(checkpoint));
+                if (checkpointLine < windowFirstLine) {
+                    QString text = currentFileIndex->lines(checkpointLine, windowFirstLine - checkpointLine);
+                    initialState = scanLines(*currentRuleSet, text, initialState);
+                }
+            } else {
+                windowStateIsExact = false;
+            }
+        }
+
+        applyInitialBlockState(initialState);
+    }
+
+
+    void CodeEditor::applyInitialBlockState(int initialState) {
+        QList<SyntaxHighlighter*> highlighters = document()->findChildren<SyntaxHighlighter*>(
+            QString(),
+            Qt::FindDirectChildrenOnly
+        );
+
+        for (  QList<SyntaxHighlighter*>::const_iterator highlighterIterator    = highlighters.constBegin(),
+                                                         highlighterEndIterator = highlighters.constEnd()
+             ; highlighterIterator != highlighterEndIterator
+             ; ++highlighterIterator
+            ) {
+            (*highlighterIterator)->setInitialBlockState(initialState);
+        }
+
+        QList<BackgroundSyntaxHighlighter*> backgroundHighlighters = findChildren<BackgroundSyntaxHighlighter*>(
+            QString(),
+            Qt::FindDirectChildrenOnly
+        );
+
+        for (  QList<BackgroundSyntaxHighlighter*>::const_iterator
+                   highlighterIterator    = backgroundHighlighters.constBegin(),
+                   highlighterEndIterator = backgroundHighlighters.constEnd()
+             ; highlighterIterator != highlighterEndIterator
+             ; ++highlighterIterator
+            ) {
+            (*highlighterIterator)->setInitialBlockState(initialState);
+        }
+    }
+
+
+    int CodeEditor::scanLines(const SyntaxRuleSet& ruleSet, const QString& text, int state) {
+        SyntaxRuleSet::FormatRanges formatRanges;
+
+        int textLength = text.size();
+        int lineStart  = 0;
+        while (lineStart <= textLength) {
+            int lineEnd = text.indexOf(QChar('\n'), lineStart);
+            if (lineEnd < 0) {
+                lineEnd = textLength;
+            }
+
+            state     = ruleSet.highlightBlock(text.mid(lineStart, lineEnd - lineStart), state, formatRanges);
+            lineStart = lineEnd + 1;
+        }
+
+        return state;
+    }
+
+
+    void CodeEditor::endLargeFileLoad(bool success) {
+        currentlyLoading = false;
+        chunkTimer->stop();
+
+        currentFileIndex->cancel();
+
+        if (currentLargeFileMode == LargeFileMode::CHUNKED) {
+            currentLargeFileMode = LargeFileMode::DISABLED;
+
+            currentFileIndex->deleteLater();
+            currentFileIndex = Q_NULLPTR;
+
+            setReadOnly(wasReadOnly);
+            setUndoRedoEnabled(wasUndoRedoEnabled);
+        }
+
+        emit largeFileLoaded(success);
     }
 }
@@ -29,12 +29,16 @@
 #include <QColor>
 #include <QFont>
 #include <QFontMetrics>
+#include <QFontMetricsF>
 #include <QSize>
 #include <QRect>
 #include <QPaintEvent>
 #include <QPalette>
 #include <QPainter>
 #include <QTextBlock>
+#include <QStaticText>
+#include <QTransform>
+#include <QAbstractTextDocumentLayout>
 
 #include <cmath>
 
@@ -56,6 +60,7 @@ namespace EQt {
         currentRequiredWidth        = 0;
         currentLineNumberHeight     = QFontMetrics(currentFont).height();
 
+        updateDigitGlyphs();
         setForegroundRole(QPalette::Text);
     }
 
@@ -127,7 +132,9 @@ namespace EQt {
         if (currentFont != newFont) {
             currentFont             = newFont;
             currentLineNumberHeight = QFontMetrics(currentFont).height();
+            updateDigitGlyphs();
             updateWidth();
+            update();
         }
     }
 
@@ -161,11 +168,18 @@ namespace EQt {
 
 
     void CodeEditorLineNumberArea::blockCountChanged(int newBlockCount) {
+        // When the editor is displaying a window onto a large file, the digits are sized for the entire file.
+        double numberLines = (
+              currentEditor != Q_NULLPTR
+            ? static_cast<double>(currentEditor->lineCount())
+            : static_cast<double>(newBlockCount)
+        );
+
         unsigned newNumberRequiredDigits;
-        if (newBlockCount <= 9) {
+        if (numberLines <= 9) {
             newNumberRequiredDigits = 1;
         } else {
-            newNumberRequiredDigits = std::ceil(std::log10(newBlockCount));
+            newNumberRequiredDigits = std::ceil(std::log10(numberLines));
         }
 
         if (newNumberRequiredDigits != currentNumberRequiredDigits) {
@@ -183,7 +197,7 @@ namespace EQt {
         }
 
         if (currentEditor != Q_NULLPTR && rectangle.contains(currentEditor->viewport()->rect())) {
-            currentEditor->setViewportMargins(currentRequiredWidth, 0, 0, 0);
+            currentEditor->updateViewportMargins();
         }
     }
 
@@ -260,35 +274,46 @@ namespace EQt {
 
             painter.fillRect(event->rect(), backgroundColor);
 
-            QPen            pen(textColor);
-            painter.setPen(pen);
-
-            int         areaTop        = event->rect().top();
-            int         areaBottom     = event->rect().bottom();
-            QTextBlock  block          = currentEditor->firstVisibleBlock();
-            long        blockNumber    = block.blockNumber();
-            QRect       blockRectangle = blockBoundingGeometry(block).toRect();
-            int         top            = blockRectangle.top();
-            int         bottom         = top + static_cast<int>(blockBoundingRectangle(block).height());
-
-            while (block.isValid() && top <= areaBottom) {
-                if (block.isVisible() && bottom >= areaTop) {
-                    QString lineNumber = QString::number(blockNumber + 1);
-                    painter.drawText(
-                        currentLeftPadding,
-                        top,
-                        currentRequiredWidth - currentRightPadding - currentLeftPadding,
-                        currentLineNumberHeight,
-                        Qt::AlignRight,
-                        lineNumber
-                    );
-                }
+            if (currentDisplayLineNumbers) {
+                painter.setPen(textColor);
+                painter.setFont(currentFont);
+
+                // The first visible block is positioned once, subsequent blocks are stacked using the heights reported
+                // by the document layout.  This keeps the cost proportional to the number of visible lines.
+
+                const QAbstractTextDocumentLayout* layout = currentEditor->document()->documentLayout();
+
+                int        areaTop     = event->rect().top();
+                int        areaBottom  = event->rect().bottom();
+                qreal      right       = static_cast<qreal>(currentRequiredWidth) - currentRightPadding;
+                QTextBlock block       = currentEditor->firstVisibleBlock();
+                long       blockNumber = block.blockNumber() + static_cast<long>(currentEditor->firstLineNumber());
+                qreal      top         = (
+                      currentEditor->blockBoundingGeometry(block).top()
+                    + currentEditor->contentOffset().y()
+                );
+
+                while (block.isValid() && top <= areaBottom) {
+                    qreal bottom = top + layout->blockBoundingRect(block).height();
+
+                    if (block.isVisible() && bottom >= areaTop) {
+                        unsigned long lineNumber = static_cast<unsigned long>(blockNumber + 1);
+                        qreal         x          = right;
+
+                        do {
+                            unsigned digit = static_cast<unsigned>(lineNumber % 10);
+                            x -= currentDigitAdvances[digit];
+                            painter.drawStaticText(QPointF(x, top), currentDigitGlyphs[digit]);
+
+                            lineNumber /= 10;
+                        } while (lineNumber != 0);
+                    }
 
-                block  = block.next();
-                top    = bottom;
-                bottom = top + static_cast<int>(blockBoundingRectangle(block).height());
+                    block = block.next();
+                    top   = bottom;
 
-                ++blockNumber;
+                    ++blockNumber;
+                }
             }
         }
     }
@@ -301,8 +326,26 @@ namespace EQt {
             updateGeometry();
 
             if (currentEditor != Q_NULLPTR) {
-                currentEditor->setViewportMargins(currentRequiredWidth, 0, 0, 0);
+                currentEditor->updateViewportMargins();
             }
         }
     }
+
+
+    void CodeEditorLineNumberArea::updateDigitGlyphs() {
+        QFontMetricsF fontMetrics(currentFont);
+        QTransform    identity;
+
+        for (unsigned digit=0 ; digit<10 ; ++digit) {
+            QChar digitCharacter(static_cast<ushort>('0' + digit));
+
+            QStaticText& glyph = currentDigitGlyphs[digit];
+            glyph.setText(QString(digitCharacter));
+            glyph.setTextFormat(Qt::PlainText);
+            glyph.setPerformanceHint(QStaticText::AggressiveCaching);
+            glyph.prepare(identity, currentFont);
+
+            currentDigitAdvances[digit] = fontMetrics.horizontalAdvance(digitCharacter);
+        }
+    }
 }
@@ -0,0 +1,1112 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::CodeEditorSearchEngine class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QLatin1Char>
+#include <QVector>
+#include <QList>
+#include <QPoint>
+#include <QColor>
+#include <QTimer>
+#include <QAction>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QRegularExpressionMatchIterator>
+#include <QTextCharFormat>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextEdit>
+#include <QScrollBar>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "eqt_code_editor.h"
+#include "eqt_search_line_edit.h"
+#include "eqt_code_editor_search_engine.h"
+
+/***********************************************************************************************************************
+ * EQt::CodeEditorSearchEngine::Batch
+ */
+
+namespace EQt {
+    /**
+     * Class that holds the matches found in a run of consecutive blocks.
+     */
+    class CodeEditorSearchEngine::Batch {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] firstBlock The first block in the batch.
+             *
+             * \param[in] preview    If true, the batch holds visible blocks searched ahead of the in-order pass.
+             */
+            Batch(int firstBlock = 0, bool preview = false) {
+                startBlock = firstBlock;
+                isPreview  = preview;
+                isFinal    = false;
+            }
+
+            /**
+             * The first block in the batch.
+             */
+            int startBlock;
+
+            /**
+             * Flag indicating that the batch holds visible blocks searched ahead of the in-order pass.
+             */
+            bool isPreview;
+
+            /**
+             * Flag indicating that this is the last batch of the scan.
+             */
+            bool isFinal;
+
+            /**
+             * The matches found in each block.
+             */
+            QVector<QVector<Match>> blockMatches;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::CodeEditorSearchEngine::Context
+ */
+
+namespace EQt {
+    /**
+     * Class that holds state shared between the engine and the worker thread.  Batches are queued here and the engine
+     * is told when the queue becomes non-empty.
+     */
+    class CodeEditorSearchEngine::Context {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] engine The engine that should receive batches.
+             */
+            Context(CodeEditorSearchEngine* engine) {
+                currentEngine = engine;
+            }
+
+            /**
+             * Method that is called by the worker thread to deliver a batch.  The batch is discarded if the scan was
+             * canceled.
+             *
+             * \param[in] batch The batch to deliver.
+             */
+            void deliver(const Batch& batch) {
+                QMutexLocker locker(&mutex);
+                if (currentEngine != Q_NULLPTR && !isCanceled()) {
+                    bool notify = pendingBatches.isEmpty();
+                    pendingBatches.append(batch);
+
+                    if (notify) {
+                        QMetaObject::invokeMethod(currentEngine, "batchesReady", Qt::QueuedConnection);
+                    }
+                }
+            }
+
+            /**
+             * Method that is called by the engine to obtain the queued batches.
+             *
+             * \return Returns the queued batches, oldest first.
+             */
+            QList<Batch> takeBatches() {
+                QMutexLocker locker(&mutex);
+
+                QList<Batch> result;
+                result.swap(pendingBatches);
+
+                return result;
+            }
+
+            /**
+             * Method that is called to detach the engine from this context.
+             */
+            void detach() {
+                QMutexLocker locker(&mutex);
+                currentEngine = Q_NULLPTR;
+                canceled.storeRelease(1);
+                pendingBatches.clear();
+            }
+
+            /**
+             * Method that is called to determine if outstanding work has been canceled.
+             *
+             * \return Returns true if outstanding work has been canceled.
+             */
+            bool isCanceled() const {
+                return canceled.loadAcquire() != 0;
+            }
+
+        private:
+            /**
+             * Mutex used to guard the engine pointer and the batch queue.
+             */
+            QMutex mutex;
+
+            /**
+             * The engine to receive batches.
+             */
+            CodeEditorSearchEngine* currentEngine;
+
+            /**
+             * Batches waiting to be applied.
+             */
+            QList<Batch> pendingBatches;
+
+            /**
+             * Flag indicating that outstanding work has been canceled.
+             */
+            QAtomicInt canceled;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::CodeEditorSearchEngine::Scanner
+ */
+
+namespace EQt {
+    /**
+     * Runnable that searches a snapshot of the document.
+     */
+    class CodeEditorSearchEngine::Scanner:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] context           The shared context used to deliver batches.
+             *
+             * \param[in] texts             Snapshot of the block texts.
+             *
+             * \param[in] searchText        The search string.
+             *
+             * \param[in] caseSensitivity   The case sensitivity used for literal searches.
+             *
+             * \param[in] wholeWordsOnly    If true, literal searches only match whole words.
+             *
+             * \param[in] regularExpression If true, the expression is used rather than the search string.
+             *
+             * \param[in] expression        The compiled search expression.
+             *
+             * \param[in] firstBlock        The first block to be searched.
+             *
+             * \param[in] lastBlock         The last block to be searched.
+             *
+             * \param[in] visibleFirst      The first visible block, or -1 if unknown.
+             *
+             * \param[in] visibleLast       The last visible block, or -1 if unknown.
+             */
+            Scanner(
+                    QSharedPointer<Context>   context,
+                    const QVector<QString>&   texts,
+                    const QString&            searchText,
+                    Qt::CaseSensitivity       caseSensitivity,
+                    bool                      wholeWordsOnly,
+                    bool                      regularExpression,
+                    const QRegularExpression& expression,
+                    int                       firstBlock,
+                    int                       lastBlock,
+                    int                       visibleFirst,
+                    int                       visibleLast
+                ):currentContext(
+                    context
+                ),currentTexts(
+                    texts
+                ),currentSearchText(
+                    searchText
+                ),currentCaseSensitivity(
+                    caseSensitivity
+                ),currentWholeWordsOnly(
+                    wholeWordsOnly
+                ),currentRegularExpression(
+                    regularExpression
+                ),currentExpression(
+                    expression
+                ),currentFirstBlock(
+                    firstBlock
+                ),currentLastBlock(
+                    lastBlock
+                ),currentVisibleFirst(
+                    visibleFirst
+                ),currentVisibleLast(
+                    visibleLast
+                ) {}
+
+            /**
+             * Method that performs the scan.  Visible blocks are searched first so they can be highlighted
+             * immediately.  The remaining blocks are then searched in order.
+             */
+            void run() override {
+                int previewFirst = std::max(currentVisibleFirst, currentFirstBlock);
+                int previewLast  = std::min(currentVisibleLast, currentLastBlock);
+
+                if (currentVisibleFirst >= 0 && previewFirst <= previewLast) {
+                    scanRange(previewFirst, previewLast, true);
+                    scanRange(currentFirstBlock, previewFirst - 1, false);
+                    scanRange(previewLast + 1, currentLastBlock, false);
+                } else {
+                    scanRange(currentFirstBlock, currentLastBlock, false);
+                }
+
+                Batch finalBatch(currentLastBlock + 1);
+                finalBatch.isFinal = true;
+                currentContext->deliver(finalBatch);
+            }
+
+        private:
+            /**
+             * Method that searches a range of blocks, delivering the results in batches.
+             *
+             * \param[in] firstBlock The first block to be searched.
+             *
+             * \param[in] lastBlock  The last block to be searched.
+             *
+             * \param[in] preview    If true, the blocks are being searched ahead of the in-order pass.
+             */
+            void scanRange(int firstBlock, int lastBlock, bool preview) {
+                Batch batch(firstBlock, preview);
+
+                int block = firstBlock;
+                while (block <= lastBlock && !currentContext->isCanceled()) {
+                    batch.blockMatches.append(scanBlock(currentTexts.at(block)));
+
+                    ++block;
+                    if (static_cast<unsigned>(batch.blockMatches.size()) >= blocksPerBatch) {
+                        currentContext->deliver(batch);
+                        batch = Batch(block, preview);
+                    }
+                }
+
+                if (!batch.blockMatches.isEmpty()) {
+                    currentContext->deliver(batch);
+                }
+            }
+
+            /**
+             * Method that searches a single block.  Empty matches are ignored.
+             *
+             * \param[in] text The block text.
+             *
+             * \return Returns the matches found in the block.
+             */
+            QVector<Match> scanBlock(const QString& text) const {
+                QVector<Match> result;
+
+                if (currentRegularExpression) {
+                    QRegularExpressionMatchIterator iterator = currentExpression.globalMatch(text);
+                    while (iterator.hasNext()) {
+                        QRegularExpressionMatch match = iterator.next();
+                        if (match.capturedLength() > 0) {
+                            result.append(Match(match.capturedStart(), match.capturedLength()));
+                        }
+                    }
+                } else {
+                    int length   = currentSearchText.length();
+                    int position = text.indexOf(currentSearchText, 0, currentCaseSensitivity);
+                    while (position >= 0) {
+                        int end = position + length;
+                        if (!currentWholeWordsOnly || (isWordBoundary(text, position) && isWordBoundary(text, end))) {
+                            result.append(Match(position, length));
+                            position = text.indexOf(currentSearchText, end, currentCaseSensitivity);
+                        } else {
+                            position = text.indexOf(currentSearchText, position + 1, currentCaseSensitivity);
+                        }
+                    }
+                }
+
+                return result;
+            }
+
+            /**
+             * Method that determines if a position in a block lies on a word boundary.
+             *
+             * \param[in] text     The block text.
+             *
+             * \param[in] position The position to be checked.
+             *
+             * \return Returns true if the characters on either side of the position are not both word characters.
+             */
+            static bool isWordBoundary(const QString& text, int position) {
+                bool before = position > 0 && isWordCharacter(text.at(position - 1));
+                bool after  = position < text.length() && isWordCharacter(text.at(position));
+
+                return !(before && after);
+            }
+
+            /**
+             * Method that determines if a character can be part of a word.
+             *
+             * \param[in] character The character to be checked.
+             *
+             * \return Returns true if the character is a letter, a digit, or an underscore.
+             */
+            static bool isWordCharacter(QChar character) {
+                return character.isLetterOrNumber() || character == QLatin1Char('_');
+            }
+
+            QSharedPointer<Context> currentContext;
+            QVector<QString>        currentTexts;
+            QString                 currentSearchText;
+            Qt::CaseSensitivity     currentCaseSensitivity;
+            bool                    currentWholeWordsOnly;
+            bool                    currentRegularExpression;
+            QRegularExpression      currentExpression;
+            int                     currentFirstBlock;
+            int                     currentLastBlock;
+            int                     currentVisibleFirst;
+            int                     currentVisibleLast;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::CodeEditorSearchEngine
+ */
+
+namespace EQt {
+    const unsigned CodeEditorSearchEngine::blocksPerBatch = 2000;
+
+    CodeEditorSearchEngine::CodeEditorSearchEngine(
+            CodeEditor*     editor,
+            SearchLineEdit* searchLineEdit
+        ):QObject(
+            editor
+        ) {
+        currentEditor            = editor;
+        currentDocument          = editor->document();
+        currentCaseSensitive     = false;
+        currentWholeWordsOnly    = false;
+        currentRegularExpression = false;
+        currentThreadPool        = Q_NULLPTR;
+        currentNumberMatches     = 0;
+        firstDirtyBlock          = -1;
+        lastDirtyBlock           = -1;
+        scanNextBlock            = -1;
+        scanLastBlock            = -1;
+        currentMatchBlock        = -1;
+        currentMatchBlockIndex   = 0;
+        currentMatchesBefore     = 0;
+
+        currentMatchHighlightFormat.setBackground(QColor(255, 240, 120));
+        currentMatchSelectedFormat.setBackground(QColor(255, 170, 60));
+
+        scanTimer = new QTimer(this);
+        scanTimer->setSingleShot(true);
+        scanTimer->setInterval(0);
+
+        selectionTimer = new QTimer(this);
+        selectionTimer->setSingleShot(true);
+        selectionTimer->setInterval(0);
+
+        connect(scanTimer, SIGNAL(timeout()), this, SLOT(startScan()));
+        connect(selectionTimer, SIGNAL(timeout()), this, SLOT(updateVisibleSelections()));
+        connect(editor->verticalScrollBar(), SIGNAL(valueChanged(int)), selectionTimer, SLOT(start()));
+        connect(editor->verticalScrollBar(), SIGNAL(rangeChanged(int,int)), selectionTimer, SLOT(start()));
+        connect(
+            currentDocument.data(),
+            SIGNAL(contentsChange(int,int,int)),
+            this,
+            SLOT(contentsChange(int,int,int))
+        );
+
+        int numberBlocks = currentDocument->blockCount();
+        blockTexts.reserve(numberBlocks);
+        for (QTextBlock block=currentDocument->firstBlock() ; block.isValid() ; block=block.next()) {
+            blockTexts.append(block.text());
+        }
+
+        blockMatches.resize(blockTexts.size());
+
+        setSearchLineEdit(searchLineEdit);
+    }
+
+
+    CodeEditorSearchEngine::~CodeEditorSearchEngine() {
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+        }
+    }
+
+
+    CodeEditor* CodeEditorSearchEngine::editor() const {
+        return currentEditor.data();
+    }
+
+
+    void CodeEditorSearchEngine::setSearchLineEdit(SearchLineEdit* newSearchLineEdit) {
+        if (!currentSearchLineEdit.isNull()) {
+            disconnect(currentSearchLineEdit.data(), Q_NULLPTR, this, Q_NULLPTR);
+
+            QAction* actions[] = {
+                currentSearchLineEdit->caseSensitiveSearchAction(),
+                currentSearchLineEdit->wholeWordsOnlyAction(),
+                currentSearchLineEdit->regularExpressionAction()
+            };
+
+            for (unsigned index=0 ; index<3 ; ++index) {
+                if (actions[index] != Q_NULLPTR) {
+                    disconnect(actions[index], Q_NULLPTR, this, Q_NULLPTR);
+                }
+            }
+        }
+
+        currentSearchLineEdit = newSearchLineEdit;
+
+        if (newSearchLineEdit != Q_NULLPTR) {
+            connect(newSearchLineEdit, SIGNAL(textChanged(const QString&)), this, SLOT(setSearchText(const QString&)));
+            connect(newSearchLineEdit, SIGNAL(returnPressed()), this, SLOT(findNext()));
+
+            QAction* actions[] = {
+                newSearchLineEdit->caseSensitiveSearchAction(),
+                newSearchLineEdit->wholeWordsOnlyAction(),
+                newSearchLineEdit->regularExpressionAction()
+            };
+
+            for (unsigned index=0 ; index<3 ; ++index) {
+                if (actions[index] != Q_NULLPTR) {
+                    connect(actions[index], SIGNAL(toggled(bool)), this, SLOT(searchOptionsChanged()));
+                }
+            }
+
+            QString newSearchText = newSearchLineEdit->text();
+            if (newSearchText.isEmpty() && !currentSearchText.isEmpty()) {
+                clearVisibleSelections();
+            }
+
+            currentSearchText = newSearchText;
+            searchOptionsChanged();
+        }
+    }
+
+
+    SearchLineEdit* CodeEditorSearchEngine::searchLineEdit() const {
+        return currentSearchLineEdit.data();
+    }
+
+
+    QString CodeEditorSearchEngine::searchText() const {
+        return currentSearchText;
+    }
+
+
+    bool CodeEditorSearchEngine::caseSensitiveSearchEnabled() const {
+        return currentCaseSensitive;
+    }
+
+
+    bool CodeEditorSearchEngine::wholeWordsOnlyEnabled() const {
+        return currentWholeWordsOnly;
+    }
+
+
+    bool CodeEditorSearchEngine::regularExpressionSearchEnabled() const {
+        return currentRegularExpression;
+    }
+
+
+    bool CodeEditorSearchEngine::searchIsValid() const {
+        return !currentRegularExpression || currentExpression.isValid();
+    }
+
+
+    void CodeEditorSearchEngine::setMatchFormat(const QTextCharFormat& newFormat) {
+        currentMatchHighlightFormat = newFormat;
+        selectionTimer->start();
+    }
+
+
+    QTextCharFormat CodeEditorSearchEngine::matchFormat() const {
+        return currentMatchHighlightFormat;
+    }
+
+
+    void CodeEditorSearchEngine::setCurrentMatchFormat(const QTextCharFormat& newFormat) {
+        currentMatchSelectedFormat = newFormat;
+        selectionTimer->start();
+    }
+
+
+    QTextCharFormat CodeEditorSearchEngine::currentMatchFormat() const {
+        return currentMatchSelectedFormat;
+    }
+
+
+    void CodeEditorSearchEngine::setThreadPool(QThreadPool* newThreadPool) {
+        currentThreadPool = newThreadPool;
+    }
+
+
+    QThreadPool* CodeEditorSearchEngine::threadPool() const {
+        return currentThreadPool != Q_NULLPTR ? currentThreadPool : QThreadPool::globalInstance();
+    }
+
+
+    unsigned long CodeEditorSearchEngine::numberMatches() const {
+        return currentNumberMatches;
+    }
+
+
+    long CodeEditorSearchEngine::currentMatchIndex() const {
+        return currentMatchBlock >= 0 ? static_cast<long>(currentMatchesBefore) + currentMatchBlockIndex : -1;
+    }
+
+
+    bool CodeEditorSearchEngine::isIdle() const {
+        return firstDirtyBlock < 0 && currentContext.isNull();
+    }
+
+
+    void CodeEditorSearchEngine::setSearchText(const QString& newSearchText) {
+        if (newSearchText != currentSearchText) {
+            if (newSearchText.isEmpty()) {
+                clearVisibleSelections();
+            }
+
+            currentSearchText = newSearchText;
+            updateSearchExpression();
+            research();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::setCaseSensitiveSearchEnabled(bool nowEnabled) {
+        if (nowEnabled != currentCaseSensitive) {
+            currentCaseSensitive = nowEnabled;
+            updateSearchExpression();
+            research();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::setCaseSensitiveSearchDisabled(bool nowDisabled) {
+        setCaseSensitiveSearchEnabled(!nowDisabled);
+    }
+
+
+    void CodeEditorSearchEngine::setWholeWordsOnlyEnabled(bool nowEnabled) {
+        if (nowEnabled != currentWholeWordsOnly) {
+            currentWholeWordsOnly = nowEnabled;
+            updateSearchExpression();
+            research();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::setWholeWordsOnlyDisabled(bool nowDisabled) {
+        setWholeWordsOnlyEnabled(!nowDisabled);
+    }
+
+
+    void CodeEditorSearchEngine::setRegularExpressionSearchEnabled(bool nowEnabled) {
+        if (nowEnabled != currentRegularExpression) {
+            currentRegularExpression = nowEnabled;
+            updateSearchExpression();
+            research();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::setRegularExpressionSearchDisabled(bool nowDisabled) {
+        setRegularExpressionSearchEnabled(!nowDisabled);
+    }
+
+
+    void CodeEditorSearchEngine::findNext() {
+        if (!currentEditor.isNull() && currentNumberMatches > 0) {
+            int        position   = currentEditor->textCursor().selectionEnd();
+            QTextBlock textBlock  = currentDocument->findBlock(position);
+            int        startBlock = textBlock.isValid() ? textBlock.blockNumber() : 0;
+            int        column     = textBlock.isValid() ? position - textBlock.position() : 0;
+
+            // Blocks are visited starting with the cursor's block and wrapping back around to it, so the cursor's
+            // block is visited twice: first for matches after the cursor, last for matches before it.
+
+            int numberBlocks = blockMatches.size();
+            int foundBlock   = -1;
+            int foundIndex   = 0;
+            int step         = 0;
+            while (foundBlock < 0 && step <= numberBlocks) {
+                int                   block   = (startBlock + step) % numberBlocks;
+                const QVector<Match>& matches = blockMatches.at(block);
+
+                if (step == 0) {
+                    int index = 0;
+                    while (index < matches.size() && matches.at(index).start < column) {
+                        ++index;
+                    }
+
+                    if (index < matches.size()) {
+                        foundBlock = block;
+                        foundIndex = index;
+                    }
+                } else if (!matches.isEmpty()) {
+                    foundBlock = block;
+                    foundIndex = 0;
+                }
+
+                ++step;
+            }
+
+            if (foundBlock >= 0) {
+                selectMatch(foundBlock, foundIndex);
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::findPrevious() {
+        if (!currentEditor.isNull() && currentNumberMatches > 0) {
+            int        position   = currentEditor->textCursor().selectionStart();
+            QTextBlock textBlock  = currentDocument->findBlock(position);
+            int        startBlock = textBlock.isValid() ? textBlock.blockNumber() : 0;
+            int        column     = textBlock.isValid() ? position - textBlock.position() : 0;
+
+            int numberBlocks = blockMatches.size();
+            int foundBlock   = -1;
+            int foundIndex   = 0;
+            int step         = 0;
+            while (foundBlock < 0 && step <= numberBlocks) {
+                int                   block   = (startBlock - step % numberBlocks + numberBlocks) % numberBlocks;
+                const QVector<Match>& matches = blockMatches.at(block);
+
+                if (step == 0) {
+                    int index = matches.size() - 1;
+                    while (index >= 0 && matches.at(index).start >= column) {
+                        --index;
+                    }
+
+                    if (index >= 0) {
+                        foundBlock = block;
+                        foundIndex = index;
+                    }
+                } else if (!matches.isEmpty()) {
+                    foundBlock = block;
+                    foundIndex = matches.size() - 1;
+                }
+
+                ++step;
+            }
+
+            if (foundBlock >= 0) {
+                selectMatch(foundBlock, foundIndex);
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::research() {
+        cancelScan();
+        clearCurrentMatch();
+
+        firstDirtyBlock = -1;
+        lastDirtyBlock  = -1;
+
+        blockMatches.fill(QVector<Match>(), blockTexts.size());
+
+        if (currentNumberMatches != 0) {
+            currentNumberMatches = 0;
+            emit numberMatchesChanged(0);
+        }
+
+        if (!blockTexts.isEmpty()) {
+            markDirty(0, blockTexts.size() - 1);
+        }
+
+        scanTimer->start();
+        selectionTimer->start();
+    }
+
+
+    void CodeEditorSearchEngine::contentsChange(int position, int charsRemoved, int charsAdded) {
+        if (!currentDocument.isNull() && (charsRemoved != 0 || charsAdded != 0)) {
+            cancelScan();
+
+            QTextBlock firstBlock = currentDocument->findBlock(position);
+            QTextBlock lastBlock  = currentDocument->findBlock(position + charsAdded);
+            if (!lastBlock.isValid()) {
+                lastBlock = currentDocument->lastBlock();
+            }
+
+            int first           = firstBlock.isValid() ? firstBlock.blockNumber() : 0;
+            int last            = std::max(first, lastBlock.blockNumber());
+            int numberNewBlocks = last - first + 1;
+            int delta           = currentDocument->blockCount() - blockTexts.size();
+            int numberOldBlocks = numberNewBlocks - delta;
+
+            if (numberOldBlocks < 1 || first + numberOldBlocks > blockTexts.size()) {
+                blockTexts.clear();
+                for (QTextBlock block=currentDocument->firstBlock() ; block.isValid() ; block=block.next()) {
+                    blockTexts.append(block.text());
+                }
+
+                research();
+            } else {
+                unsigned long oldNumberMatches = currentNumberMatches;
+                unsigned long numberRemoved    = 0;
+                for (int index=first ; index<first+numberOldBlocks ; ++index) {
+                    numberRemoved += blockMatches.at(index).size();
+                }
+
+                currentNumberMatches -= numberRemoved;
+
+                if (currentMatchBlock >= first + numberOldBlocks) {
+                    currentMatchBlock    += delta;
+                    currentMatchesBefore -= numberRemoved;
+                } else if (currentMatchBlock >= first) {
+                    clearCurrentMatch();
+                }
+
+                blockTexts.remove(first, numberOldBlocks);
+                blockTexts.insert(first, numberNewBlocks, QString());
+
+                blockMatches.remove(first, numberOldBlocks);
+                blockMatches.insert(first, numberNewBlocks, QVector<Match>());
+
+                QTextBlock block = firstBlock;
+                for (int index=first ; index<=last && block.isValid() ; ++index) {
+                    blockTexts[index] = block.text();
+                    block = block.next();
+                }
+
+                if (firstDirtyBlock >= 0 && lastDirtyBlock >= first) {
+                    lastDirtyBlock = std::max(lastDirtyBlock + delta, first);
+                }
+
+                markDirty(first, last);
+                scanTimer->start();
+                selectionTimer->start();
+
+                if (currentNumberMatches != oldNumberMatches) {
+                    emit numberMatchesChanged(currentNumberMatches);
+                }
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::startScan() {
+        if (!currentDocument.isNull() && firstDirtyBlock >= 0 && currentContext.isNull()) {
+            int numberBlocks = blockTexts.size();
+            int first        = firstDirtyBlock;
+            int last         = std::min(lastDirtyBlock, numberBlocks - 1);
+
+            firstDirtyBlock = -1;
+            lastDirtyBlock  = -1;
+
+            if (first <= last && !currentSearchText.isEmpty() && searchIsValid()) {
+                int visibleFirst = -1;
+                int visibleLast  = -1;
+
+                if (!currentEditor.isNull()) {
+                    QPoint bottomLeft(0, currentEditor->viewport()->height() - 1);
+                    visibleFirst = currentEditor->cursorForPosition(QPoint(0, 0)).blockNumber();
+                    visibleLast  = currentEditor->cursorForPosition(bottomLeft).blockNumber();
+                }
+
+                currentContext = QSharedPointer<Context>(new Context(this));
+                scanNextBlock  = first;
+                scanLastBlock  = last;
+
+                threadPool()->start(
+                    new Scanner(
+                        currentContext,
+                        blockTexts,
+                        currentSearchText,
+                        currentCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive,
+                        currentWholeWordsOnly,
+                        currentRegularExpression,
+                        currentExpression,
+                        first,
+                        last,
+                        visibleFirst,
+                        visibleLast
+                    )
+                );
+            } else {
+                emit searchFinished();
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::batchesReady() {
+        if (!currentContext.isNull()) {
+            QList<Batch> batches = currentContext->takeBatches();
+            for (QList<Batch>::const_iterator it=batches.constBegin(),end=batches.constEnd() ; it!=end ; ++it) {
+                applyBatch(*it);
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::updateVisibleSelections() {
+        // The editor's extra selections are left alone while no search string is set.  They are cleared once, when
+        // the search string becomes empty.
+
+        if (!currentEditor.isNull() && !currentSearchText.isEmpty()) {
+            QList<QTextEdit::ExtraSelection> selections;
+
+            if (currentNumberMatches > 0) {
+                QPoint bottomLeft(0, currentEditor->viewport()->height() - 1);
+                int    firstVisible = currentEditor->cursorForPosition(QPoint(0, 0)).blockNumber();
+                int    lastVisible  = std::min(
+                    currentEditor->cursorForPosition(bottomLeft).blockNumber(),
+                    blockMatches.size() - 1
+                );
+
+                QTextBlock block       = currentDocument->findBlockByNumber(firstVisible);
+                int        blockNumber = firstVisible;
+                while (blockNumber <= lastVisible && block.isValid()) {
+                    const QVector<Match>& matches       = blockMatches.at(blockNumber);
+                    int                   blockPosition = block.position();
+                    int                   blockLength   = block.length() - 1;
+
+                    for (int index=0 ; index<matches.size() ; ++index) {
+                        const Match& match = matches.at(index);
+                        if (match.start + match.length <= blockLength) {
+                            QTextEdit::ExtraSelection selection;
+                            selection.cursor = QTextCursor(block);
+                            selection.cursor.setPosition(blockPosition + match.start);
+                            selection.cursor.setPosition(
+                                blockPosition + match.start + match.length,
+                                QTextCursor::KeepAnchor
+                            );
+
+                            if (blockNumber == currentMatchBlock && index == currentMatchBlockIndex) {
+                                selection.format = currentMatchSelectedFormat;
+                            } else {
+                                selection.format = currentMatchHighlightFormat;
+                            }
+
+                            selections.append(selection);
+                        }
+                    }
+
+                    block = block.next();
+                    ++blockNumber;
+                }
+            }
+
+            currentEditor->setExtraSelections(selections);
+        }
+    }
+
+
+    void CodeEditorSearchEngine::searchOptionsChanged() {
+        if (!currentSearchLineEdit.isNull()) {
+            QAction* caseSensitiveAction     = currentSearchLineEdit->caseSensitiveSearchAction();
+            QAction* wholeWordsOnlyAction    = currentSearchLineEdit->wholeWordsOnlyAction();
+            QAction* regularExpressionAction = currentSearchLineEdit->regularExpressionAction();
+
+            currentCaseSensitive     = caseSensitiveAction != Q_NULLPTR && caseSensitiveAction->isChecked();
+            currentWholeWordsOnly    = wholeWordsOnlyAction != Q_NULLPTR && wholeWordsOnlyAction->isChecked();
+            currentRegularExpression = regularExpressionAction != Q_NULLPTR && regularExpressionAction->isChecked();
+
+            updateSearchExpression();
+            research();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::updateSearchExpression() {
+        if (currentRegularExpression) {
+            QRegularExpression::PatternOptions options = QRegularExpression::UseUnicodePropertiesOption;
+            if (!currentCaseSensitive) {
+                options |= QRegularExpression::CaseInsensitiveOption;
+            }
+
+            QString pattern = currentSearchText;
+            if (currentWholeWordsOnly) {
+                pattern = QString("\\b(?:%1)\\b").arg(pattern);
+            }
+
+            currentExpression = QRegularExpression(pattern, options);
+            currentExpression.optimize();
+        } else {
+            currentExpression = QRegularExpression();
+        }
+    }
+
+
+    void CodeEditorSearchEngine::cancelScan() {
+        scanTimer->stop();
+
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+            currentContext.reset();
+
+            int last = std::min(scanLastBlock, blockTexts.size() - 1);
+            if (scanNextBlock <= last) {
+                markDirty(scanNextBlock, last);
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::markDirty(int firstBlock, int lastBlock) {
+        if (firstDirtyBlock < 0) {
+            firstDirtyBlock = firstBlock;
+            lastDirtyBlock  = lastBlock;
+        } else {
+            firstDirtyBlock = std::min(firstDirtyBlock, firstBlock);
+            lastDirtyBlock  = std::max(lastDirtyBlock, lastBlock);
+        }
+    }
+
+
+    void CodeEditorSearchEngine::applyBatch(const CodeEditorSearchEngine::Batch& batch) {
+        unsigned long oldNumberMatches = currentNumberMatches;
+
+        int numberBlocks = std::min(batch.blockMatches.size(), blockMatches.size() - batch.startBlock);
+        for (int index=0 ; index<numberBlocks ; ++index) {
+            QVector<Match>&       matches    = blockMatches[batch.startBlock + index];
+            const QVector<Match>& newMatches = batch.blockMatches.at(index);
+
+            currentNumberMatches -= matches.size();
+            currentNumberMatches += newMatches.size();
+
+            if (batch.startBlock + index < currentMatchBlock) {
+                currentMatchesBefore -= matches.size();
+                currentMatchesBefore += newMatches.size();
+            }
+
+            matches = newMatches;
+        }
+
+        if (!batch.isPreview) {
+            scanNextBlock = batch.startBlock + batch.blockMatches.size();
+        }
+
+        if (currentMatchBlock >= 0 && currentMatchBlockIndex >= blockMatches.at(currentMatchBlock).size()) {
+            clearCurrentMatch();
+        }
+
+        if (numberBlocks > 0) {
+            selectionTimer->start();
+        }
+
+        if (currentNumberMatches != oldNumberMatches) {
+            emit numberMatchesChanged(currentNumberMatches);
+        }
+
+        if (batch.isFinal) {
+            currentContext.reset();
+
+            if (firstDirtyBlock >= 0) {
+                scanTimer->start();
+            } else {
+                emit searchFinished();
+            }
+        }
+    }
+
+
+    void CodeEditorSearchEngine::selectMatch(int block, int index) {
+        const Match& match     = blockMatches.at(block).at(index);
+        QTextBlock   textBlock = currentDocument->findBlockByNumber(block);
+
+        QTextCursor cursor(textBlock);
+        cursor.setPosition(textBlock.position() + match.start);
+        cursor.setPosition(textBlock.position() + match.start + match.length, QTextCursor::KeepAnchor);
+
+        currentMatchesBefore   = countMatchesBefore(block);
+        currentMatchBlock      = block;
+        currentMatchBlockIndex = index;
+
+        currentEditor->setTextCursor(cursor);
+        selectionTimer->start();
+
+        emit currentMatchChanged(currentMatchIndex());
+    }
+
+
+    void CodeEditorSearchEngine::clearCurrentMatch() {
+        if (currentMatchBlock >= 0) {
+            currentMatchBlock      = -1;
+            currentMatchBlockIndex = 0;
+            currentMatchesBefore   = 0;
+
+            emit currentMatchChanged(-1);
+        }
+    }
+
+
+    void CodeEditorSearchEngine::clearVisibleSelections() {
+        selectionTimer->stop();
+
+        if (!currentEditor.isNull()) {
+            currentEditor->setExtraSelections(QList<QTextEdit::ExtraSelection>());
+        }
+    }
+
+
+    unsigned long CodeEditorSearchEngine::countMatchesBefore(int block) const {
+        unsigned long result;
+
+        int numberBlocks        = blockMatches.size();
+        int distanceFromStart   = block;
+        int distanceFromEnd     = numberBlocks - block;
+        int distanceFromCurrent = currentMatchBlock >= 0 ? std::abs(block - currentMatchBlock) : numberBlocks;
+
+        if (distanceFromCurrent <= std::min(distanceFromStart, distanceFromEnd)) {
+            result = currentMatchesBefore;
+            if (block > currentMatchBlock) {
+                for (int index=currentMatchBlock ; index<block ; ++index) {
+                    result += blockMatches.at(index).size();
+                }
+            } else {
+                for (int index=block ; index<currentMatchBlock ; ++index) {
+                    result -= blockMatches.at(index).size();
+                }
+            }
+        } else if (distanceFromStart <= distanceFromEnd) {
+            result = 0;
+            for (int index=0 ; index<block ; ++index) {
+                result += blockMatches.at(index).size();
+            }
+        } else {
+            result = currentNumberMatches;
+            for (int index=block ; index<numberBlocks ; ++index) {
+                result -= blockMatches.at(index).size();
+            }
+        }
+
+        return result;
+    }
+}
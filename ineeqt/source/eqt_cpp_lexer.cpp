@@ -0,0 +1,239 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::CppLexer class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QChar>
+#include <QSet>
+#include <QVector>
+
+#include "eqt_cpp_lexer.h"
+
+/***********************************************************************************************************************
+ * EQt::CppLexer::Span
+ */
+
+namespace EQt {
+    CppLexer::Span::Span() {
+        currentStart     = 0;
+        currentLength    = 0;
+        currentTokenType = TokenType::KEYWORD;
+    }
+
+
+    CppLexer::Span::Span(int start, int length, CppLexer::TokenType tokenType) {
+        currentStart     = start;
+        currentLength    = length;
+        currentTokenType = tokenType;
+    }
+
+
+    CppLexer::Span::~Span() {}
+
+
+    bool CppLexer::Span::operator==(const CppLexer::Span& other) const {
+        return (
+               currentStart == other.currentStart
+            && currentLength == other.currentLength
+            && currentTokenType == other.currentTokenType
+        );
+    }
+
+
+    bool CppLexer::Span::operator!=(const CppLexer::Span& other) const {
+        return !operator==(other);
+    }
+}
+
+/***********************************************************************************************************************
+ * EQt::CppLexer
+ */
+
+namespace EQt {
+    const int CppLexer::normalState           = 0;
+    const int CppLexer::multiLineCommentState = 1;
+
+    /**
+     * Function that builds the set of highlighted keywords.
+     *
+     * \return Returns the keyword set.
+     */
+    static QSet<QString> buildKeywordSet() {
+        static const char* const keywords[] = {
+            "char",      "class",     "const",     "double",    "enum",      "explicit",
+            "friend",    "inline",    "int",       "long",      "namespace", "operator",
+            "private",   "protected", "public",    "short",     "signals",   "signed",
+            "slots",     "static",    "struct",    "template",  "typedef",   "typename",
+            "union",     "unsigned",  "virtual",   "void",      "volatile",  "bool",
+            Q_NULLPTR
+        };
+
+        QSet<QString> result;
+        for (const char* const* keyword=keywords ; *keyword != Q_NULLPTR ; ++keyword) {
+            result.insert(QString::fromLatin1(*keyword));
+        }
+
+        return result;
+    }
+
+
+    /**
+     * Function that returns the set of highlighted keywords.  The set is built on first use.
+     *
+     * \return Returns a reference to the keyword set.
+     */
+    static const QSet<QString>& keywordSet() {
+        static const QSet<QString> keywords = buildKeywordSet();
+        return keywords;
+    }
+
+
+    /**
+     * Function that determines if a character can be part of a word.  Matches the ASCII definition used by the
+     * regular expression word boundary.
+     *
+     * \param[in] c The UTF-16 code unit to check.
+     *
+     * \return Returns true if the character is a word character.
+     */
+    static inline bool isWordCharacter(ushort c) {
+        return (
+               (c >= 'a' && c <= 'z')
+            || (c >= 'A' && c <= 'Z')
+            || (c >= '0' && c <= '9')
+            || c == '_'
+        );
+    }
+
+
+    int CppLexer::lex(const QString& text, int previousBlockState, CppLexer::Spans& spans) {
+        const QSet<QString>& keywords = keywordSet();
+
+        const QChar* data   = text.constData();
+        int          length = text.length();
+
+        // Keywords are written to the output as they are found.  The remaining spans are held back so every span is
+        // reported in the order the original rules applied them.
+
+        Spans functionSpans;
+        Spans commentSpans;
+
+        spans.clear();
+
+        int  singleLineCommentStart = -1;
+        int  firstQuote             = -1;
+        int  lastQuote              = -1;
+        bool inComment              = (previousBlockState == multiLineCommentState);
+        int  commentStart           = 0;
+        int  commentSearchStart     = 0;
+
+        int index = 0;
+        while (index < length) {
+            ushort c    = data[index].unicode();
+            ushort next = index + 1 < length ? data[index + 1].unicode() : 0;
+
+            // Single line comments and strings were matched without regard to multi-line comments, so they are
+            // tracked everywhere.
+
+            if (c == '/' && next == '/' && singleLineCommentStart < 0) {
+                singleLineCommentStart = index;
+            }
+
+            if (c == '"') {
+                if (firstQuote < 0) {
+                    firstQuote = index;
+                }
+
+                lastQuote = index;
+            }
+
+            if (inComment) {
+                if (c == '*' && next == '/') {
+                    commentSpans.append(Span(commentStart, index + 2 - commentStart, TokenType::MULTI_LINE_COMMENT));
+
+                    inComment          = false;
+                    commentSearchStart = index + 2;
+                }
+
+                ++index;
+            } else if (c == '/' && next == '*' && index >= commentSearchStart) {
+                // The search for the end starts at the opening slash, so "/*/" is a complete comment.
+
+                inComment    = true;
+                commentStart = index;
+
+                ++index;
+            } else if (isWordCharacter(c)) {
+                int wordEnd = index + 1;
+                while (wordEnd < length && isWordCharacter(data[wordEnd].unicode())) {
+                    ++wordEnd;
+                }
+
+                int wordLength = wordEnd - index;
+                if (wordEnd < length && data[wordEnd] == QChar('(')) {
+                    functionSpans.append(Span(index, wordLength, TokenType::FUNCTION));
+                } else if (keywords.contains(QString::fromRawData(data + index, wordLength))) {
+                    spans.append(Span(index, wordLength, TokenType::KEYWORD));
+                }
+
+                index = wordEnd;
+            } else {
+                ++index;
+            }
+        }
+
+        if (singleLineCommentStart >= 0) {
+            spans.append(
+                Span(singleLineCommentStart, length - singleLineCommentStart, TokenType::SINGLE_LINE_COMMENT)
+            );
+        }
+
+        if (lastQuote > firstQuote) {
+            spans.append(Span(firstQuote, lastQuote + 1 - firstQuote, TokenType::QUOTATION));
+        }
+
+        spans += functionSpans;
+        spans += commentSpans;
+
+        int result;
+        if (inComment) {
+            if (length > commentStart) {
+                spans.append(Span(commentStart, length - commentStart, TokenType::MULTI_LINE_COMMENT));
+            }
+
+            result = multiLineCommentState;
+        } else {
+            result = normalState;
+        }
+
+        return result;
+    }
+
+
+    bool CppLexer::isKeyword(const QString& word) {
+        return keywordSet().contains(word);
+    }
+}
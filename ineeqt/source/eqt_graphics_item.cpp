@@ -33,6 +33,7 @@
 #include <QList>
 
 #include "eqt_application.h"
+#include "eqt_graphics_scene.h"
 #include "eqt_graphics_item.h"
 
 namespace EQt {
@@ -47,20 +48,49 @@ namespace EQt {
         QObject::connect(cleanupTimer, &QTimer::timeout, &GraphicsItem::performGarbageCollection);
     }
 
-    GraphicsItem::GraphicsItem() {}
+    GraphicsItem::GraphicsItem() {
+        currentDeferralDepth           = 0;
+        currentGeometryChangeIsPending = false;
+        currentUpdateIsPending         = false;
+        currentTransactionScene        = Q_NULLPTR;
+        currentGraphicsItem            = Q_NULLPTR;
+    }
+
+
+    GraphicsItem::~GraphicsItem() {
+        if (currentTransactionScene != Q_NULLPTR) {
+            currentTransactionScene->removeDeferredItem(this);
+        }
+    }
 
 
-    GraphicsItem::~GraphicsItem() {}
+    void GraphicsItem::deferUpdates() {
+        ++currentDeferralDepth;
+    }
 
 
-    void GraphicsItem::deferUpdates() {}
+    void GraphicsItem::restoreUpdates() {
+        if (currentDeferralDepth > 0) {
+            --currentDeferralDepth;
 
+            if (currentDeferralDepth == 0 && (currentGeometryChangeIsPending || currentUpdateIsPending)) {
+                bool geometryChanged = currentGeometryChangeIsPending;
 
-    void GraphicsItem::restoreUpdates() {}
+                currentGeometryChangeIsPending = false;
+                currentUpdateIsPending         = false;
+
+                if (geometryChanged) {
+                    notifyDeferredGeometryChange();
+                }
+
+                applyDeferredUpdates();
+            }
+        }
+    }
 
 
     bool GraphicsItem::updatesAreDeferred() const {
-        return false;
+        return currentDeferralDepth > 0;
     }
 
 
@@ -84,6 +114,71 @@ namespace EQt {
     }
 
 
+    bool GraphicsItem::reportGeometryChange() {
+        bool result;
+
+        if (!deferringUpdates()) {
+            result = true;
+        } else if (!currentGeometryChangeIsPending) {
+            // The scene is told before the first change so the original region is repainted.  Later changes are
+            // reported once, through notifyDeferredGeometryChange, when updates are restored.
+            currentGeometryChangeIsPending = true;
+            result                         = true;
+        } else {
+            result = false;
+        }
+
+        return result;
+    }
+
+
+    void GraphicsItem::requestUpdate() {
+        if (deferringUpdates()) {
+            currentUpdateIsPending = true;
+        } else {
+            graphicsItem()->update();
+        }
+    }
+
+
+    bool GraphicsItem::deferringUpdates() {
+        if (currentDeferralDepth == 0 && GraphicsScene::numberOpenTransactions > 0) {
+            joinSceneTransaction();
+        }
+
+        return currentDeferralDepth > 0;
+    }
+
+
+    void GraphicsItem::applyDeferredUpdates() {
+        graphicsItem()->update();
+    }
+
+
+    void GraphicsItem::notifyDeferredGeometryChange() {}
+
+
+    QGraphicsItem* GraphicsItem::graphicsItem() {
+        if (currentGraphicsItem == Q_NULLPTR) {
+            currentGraphicsItem = dynamic_cast<QGraphicsItem*>(this);
+        }
+
+        return currentGraphicsItem;
+    }
+
+
+    void GraphicsItem::joinSceneTransaction() {
+        QGraphicsItem* item = graphicsItem();
+        if (item != Q_NULLPTR) {
+            GraphicsScene* scene = qobject_cast<GraphicsScene*>(item->scene());
+            if (scene != Q_NULLPTR && scene->updateTransactionIsOpen()) {
+                scene->addDeferredItem(this);
+                deferUpdates();
+            }
+        }
+    }
+
+
     void GraphicsItem::deleteLater() {
         garbageCan.append(this);
         cleanupTimer->start(0);
@@ -46,11 +46,19 @@ namespace EQt {
 
 
     void GraphicsItemGroup::setForcedGeometry(const QRectF& rectangle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentForcedGeometry = rectangle;
     }
 
 
     void GraphicsItemGroup::clearForcedGeometry() {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentForcedGeometry = QRectF();
     }
 
@@ -84,4 +92,9 @@ namespace EQt {
     bool GraphicsItemGroup::isGroup() const {
         return true;
     }
+
+
+    void GraphicsItemGroup::notifyDeferredGeometryChange() {
+        prepareGeometryChange();
+    }
 }
@@ -0,0 +1,845 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::GraphicsItemSerializer class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QFont>
+#include <QPen>
+#include <QBrush>
+#include <QColor>
+#include <QRectF>
+#include <QLineF>
+#include <QPointF>
+#include <QPainterPath>
+#include <QGraphicsItem>
+#include <QtEndian>
+
+#include <cstring>
+#include <utility>
+
+#include "eqt_graphics_item_group.h"
+#include "eqt_graphics_multi_text_group.h"
+#include "eqt_graphics_math_group.h"
+#include "eqt_graphics_math_group_with_line.h"
+#include "eqt_graphics_math_group_with_painter_path.h"
+#include "eqt_graphics_item_serializer.h"
+
+/***********************************************************************************************************************
+ * Format constants
+ */
+
+namespace EQt {
+    /**
+     * Marker placed at the start of every stream.
+     */
+    static const char streamMagic[4] = { 'E', 'Q', 'G', 'I' };
+
+    /**
+     * Tags used to identify each item type in the stream.
+     */
+    enum class ItemTag: quint8 {
+        ITEM_GROUP                   = 1,
+        MULTI_TEXT_GROUP             = 2,
+        MATH_GROUP                   = 3,
+        MATH_GROUP_WITH_LINE         = 4,
+        MATH_GROUP_WITH_PAINTER_PATH = 5
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsItemSerializer::Writer
+ */
+
+namespace EQt {
+    /**
+     * Class that writes item trees to a byte array.  Items are written to a body buffer while the font table is
+     * collected.  The font table is placed ahead of the body once every item has been written.
+     */
+    class GraphicsItemSerializer::Writer {
+        public:
+            Writer() {}
+
+            /**
+             * Method that writes an item and its children.
+             *
+             * \param[in] item  The item to be written.
+             *
+             * \param[in] depth The depth of the item.  Root items have a depth of one.
+             *
+             * \return Returns true on success.  Returns false if the item, or one of its children, is not supported or
+             *         the tree is nested too deeply.
+             */
+            bool writeItem(const GraphicsItemGroup* item, unsigned depth = 1) {
+                bool success = true;
+                int  type    = item->type();
+
+                if (depth > maximumNestingDepth) {
+                    success = false;
+                } else if (type == GraphicsItemGroup::Type) {
+                    writeU8(static_cast<quint8>(ItemTag::ITEM_GROUP));
+                    writeItemGroup(item);
+                } else if (type == GraphicsMultiTextGroup::Type) {
+                    writeU8(static_cast<quint8>(ItemTag::MULTI_TEXT_GROUP));
+                    writeMultiTextGroup(static_cast<const GraphicsMultiTextGroup*>(item));
+                } else if (type == GraphicsMathGroup::Type) {
+                    writeU8(static_cast<quint8>(ItemTag::MATH_GROUP));
+                    writeMathGroup(static_cast<const GraphicsMathGroup*>(item));
+                } else if (type == GraphicsMathGroupWithLine::Type) {
+                    const GraphicsMathGroupWithLine* lineGroup = static_cast<const GraphicsMathGroupWithLine*>(item);
+
+                    writeU8(static_cast<quint8>(ItemTag::MATH_GROUP_WITH_LINE));
+                    writeMathGroup(lineGroup);
+                    writeLine(lineGroup->line());
+                    writePen(lineGroup->linePen());
+                } else if (type == GraphicsMathGroupWithPainterPath::Type) {
+                    const GraphicsMathGroupWithPainterPath* pathGroup =
+                        static_cast<const GraphicsMathGroupWithPainterPath*>(item);
+
+                    writeU8(static_cast<quint8>(ItemTag::MATH_GROUP_WITH_PAINTER_PATH));
+                    writeMathGroup(pathGroup);
+                    writePainterPath(pathGroup->painterPath());
+                    writePen(pathGroup->painterPathPen());
+                    writeBrush(pathGroup->painterPathBrush());
+                } else {
+                    success = false;
+                }
+
+                if (success) {
+                    QList<QGraphicsItem*> children = item->childItems();
+                    writeU32(static_cast<quint32>(children.size()));
+
+                    QList<QGraphicsItem*>::const_iterator childIterator    = children.constBegin();
+                    QList<QGraphicsItem*>::const_iterator childEndIterator = children.constEnd();
+                    while (success && childIterator != childEndIterator) {
+                        const GraphicsItemGroup* child = dynamic_cast<const GraphicsItemGroup*>(*childIterator);
+                        success = child != Q_NULLPTR && writeItem(child, depth + 1);
+                        ++childIterator;
+                    }
+                }
+
+                return success;
+            }
+
+            /**
+             * Method that assembles the final stream.
+             *
+             * \param[in] numberRootItems The number of root items written to the body.
+             *
+             * \return Returns the complete stream.
+             */
+            QByteArray finish(unsigned numberRootItems) {
+                QByteArray body;
+                body.swap(buffer);
+
+                buffer.reserve(body.size() + 64 * fonts.size() + 16);
+                buffer.append(streamMagic, sizeof(streamMagic));
+                writeU16(static_cast<quint16>(formatVersion));
+                writeU16(0);
+
+                writeU32(static_cast<quint32>(fonts.size()));
+                for (QList<QString>::const_iterator it=fonts.constBegin(),end=fonts.constEnd() ; it!=end ; ++it) {
+                    writeString(*it);
+                }
+
+                writeU32(numberRootItems);
+                buffer.append(body);
+
+                return buffer;
+            }
+
+        private:
+            void writeItemGroup(const GraphicsItemGroup* group) {
+                writePoint(group->pos());
+                if (group->hasForcedBoundingRectangle()) {
+                    writeU8(1);
+                    writeRectangle(group->forcedGeometry());
+                } else {
+                    writeU8(0);
+                }
+            }
+
+            void writeMultiTextGroup(const GraphicsMultiTextGroup* group) {
+                writeItemGroup(group);
+                writeBrush(group->backgroundBrush());
+                writePen(group->borderPen());
+                writePen(group->textPen());
+
+                unsigned numberEntries = group->numberTextEntries();
+                writeU32(numberEntries);
+
+                for (unsigned entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                    const GraphicsMultiTextGroup::TextEntry& entry = group->entry(entryIndex);
+                    writeU32(streamFontIndex(entry.fontIndex()));
+                    writePoint(entry.position());
+                    writeString(entry.text());
+                }
+            }
+
+            void writeMathGroup(const GraphicsMathGroup* group) {
+                writeMultiTextGroup(group);
+
+                writeU8(static_cast<quint8>(group->leftParenthesisStyle()));
+                writeRectangle(group->leftParenthesisBoundingRectangle());
+                writeU8(static_cast<quint8>(group->rightParenthesisStyle()));
+                writeRectangle(group->rightParenthesisBoundingRectangle());
+                writeU8(static_cast<quint8>(group->bottomParenthesisStyle()));
+                writeRectangle(group->bottomParenthesisBoundingRectangle());
+                writeDouble(group->parenthesisCenterLine());
+                writePen(group->parenthesisPen());
+                writeBrush(group->parenthesisBrush());
+            }
+
+            unsigned streamFontIndex(unsigned fontIndex) {
+                unsigned result;
+
+                QHash<unsigned, unsigned>::const_iterator it = streamFontIndexes.constFind(fontIndex);
+                if (it != streamFontIndexes.constEnd()) {
+                    result = it.value();
+                } else {
+                    result = static_cast<unsigned>(fonts.size());
+                    fonts.append(GraphicsMultiTextGroup::internedFont(fontIndex).toString());
+                    streamFontIndexes.insert(fontIndex, result);
+                }
+
+                return result;
+            }
+
+            void writeU8(quint8 value) {
+                buffer.append(static_cast<char>(value));
+            }
+
+            void writeU16(quint16 value) {
+                char data[sizeof(quint16)];
+                qToLittleEndian(value, data);
+                buffer.append(data, sizeof(data));
+            }
+
+            void writeU32(quint32 value) {
+                char data[sizeof(quint32)];
+                qToLittleEndian(value, data);
+                buffer.append(data, sizeof(data));
+            }
+
+            void writeDouble(double value) {
+                quint64 bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                char data[sizeof(quint64)];
+                qToLittleEndian(bits, data);
+                buffer.append(data, sizeof(data));
+            }
+
+            void writeString(const QString& value) {
+                int length = value.size();
+                writeU32(static_cast<quint32>(length));
+
+                const ushort* characters = value.utf16();
+                for (int i=0 ; i<length ; ++i) {
+                    writeU16(characters[i]);
+                }
+            }
+
+            void writePoint(const QPointF& point) {
+                writeDouble(point.x());
+                writeDouble(point.y());
+            }
+
+            void writeRectangle(const QRectF& rectangle) {
+                writeDouble(rectangle.x());
+                writeDouble(rectangle.y());
+                writeDouble(rectangle.width());
+                writeDouble(rectangle.height());
+            }
+
+            void writeLine(const QLineF& line) {
+                writePoint(line.p1());
+                writePoint(line.p2());
+            }
+
+            void writeColor(const QColor& color) {
+                writeU32(color.rgba());
+            }
+
+            void writePen(const QPen& pen) {
+                writeU8(static_cast<quint8>(pen.style()));
+                writeU16(static_cast<quint16>(pen.capStyle()));
+                writeU16(static_cast<quint16>(pen.joinStyle()));
+                writeU8(pen.isCosmetic() ? 1 : 0);
+                writeDouble(pen.widthF());
+                writeColor(pen.color());
+            }
+
+            void writeBrush(const QBrush& brush) {
+                Qt::BrushStyle style = brush.style();
+                if (style > Qt::DiagCrossPattern) {
+                    style = Qt::SolidPattern;
+                }
+
+                writeU8(static_cast<quint8>(style));
+                writeColor(brush.color());
+            }
+
+            void writePainterPath(const QPainterPath& path) {
+                int numberElements = path.elementCount();
+
+                writeU8(static_cast<quint8>(path.fillRule()));
+                writeU32(static_cast<quint32>(numberElements));
+
+                for (int elementIndex=0 ; elementIndex<numberElements ; ++elementIndex) {
+                    const QPainterPath::Element& element = path.elementAt(elementIndex);
+                    writeU8(static_cast<quint8>(element.type));
+                    writeDouble(element.x);
+                    writeDouble(element.y);
+                }
+            }
+
+            QByteArray                buffer;
+            QList<QString>            fonts;
+            QHash<unsigned, unsigned> streamFontIndexes;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsItemSerializer::Reader
+ */
+
+namespace EQt {
+    /**
+     * Class that reads item trees directly from a buffer.  Every read is bounds checked.  Once an error is detected,
+     * all further reads return zero values and the reader reports failure.
+     */
+    class GraphicsItemSerializer::Reader {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] data       Pointer to the serialized data.
+             *
+             * \param[in] dataLength The length of the serialized data, in bytes.
+             */
+            Reader(const uchar* data, qint64 dataLength) {
+                current = data;
+                end     = data + dataLength;
+                isValid = data != Q_NULLPTR && dataLength >= 0;
+            }
+
+            /**
+             * Method that reads the stream.
+             *
+             * \return Returns the root items.  An empty list is returned on error.
+             */
+            QList<GraphicsItemGroup*> read() {
+                QList<GraphicsItemGroup*> result;
+
+                if (available(sizeof(streamMagic)) && std::memcmp(current, streamMagic, sizeof(streamMagic)) == 0) {
+                    current += sizeof(streamMagic);
+
+                    unsigned version = readU16();
+                    readU16();
+
+                    if (isValid && version <= formatVersion) {
+                        unsigned numberFonts = readU32();
+                        if (isValid && available(4ULL * numberFonts)) {
+                            fontIndexes.reserve(static_cast<int>(numberFonts));
+                            for (unsigned fontIndex=0 ; isValid && fontIndex<numberFonts ; ++fontIndex) {
+                                QFont font;
+                                font.fromString(readString());
+                                fontIndexes.append(GraphicsMultiTextGroup::internFont(font));
+                            }
+
+                            unsigned numberItems = readU32();
+                            for (unsigned itemIndex=0 ; isValid && itemIndex<numberItems ; ++itemIndex) {
+                                GraphicsItemGroup* item = readItem(1);
+                                if (item != Q_NULLPTR) {
+                                    result.append(item);
+                                }
+                            }
+
+                            if (!isValid) {
+                                for (  QList<GraphicsItemGroup*>::const_iterator it  = result.constBegin(),
+                                                                                 end = result.constEnd()
+                                     ; it != end
+                                     ; ++it
+                                    ) {
+                                    deleteTree(*it);
+                                }
+
+                                result.clear();
+                            }
+                        }
+                    }
+                }
+
+                return result;
+            }
+
+        private:
+            /**
+             * Method that reads an item and its children.
+             *
+             * \param[in] depth The depth of the item.  Root items have a depth of one.
+             *
+             * \return Returns the item.  A null pointer is returned on error.
+             */
+            GraphicsItemGroup* readItem(unsigned depth) {
+                GraphicsItemGroup* result = Q_NULLPTR;
+
+                // Checking the depth before any child is created keeps a corrupt stream from exhausting the stack.
+
+                ItemTag tag = static_cast<ItemTag>(readU8());
+                if (depth > maximumNestingDepth) {
+                    isValid = false;
+                } else {
+                    switch (tag) {
+                        case ItemTag::ITEM_GROUP: {
+                            result = new GraphicsItemGroup;
+                            break;
+                        }
+
+                        case ItemTag::MULTI_TEXT_GROUP: {
+                            result = new GraphicsMultiTextGroup;
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP: {
+                            result = new GraphicsMathGroup;
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP_WITH_LINE: {
+                            result = new GraphicsMathGroupWithLine;
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP_WITH_PAINTER_PATH: {
+                            result = new GraphicsMathGroupWithPainterPath;
+                            break;
+                        }
+
+                        default: {
+                            isValid = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (result != Q_NULLPTR) {
+                    // Populating the item with updates deferred limits the item to a single geometry change.
+
+                    result->deferUpdates();
+
+                    switch (tag) {
+                        case ItemTag::ITEM_GROUP: {
+                            readItemGroup(result);
+                            break;
+                        }
+
+                        case ItemTag::MULTI_TEXT_GROUP: {
+                            readMultiTextGroup(static_cast<GraphicsMultiTextGroup*>(result));
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP: {
+                            readMathGroup(static_cast<GraphicsMathGroup*>(result));
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP_WITH_LINE: {
+                            GraphicsMathGroupWithLine* group = static_cast<GraphicsMathGroupWithLine*>(result);
+
+                            readMathGroup(group);
+                            group->setLine(readLine());
+                            group->setLinePen(readPen());
+
+                            break;
+                        }
+
+                        case ItemTag::MATH_GROUP_WITH_PAINTER_PATH: {
+                            GraphicsMathGroupWithPainterPath* group =
+                                static_cast<GraphicsMathGroupWithPainterPath*>(result);
+
+                            readMathGroup(group);
+                            group->setPainterPath(readPainterPath());
+                            group->setPainterPathPen(readPen());
+                            group->setPainterPathBrush(readBrush());
+
+                            break;
+                        }
+                    }
+
+                    unsigned numberChildren = readU32();
+                    for (unsigned childIndex=0 ; isValid && childIndex<numberChildren ; ++childIndex) {
+                        GraphicsItemGroup* child = readItem(depth + 1);
+                        if (child != Q_NULLPTR) {
+                            child->setParentItem(result);
+                        }
+                    }
+
+                    result->restoreUpdates();
+
+                    if (!isValid) {
+                        deleteTree(result);
+                        result = Q_NULLPTR;
+                    }
+                }
+
+                return result;
+            }
+
+            /**
+             * Method that deletes an item and its descendants.  Group destructors release, rather than delete, their
+             * children.
+             *
+             * \param[in] item The item to be deleted.
+             */
+            static void deleteTree(QGraphicsItem* item) {
+                QList<QGraphicsItem*> children = item->childItems();
+                delete item;
+
+                for (  QList<QGraphicsItem*>::const_iterator it  = children.constBegin(),
+                                                             end = children.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    deleteTree(*it);
+                }
+            }
+
+            void readItemGroup(GraphicsItemGroup* group) {
+                group->setPos(readPoint());
+                if (readFlag()) {
+                    group->setForcedGeometry(readRectangle());
+                }
+            }
+
+            void readMultiTextGroup(GraphicsMultiTextGroup* group) {
+                readItemGroup(group);
+                group->setBackgroundBrush(readBrush());
+                group->setBorderPen(readPen());
+                group->setTextPen(readPen());
+
+                // Each entry requires at least 24 bytes.  Checking up front keeps a corrupt count from triggering a
+                // huge allocation.
+
+                unsigned numberEntries = readU32();
+                if (isValid && available(24ULL * numberEntries)) {
+                    GraphicsMultiTextGroup::TextEntries entries;
+                    entries.reserve(static_cast<int>(numberEntries));
+
+                    for (unsigned entryIndex=0 ; isValid && entryIndex<numberEntries ; ++entryIndex) {
+                        unsigned streamFontIndex = readU32();
+                        QPointF  position        = readPoint();
+                        QString  text            = readString();
+
+                        if (streamFontIndex < static_cast<unsigned>(fontIndexes.size())) {
+                            entries.append(
+                                GraphicsMultiTextGroup::TextEntry(
+                                    std::move(text),
+                                    fontIndexes.at(streamFontIndex),
+                                    position
+                                )
+                            );
+                        } else {
+                            isValid = false;
+                        }
+                    }
+
+                    if (isValid) {
+                        group->append(std::move(entries));
+                    }
+                }
+            }
+
+            void readMathGroup(GraphicsMathGroup* group) {
+                readMultiTextGroup(group);
+
+                GraphicsMathGroup::ParenthesisStyle leftStyle = readParenthesisStyle();
+                group->setLeftParenthesis(leftStyle, readRectangle());
+
+                GraphicsMathGroup::ParenthesisStyle rightStyle = readParenthesisStyle();
+                group->setRightParenthesis(rightStyle, readRectangle());
+
+                GraphicsMathGroup::ParenthesisStyle bottomStyle = readParenthesisStyle();
+                group->setBottomParenthesis(bottomStyle, readRectangle());
+
+                group->setParenthesisCenterLine(static_cast<float>(readDouble()));
+                group->setParenthesisPen(readPen());
+                group->setParenthesisBrush(readBrush());
+            }
+
+            bool available(unsigned long long numberBytes) {
+                if (isValid && static_cast<unsigned long long>(end - current) < numberBytes) {
+                    isValid = false;
+                }
+
+                return isValid;
+            }
+
+            quint8 readU8() {
+                quint8 result = 0;
+                if (available(sizeof(quint8))) {
+                    result = *current;
+                    current += sizeof(quint8);
+                }
+
+                return result;
+            }
+
+            quint16 readU16() {
+                quint16 result = 0;
+                if (available(sizeof(quint16))) {
+                    result = qFromLittleEndian<quint16>(current);
+                    current += sizeof(quint16);
+                }
+
+                return result;
+            }
+
+            quint32 readU32() {
+                quint32 result = 0;
+                if (available(sizeof(quint32))) {
+                    result = qFromLittleEndian<quint32>(current);
+                    current += sizeof(quint32);
+                }
+
+                return result;
+            }
+
+            double readDouble() {
+                double result = 0;
+                if (available(sizeof(quint64))) {
+                    quint64 bits = qFromLittleEndian<quint64>(current);
+                    std::memcpy(&result, &bits, sizeof(result));
+                    current += sizeof(quint64);
+                }
+
+                return result;
+            }
+
+            QString readString() {
+                QString  result;
+                unsigned length = readU32();
+
+                if (available(2ULL * length)) {
+                    result.resize(static_cast<int>(length));
+
+                    QChar* characters = result.data();
+                    for (unsigned i=0 ; i<length ; ++i) {
+                        characters[i] = QChar(qFromLittleEndian<quint16>(current));
+                        current += sizeof(quint16);
+                    }
+                }
+
+                return result;
+            }
+
+            bool readFlag() {
+                quint8 value = readU8();
+                if (value > 1) {
+                    isValid = false;
+                }
+
+                return value == 1;
+            }
+
+            QPointF readPoint() {
+                double x = readDouble();
+                double y = readDouble();
+
+                return QPointF(x, y);
+            }
+
+            QRectF readRectangle() {
+                double x      = readDouble();
+                double y      = readDouble();
+                double width  = readDouble();
+                double height = readDouble();
+
+                return QRectF(x, y, width, height);
+            }
+
+            QLineF readLine() {
+                QPointF p1 = readPoint();
+                QPointF p2 = readPoint();
+
+                return QLineF(p1, p2);
+            }
+
+            QColor readColor() {
+                return QColor::fromRgba(readU32());
+            }
+
+            QPen readPen() {
+                quint8  style     = readU8();
+                quint16 capStyle  = readU16();
+                quint16 joinStyle = readU16();
+                bool    cosmetic  = readFlag();
+                double  width     = readDouble();
+                QColor  color     = readColor();
+
+                QPen pen;
+                if (style > Qt::CustomDashLine                                                                  ||
+                    (capStyle != Qt::FlatCap && capStyle != Qt::SquareCap && capStyle != Qt::RoundCap)            ||
+                    (joinStyle != Qt::MiterJoin && joinStyle != Qt::BevelJoin && joinStyle != Qt::RoundJoin &&
+                     joinStyle != Qt::SvgMiterJoin                                                            )    ) {
+                    isValid = false;
+                } else {
+                    pen.setStyle(static_cast<Qt::PenStyle>(style));
+                    pen.setCapStyle(static_cast<Qt::PenCapStyle>(capStyle));
+                    pen.setJoinStyle(static_cast<Qt::PenJoinStyle>(joinStyle));
+                    pen.setCosmetic(cosmetic);
+                    pen.setWidthF(width);
+                    pen.setColor(color);
+                }
+
+                return pen;
+            }
+
+            QBrush readBrush() {
+                Qt::BrushStyle style = static_cast<Qt::BrushStyle>(readU8());
+                QColor         color = readColor();
+
+                if (style > Qt::DiagCrossPattern) {
+                    isValid = false;
+                    style   = Qt::NoBrush;
+                }
+
+                return QBrush(color, style);
+            }
+
+            GraphicsMathGroup::ParenthesisStyle readParenthesisStyle() {
+                quint8 value = readU8();
+                if (value > static_cast<quint8>(GraphicsMathGroup::ParenthesisStyle::ABSOLUTE_VALUE)) {
+                    isValid = false;
+                    value   = static_cast<quint8>(GraphicsMathGroup::ParenthesisStyle::INVALID);
+                }
+
+                return static_cast<GraphicsMathGroup::ParenthesisStyle>(value);
+            }
+
+            QPainterPath readPainterPath() {
+                QPainterPath result;
+
+                quint8 fillRule = readU8();
+                if (fillRule > Qt::WindingFill) {
+                    isValid = false;
+                } else {
+                    result.setFillRule(static_cast<Qt::FillRule>(fillRule));
+                }
+
+                // Each element requires 17 bytes.
+
+                unsigned numberElements = readU32();
+                if (available(17ULL * numberElements)) {
+                    unsigned elementIndex = 0;
+                    while (isValid && elementIndex < numberElements) {
+                        QPainterPath::ElementType type  = static_cast<QPainterPath::ElementType>(readU8());
+                        QPointF                   point = readPoint();
+
+                        ++elementIndex;
+
+                        if (type == QPainterPath::MoveToElement) {
+                            result.moveTo(point);
+                        } else if (type == QPainterPath::LineToElement) {
+                            result.lineTo(point);
+                        } else if (type == QPainterPath::CurveToElement && elementIndex + 2 <= numberElements) {
+                            QPainterPath::ElementType secondType  = static_cast<QPainterPath::ElementType>(readU8());
+                            QPointF                   secondPoint = readPoint();
+                            QPainterPath::ElementType endType     = static_cast<QPainterPath::ElementType>(readU8());
+                            QPointF                   endPoint    = readPoint();
+
+                            elementIndex += 2;
+
+                            if (secondType == QPainterPath::CurveToDataElement &&
+                                endType == QPainterPath::CurveToDataElement       ) {
+                                result.cubicTo(point, secondPoint, endPoint);
+                            } else {
+                                isValid = false;
+                            }
+                        } else {
+                            isValid = false;
+                        }
+                    }
+                }
+
+                return result;
+            }
+
+            const uchar*      current;
+            const uchar*      end;
+            bool              isValid;
+            QVector<unsigned> fontIndexes;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsItemSerializer
+ */
+
+namespace EQt {
+    const unsigned GraphicsItemSerializer::formatVersion       = 1;
+    const unsigned GraphicsItemSerializer::maximumNestingDepth = 256;
+    const QString  GraphicsItemSerializer::mimeType("application/x-eqt-graphics-items");
+
+    QByteArray GraphicsItemSerializer::serialize(const GraphicsItemGroup* item) {
+        return serialize(QList<const GraphicsItemGroup*>() << item);
+    }
+
+
+    QByteArray GraphicsItemSerializer::serialize(const QList<const GraphicsItemGroup*>& items) {
+        QByteArray result;
+        Writer     writer;
+        bool       success = true;
+
+        QList<const GraphicsItemGroup*>::const_iterator itemIterator    = items.constBegin();
+        QList<const GraphicsItemGroup*>::const_iterator itemEndIterator = items.constEnd();
+        while (success && itemIterator != itemEndIterator) {
+            success = writer.writeItem(*itemIterator);
+            ++itemIterator;
+        }
+
+        if (success) {
+            result = writer.finish(static_cast<unsigned>(items.size()));
+        }
+
+        return result;
+    }
+
+
+    QList<GraphicsItemGroup*> GraphicsItemSerializer::deserialize(const QByteArray& data) {
+        return deserialize(reinterpret_cast<const uchar*>(data.constData()), data.size());
+    }
+
+
+    QList<GraphicsItemGroup*> GraphicsItemSerializer::deserialize(const uchar* data, qint64 dataLength) {
+        Reader reader(data, dataLength);
+        return reader.read();
+    }
+}
@@ -34,11 +34,31 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QTransform>
+#include <QCache>
+
+#include <algorithm>
+#include <cmath>
 
 #include "eqt_graphics_multi_text_group.h"
 #include "eqt_graphics_math_group.h"
 
 namespace EQt {
+    const unsigned GraphicsMathGroup::defaultParenthesisCacheSize = 1024;
+
+    /**
+     * Number of quantization steps per unit of height to width ratio.
+     */
+    static const float heightToWidthQuantization = 32.0F;
+
+    /**
+     * Number of quantization steps per unit of normalized center line position.
+     */
+    static const float centerLineQuantization = 256.0F;
+
+    static QCache<quint64, QPainterPath> parenthesisPathCache(GraphicsMathGroup::defaultParenthesisCacheSize);
+    static unsigned long long            parenthesisCacheHitCount  = 0;
+    static unsigned long long            parenthesisCacheMissCount = 0;
+
     GraphicsMathGroup::GraphicsMathGroup() {
         currentParenthesisPen         = QPen(QColor(Qt::black));
         currentParenthesisBrush       = QBrush(QColor(Qt::black));
@@ -57,9 +77,39 @@ namespace EQt {
     }
 
 
+    void GraphicsMathGroup::setParenthesisCacheSize(unsigned newCacheSize) {
+        parenthesisPathCache.setMaxCost(newCacheSize);
+    }
+
+
+    unsigned GraphicsMathGroup::parenthesisCacheSize() {
+        return static_cast<unsigned>(parenthesisPathCache.maxCost());
+    }
+
+
+    void GraphicsMathGroup::clearParenthesisCache() {
+        parenthesisPathCache.clear();
+        parenthesisCacheHitCount  = 0;
+        parenthesisCacheMissCount = 0;
+    }
+
+
+    unsigned long long GraphicsMathGroup::parenthesisCacheHits() {
+        return parenthesisCacheHitCount;
+    }
+
+
+    unsigned long long GraphicsMathGroup::parenthesisCacheMisses() {
+        return parenthesisCacheMissCount;
+    }
+
+
     void GraphicsMathGroup::setLeftParenthesisStyle(GraphicsMathGroup::ParenthesisStyle newParenthesisStyle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLeftParenthesisStyle = newParenthesisStyle;
-        update();
     }
 
 
@@ -69,8 +119,11 @@ namespace EQt {
 
 
     void GraphicsMathGroup::setLeftParenthesisBoundingRectangle(const QRectF& parenthesisBoundingRectangle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLeftParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
@@ -83,15 +136,21 @@ namespace EQt {
             GraphicsMathGroup::ParenthesisStyle newParenthesisStyle,
             const QRectF&                       parenthesisBoundingRectangle
         ) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLeftParenthesisStyle             = newParenthesisStyle;
         currentLeftParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroup::setRightParenthesisStyle(GraphicsMathGroup::ParenthesisStyle newParenthesisStyle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentRightParenthesisStyle = newParenthesisStyle;
-        update();
     }
 
 
@@ -101,8 +160,11 @@ namespace EQt {
 
 
     void GraphicsMathGroup::setRightParenthesisBoundingRectangle(const QRectF& parenthesisBoundingRectangle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentRightParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
@@ -115,15 +177,18 @@ namespace EQt {
             ParenthesisStyle newParenthesisStyle,
             const QRectF&    parenthesisBoundingRectangle
         ) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentRightParenthesisStyle             = newParenthesisStyle;
         currentRightParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroup::setParenthesisCenterLine(float newCenterLine) {
         currentParenthesisCenterLine = newCenterLine;
-        update();
+        requestUpdate();
     }
 
 
@@ -133,8 +198,11 @@ namespace EQt {
 
 
     void GraphicsMathGroup::setBottomParenthesisStyle(ParenthesisStyle newParenthesisStyle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentBottomParenthesisStyle = newParenthesisStyle;
-        update();
     }
 
 
@@ -144,8 +212,11 @@ namespace EQt {
 
 
     void GraphicsMathGroup::setBottomParenthesisBoundingRectangle(const QRectF& parenthesisBoundingRectangle) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentBottomParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
@@ -158,15 +229,18 @@ namespace EQt {
             GraphicsMathGroup::ParenthesisStyle newParenthesisStyle,
             const QRectF&                       parenthesisBoundingRectangle
         ) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentBottomParenthesisStyle             = newParenthesisStyle;
         currentBottomParenthesisBoundingRectangle = parenthesisBoundingRectangle;
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroup::setParenthesisPen(const QPen& newPen) {
         currentParenthesisPen = newPen;
-        update();
+        requestUpdate();
     }
 
 
@@ -177,7 +251,7 @@ namespace EQt {
 
     void GraphicsMathGroup::setParenthesisBrush(const QBrush& newBrush) {
         currentParenthesisBrush = newBrush;
-        update();
+        requestUpdate();
     }
 
 
@@ -297,33 +371,19 @@ namespace EQt {
                 break;
             }
 
-            case ParenthesisStyle::PARENTHESIS: {
-                drawNormalizedCurvedParenthesis(painter, transform, heightToWidth);
-                break;
-            }
-
-            case ParenthesisStyle::BRACKETS: {
-                drawNormalizedBracket(painter, transform, heightToWidth);
-                break;
-            }
-
-            case ParenthesisStyle::BRACES: {
-                drawNormalizedBrace(painter, transform, heightToWidth, centerLine);
-                break;
-            }
-
-            case ParenthesisStyle::FLOOR: {
-                drawNormalizedFloor(painter, transform, heightToWidth);
-                break;
-            }
-
+            case ParenthesisStyle::PARENTHESIS:
+            case ParenthesisStyle::BRACKETS:
+            case ParenthesisStyle::BRACES:
+            case ParenthesisStyle::FLOOR:
             case ParenthesisStyle::CEILING: {
-                drawNormalizedCeiling(painter, transform, heightToWidth);
+                QPainterPath path = normalizedParenthesisPath(parenthesisStyle, heightToWidth, centerLine);
+                painter->drawPath(transform.map(path));
                 break;
             }
 
             case ParenthesisStyle::ABSOLUTE_VALUE: {
-                drawNormalizedAbsoluteValue(painter, transform, heightToWidth);
+                QRectF rectangle(0.45F, 0.0F, 0.1F, 1.0F);
+                painter->drawRect(transform.mapRect(rectangle));
                 break;
             }
 
@@ -335,11 +395,88 @@ namespace EQt {
     }
 
 
-    void GraphicsMathGroup::drawNormalizedCurvedParenthesis(
-            QPainter*         painter,
-            const QTransform& transform,
-            float             heightToWidth
+    QPainterPath GraphicsMathGroup::normalizedParenthesisPath(
+            ParenthesisStyle parenthesisStyle,
+            float            heightToWidth,
+            float            centerLine
         ) {
+        // Quantize the shape parameters so that parenthesis with nearly identical shapes share a cache entry.  Paths
+        // are always built from the quantized values so a cached path is identical to a freshly built one.
+
+        quint32 quantizedHeightToWidth = static_cast<quint32>(
+            std::min(
+                static_cast<float>(0x00FFFFFF),
+                std::max(1.0F, std::round(heightToWidth * heightToWidthQuantization))
+            )
+        );
+
+        quint32 quantizedCenterLine;
+        if (parenthesisStyle == ParenthesisStyle::BRACES && centerLine > 0.0F) {
+            quantizedCenterLine = static_cast<quint32>(
+                std::min(static_cast<float>(0x00FFFFFF), std::round(centerLine * centerLineQuantization))
+            );
+        } else {
+            quantizedCenterLine = 0;
+        }
+
+        quint64 key = (
+              (static_cast<quint64>(parenthesisStyle) << 56)
+            | (static_cast<quint64>(quantizedHeightToWidth) << 24)
+            | static_cast<quint64>(quantizedCenterLine)
+        );
+
+        QPainterPath  result;
+        QPainterPath* cachedPath = parenthesisPathCache.object(key);
+
+        if (cachedPath != Q_NULLPTR) {
+            ++parenthesisCacheHitCount;
+            result = *cachedPath;
+        } else {
+            ++parenthesisCacheMissCount;
+
+            float cacheHeightToWidth = quantizedHeightToWidth / heightToWidthQuantization;
+            float cacheCenterLine    = quantizedCenterLine / centerLineQuantization;
+
+            switch (parenthesisStyle) {
+                case ParenthesisStyle::PARENTHESIS: {
+                    result = normalizedCurvedParenthesis(cacheHeightToWidth);
+                    break;
+                }
+
+                case ParenthesisStyle::BRACKETS: {
+                    result = normalizedBracket(cacheHeightToWidth);
+                    break;
+                }
+
+                case ParenthesisStyle::BRACES: {
+                    result = normalizedBrace(cacheHeightToWidth, cacheCenterLine);
+                    break;
+                }
+
+                case ParenthesisStyle::FLOOR: {
+                    result = normalizedFloor(cacheHeightToWidth);
+                    break;
+                }
+
+                case ParenthesisStyle::CEILING: {
+                    result = normalizedCeiling(cacheHeightToWidth);
+                    break;
+                }
+
+                default: {
+                    Q_ASSERT(false);
+                    break;
+                }
+            }
+
+            parenthesisPathCache.insert(key, new QPainterPath(result));
+        }
+
+        return result;
+    }
+
+
+    QPainterPath GraphicsMathGroup::normalizedCurvedParenthesis(float heightToWidth) {
         QPainterPath painterPath(QPointF(1.0F, 0.0F));
 
         float widthToHeight       = 1.0F / heightToWidth;
@@ -359,15 +496,11 @@ namespace EQt {
             painterPath.quadTo(QPointF(0.1F, 0.25F), QPointF(1.0F, 0.0F));
         }
 
-        painter->drawPath(transform.map(painterPath));
+        return painterPath;
     }
 
 
-    void GraphicsMathGroup::drawNormalizedBracket(
-            QPainter*         painter,
-            const QTransform& transform,
-            float             heightToWidth
-        ) {
+    QPainterPath GraphicsMathGroup::normalizedBracket(float heightToWidth) {
         QPainterPath painterPath(QPointF(1.0F, 0.0F));
 
         float verticalWidth = 0.1 / heightToWidth;
@@ -381,16 +514,11 @@ namespace EQt {
         painterPath.lineTo(QPointF(1.0F, verticalWidth));
         painterPath.lineTo(QPointF(1.0F, 0.0F));
 
-        painter->drawPath(transform.map(painterPath));
+        return painterPath;
     }
 
 
-    void GraphicsMathGroup::drawNormalizedBrace(
-            QPainter*         painter,
-            const QTransform& transform,
-            float             heightToWidth,
-            float             centerLine
-        ) {
+    QPainterPath GraphicsMathGroup::normalizedBrace(float heightToWidth, float centerLine) {
         if (centerLine <= 0.0F) {
             centerLine = 0.5F;
         }
@@ -415,11 +543,11 @@ namespace EQt {
         painterPath.lineTo(QPointF(0.55F, widthToHeight));
         painterPath.quadTo(QPointF(0.55F, 0.0F), QPointF(1.0F, 0.0F));
 
-        painter->drawPath(transform.map(painterPath));
+        return painterPath;
     }
 
 
-    void GraphicsMathGroup::drawNormalizedFloor(QPainter* painter, const QTransform& transform, float heightToWidth) {
+    QPainterPath GraphicsMathGroup::normalizedFloor(float heightToWidth) {
         QPainterPath painterPath(QPointF(0.0F, 0.0F));
 
         float verticalWidth = 0.1 / heightToWidth;
@@ -431,15 +559,11 @@ namespace EQt {
         painterPath.lineTo(QPointF(0.1F, 0.0F));
         painterPath.lineTo(QPointF(0.0F, 0.0F));
 
-        painter->drawPath(transform.map(painterPath));
+        return painterPath;
     }
 
 
-    void GraphicsMathGroup::drawNormalizedCeiling(
-            QPainter*         painter,
-            const QTransform& transform,
-            float             heightToWidth
-        ) {
+    QPainterPath GraphicsMathGroup::normalizedCeiling(float heightToWidth) {
         QPainterPath painterPath(QPointF(1.0F, 0.0F));
 
         float verticalWidth = 0.1 / heightToWidth;
@@ -451,16 +575,6 @@ namespace EQt {
         painterPath.lineTo(QPointF(1.0F, verticalWidth));
         painterPath.lineTo(QPointF(1.1F, 0.0F));
 
-        painter->drawPath(transform.map(painterPath));
-    }
-
-
-    void GraphicsMathGroup::drawNormalizedAbsoluteValue(
-            QPainter*         painter,
-            const QTransform& transform,
-            float             /* heightToWidth */
-        ) {
-        QRectF rectangle(0.45F, 0.0F, 0.1F, 1.0F);
-        painter->drawRect(transform.mapRect(rectangle));
+        return painterPath;
     }
 }
@@ -54,45 +54,66 @@ namespace EQt {
 
 
     void GraphicsMathGroupWithLine::setLine(const QLineF& newLine) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine = newLine;
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setLine(const QPointF& p1, const QPointF& p2) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine.setP1(p1);
         currentLine.setP2(p2);
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setLine(float x1, float y1, float x2, float y2) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine = QLineF(x1, y1, x2, y2);
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setP1(const QPointF& newPosition) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine.setP1(newPosition);
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setP1(float x, float y) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine.setP1(QPointF(x, y));
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setP2(const QPointF& newPosition) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine.setP2(newPosition);
-        prepareGeometryChange();
     }
 
 
     void GraphicsMathGroupWithLine::setP2(float x, float y) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentLine.setP2(QPointF(x, y));
-        prepareGeometryChange();
     }
 
 
@@ -133,7 +154,7 @@ namespace EQt {
 
     void GraphicsMathGroupWithLine::setLinePen(const QPen& pen) {
         currentLinePen = pen;
-        update();
+        requestUpdate();
     }
 
 
@@ -51,8 +51,11 @@ namespace EQt {
 
 
     void GraphicsMathGroupWithPainterPath::setPainterPath(const QPainterPath& newPainterPath) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
         currentPainterPath = newPainterPath;
-        prepareGeometryChange();
     }
 
 
@@ -63,7 +66,7 @@ namespace EQt {
 
     void GraphicsMathGroupWithPainterPath::setPainterPathPen(const QPen& newPen) {
         currentPainterPathPen = newPen;
-        update();
+        requestUpdate();
     }
 
 
@@ -74,7 +77,7 @@ namespace EQt {
 
     void GraphicsMathGroupWithPainterPath::setPainterPathBrush(const QBrush& newBrush) {
         currentPainterPathBrush = newBrush;
-        update();
+        requestUpdate();
     }
 
 
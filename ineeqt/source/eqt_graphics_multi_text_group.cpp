@@ -27,14 +27,27 @@
 
 #include <QGraphicsItemGroup>
 #include <QWidget>
-#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
 #include <QBrush>
 #include <QPen>
 #include <QPointF>
 #include <QPainter>
 #include <QFontMetricsF>
 #include <QFontMetrics>
-
+#include <QStaticText>
+#include <QTextLayout>
+#include <QTextLine>
+#include <QTransform>
+#include <QPaintDevice>
+#include <QString>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <utility>
 #include <cmath>
 
 #include "eqt_graphics_item_group.h"
@@ -46,31 +59,68 @@
 
 namespace EQt {
     GraphicsMultiTextGroup::TextEntry::TextEntry() {
-        itemGroup = Q_NULLPTR;
+        currentFontIndex     = internFont(QFont());
+        currentLayoutIsValid = false;
+        itemGroup            = Q_NULLPTR;
     }
 
 
     GraphicsMultiTextGroup::TextEntry::TextEntry(const QString& text, const QFont& font, const QPointF& position) {
-        currentText     = text;
-        currentFont     = font;
-        currentPosition = position;
-        itemGroup       = Q_NULLPTR;
+        currentText          = text;
+        currentFontIndex     = internFont(font);
+        currentPosition      = position;
+        currentLayoutIsValid = false;
+        itemGroup            = Q_NULLPTR;
     }
 
 
     GraphicsMultiTextGroup::TextEntry::TextEntry(const QString& text, const QFont& font, double x, double y) {
-        currentText     = text;
-        currentFont     = font;
-        currentPosition = QPointF(x, y);
-        itemGroup       = Q_NULLPTR;
+        currentText          = text;
+        currentFontIndex     = internFont(font);
+        currentPosition      = QPointF(x, y);
+        currentLayoutIsValid = false;
+        itemGroup            = Q_NULLPTR;
+    }
+
+
+    GraphicsMultiTextGroup::TextEntry::TextEntry(QString&& text, unsigned fontIndex, const QPointF& position) {
+        currentText          = std::move(text);
+        currentFontIndex     = fontIndex;
+        currentPosition      = position;
+        currentLayoutIsValid = false;
+        itemGroup            = Q_NULLPTR;
     }
 
 
     GraphicsMultiTextGroup::TextEntry::TextEntry(const GraphicsMultiTextGroup::TextEntry& other) {
-        currentText     = other.currentText;
-        currentFont     = other.currentFont;
-        currentPosition = other.currentPosition;
-        itemGroup       = Q_NULLPTR;
+        currentText          = other.currentText;
+        currentFontIndex     = other.currentFontIndex;
+        currentPosition      = other.currentPosition;
+        currentLayoutIsValid = other.currentLayoutIsValid;
+        currentStaticText    = other.currentStaticText;
+        currentTextWidth     = other.currentTextWidth;
+        currentTextAscent    = other.currentTextAscent;
+        currentTextHeight    = other.currentTextHeight;
+        itemGroup            = Q_NULLPTR;
+
+        currentCharacterEdges = other.currentCharacterEdges;
+    }
+
+
+    GraphicsMultiTextGroup::TextEntry::TextEntry(GraphicsMultiTextGroup::TextEntry&& other) {
+        currentText          = std::move(other.currentText);
+        currentFontIndex     = other.currentFontIndex;
+        currentPosition      = other.currentPosition;
+        currentLayoutIsValid = other.currentLayoutIsValid;
+        currentStaticText    = std::move(other.currentStaticText);
+        currentTextWidth     = other.currentTextWidth;
+        currentTextAscent    = other.currentTextAscent;
+        currentTextHeight    = other.currentTextHeight;
+        itemGroup            = Q_NULLPTR;
+
+        currentCharacterEdges = std::move(other.currentCharacterEdges);
+
+        other.currentLayoutIsValid = false;
     }
 
 
@@ -78,8 +128,12 @@ namespace EQt {
 
 
     void GraphicsMultiTextGroup::TextEntry::setText(const QString& newText) {
-        currentText = newText;
-        triggerUpdates();
+        QRectF oldBoundingRectangle = itemGroup != Q_NULLPTR ? boundingRect() : QRectF();
+
+        currentText          = newText;
+        currentLayoutIsValid = false;
+
+        triggerUpdates(oldBoundingRectangle);
     }
 
 
@@ -89,25 +143,38 @@ namespace EQt {
 
 
     void GraphicsMultiTextGroup::TextEntry::setFont(const QFont& newFont) {
-        currentFont = newFont;
-        triggerUpdates();
+        unsigned newFontIndex = internFont(newFont);
+        if (newFontIndex != currentFontIndex) {
+            QRectF oldBoundingRectangle = itemGroup != Q_NULLPTR ? boundingRect() : QRectF();
+
+            currentFontIndex     = newFontIndex;
+            currentLayoutIsValid = false;
+
+            triggerUpdates(oldBoundingRectangle);
+        }
     }
 
 
     const QFont& GraphicsMultiTextGroup::TextEntry::font() const {
-        return currentFont;
+        return internedFont(currentFontIndex);
+    }
+
+
+    unsigned GraphicsMultiTextGroup::TextEntry::fontIndex() const {
+        return currentFontIndex;
     }
 
 
     void GraphicsMultiTextGroup::TextEntry::setPosition(const QPointF& newPosition) {
+        QRectF oldBoundingRectangle = itemGroup != Q_NULLPTR ? boundingRect() : QRectF();
+
         currentPosition = newPosition;
-        triggerUpdates();
+        triggerUpdates(oldBoundingRectangle);
     }
 
 
     void GraphicsMultiTextGroup::TextEntry::setPosition(double x, double y) {
         setPosition(QPointF(x, y));
-        triggerUpdates();
     }
 
 
@@ -116,22 +183,142 @@ namespace EQt {
     }
 
 
+    QRectF GraphicsMultiTextGroup::TextEntry::boundingRect() const {
+        updateLayout();
+        return QRectF(
+            currentPosition.x(),
+            currentPosition.y() - currentTextAscent,
+            currentTextWidth,
+            currentTextHeight
+        );
+    }
+
+
+    unsigned GraphicsMultiTextGroup::TextEntry::characterOffsetAt(double x) const {
+        const QVector<double>& edges = characterEdges();
+
+        double                          relativeX    = x - currentPosition.x();
+        QVector<double>::const_iterator edgeIterator = std::lower_bound(
+            edges.constBegin(),
+            edges.constEnd(),
+            relativeX
+        );
+        unsigned                        result;
+
+        if (edgeIterator == edges.constBegin()) {
+            result = 0;
+        } else if (edgeIterator == edges.constEnd()) {
+            result = static_cast<unsigned>(edges.size() - 1);
+        } else {
+            result = static_cast<unsigned>(edgeIterator - edges.constBegin());
+            if (relativeX - *(edgeIterator - 1) < *edgeIterator - relativeX) {
+                --result;
+            }
+        }
+
+        return result;
+    }
+
+
     GraphicsMultiTextGroup::TextEntry& GraphicsMultiTextGroup::TextEntry::operator=(
             const GraphicsMultiTextGroup::TextEntry& other
         ) {
-        currentText     = other.currentText;
-        currentFont     = other.currentFont;
-        currentPosition = other.currentPosition;
+        currentText          = other.currentText;
+        currentFontIndex     = other.currentFontIndex;
+        currentPosition      = other.currentPosition;
+        currentLayoutIsValid = other.currentLayoutIsValid;
+        currentStaticText    = other.currentStaticText;
+        currentTextWidth     = other.currentTextWidth;
+        currentTextAscent    = other.currentTextAscent;
+        currentTextHeight    = other.currentTextHeight;
+
+        currentCharacterEdges = other.currentCharacterEdges;
+
+        return *this;
+    }
+
+
+    GraphicsMultiTextGroup::TextEntry& GraphicsMultiTextGroup::TextEntry::operator=(
+            GraphicsMultiTextGroup::TextEntry&& other
+        ) {
+        currentText          = std::move(other.currentText);
+        currentFontIndex     = other.currentFontIndex;
+        currentPosition      = other.currentPosition;
+        currentLayoutIsValid = other.currentLayoutIsValid;
+        currentStaticText    = std::move(other.currentStaticText);
+        currentTextWidth     = other.currentTextWidth;
+        currentTextAscent    = other.currentTextAscent;
+        currentTextHeight    = other.currentTextHeight;
+
+        currentCharacterEdges = std::move(other.currentCharacterEdges);
+
+        other.currentLayoutIsValid = false;
 
         return *this;
     }
 
 
-    void GraphicsMultiTextGroup::TextEntry::triggerUpdates() {
+    void GraphicsMultiTextGroup::TextEntry::triggerUpdates(const QRectF& oldBoundingRectangle) {
         if (itemGroup != Q_NULLPTR) {
-            itemGroup->updateGeometryNeeded();
-            itemGroup->update();
+            itemGroup->textEntryChanged(oldBoundingRectangle, boundingRect());
+        }
+    }
+
+
+    void GraphicsMultiTextGroup::TextEntry::updateLayout() const {
+        if (!currentLayoutIsValid) {
+            const QFont& entryFont = internedFont(currentFontIndex);
+
+            QFontMetricsF fontMetrics(entryFont);
+            currentTextWidth  = fontMetrics.horizontalAdvance(currentText);
+            currentTextAscent = fontMetrics.ascent();
+            currentTextHeight = fontMetrics.height();
+
+            currentStaticText.setText(currentText);
+            currentStaticText.setTextFormat(Qt::PlainText);
+            currentStaticText.prepare(QTransform(), entryFont);
+
+            currentCharacterEdges.clear();
+            currentLayoutIsValid = true;
+        }
+    }
+
+
+    const QStaticText& GraphicsMultiTextGroup::TextEntry::staticText() const {
+        updateLayout();
+        return currentStaticText;
+    }
+
+
+    const QVector<double>& GraphicsMultiTextGroup::TextEntry::characterEdges() const {
+        updateLayout();
+
+        if (currentCharacterEdges.isEmpty()) {
+            // A single layout pass gives every cursor position, including the effects of kerning and shaping, in
+            // linear time.
+
+            QTextLayout layout(currentText, internedFont(currentFontIndex));
+            layout.beginLayout();
+            QTextLine line = layout.createLine();
+            layout.endLayout();
+
+            unsigned numberCursorPositions = static_cast<unsigned>(currentText.size()) + 1;
+            currentCharacterEdges.reserve(numberCursorPositions);
+
+            double lastEdge = 0;
+            for (unsigned cursorPosition=0 ; cursorPosition<numberCursorPositions ; ++cursorPosition) {
+                if (line.isValid()) {
+                    // Positions inside surrogate pairs are not valid cursor positions.  Keep the edges monotonic so
+                    // they can be searched.
+
+                    lastEdge = std::max(lastEdge, line.cursorToX(static_cast<int>(cursorPosition)));
+                }
+
+                currentCharacterEdges.append(lastEdge);
+            }
         }
+
+        return currentCharacterEdges;
     }
 }
 
@@ -140,10 +327,27 @@ namespace EQt {
  */
 
 namespace EQt {
+    const unsigned GraphicsMultiTextGroup::fontFitCacheSize = 16384;
+    const unsigned GraphicsMultiTextGroup::noTextEntry      = static_cast<unsigned>(-1);
+
+    static QVector<QFont*>        internedFonts;
+    static QHash<QFont, unsigned> internedFontIndexes;
+    static QMutex                 internedFontMutex;
+
+    static QCache<QString, int> fontFitCache(GraphicsMultiTextGroup::fontFitCacheSize);
+    static QMutex               fontFitCacheMutex;
+
     GraphicsMultiTextGroup::GraphicsMultiTextGroup() {
         currentBackgroundBrush = QBrush(QColor(255, 255, 255, 0));
         currentBorderPen       = QPen(Qt::NoPen);
         currentTextPen         = QPen(QColor(Qt::black));
+
+        currentTextBoundingRectangleIsValid = true;
+        currentHitTestIndexIsValid          = false;
+        currentHitTestColumns               = 0;
+        currentHitTestRows                  = 0;
+        currentHitTestCellWidth             = 0;
+        currentHitTestCellHeight            = 0;
     }
 
 
@@ -155,27 +359,9 @@ namespace EQt {
     }
 
 
-    void GraphicsMultiTextGroup::deferUpdates() {
-        currentUpdatesAreDeferred = true;
-    }
-
-
-    void GraphicsMultiTextGroup::restoreUpdates() {
-        if (currentUpdatesAreDeferred) {
-            currentUpdatesAreDeferred = false;
-            prepareGeometryChange();
-        }
-    }
-
-
-    bool GraphicsMultiTextGroup::updatesAreDeferred() const {
-        return currentUpdatesAreDeferred;
-    }
-
-
     void GraphicsMultiTextGroup::setBackgroundBrush(const QBrush& newBrush) {
         currentBackgroundBrush = newBrush;
-        update();
+        requestUpdate();
     }
 
 
@@ -186,7 +372,7 @@ namespace EQt {
 
     void GraphicsMultiTextGroup::setBorderPen(const QPen& newPen) {
         currentBorderPen = newPen;
-        update();
+        requestUpdate();
     }
 
 
@@ -197,7 +383,7 @@ namespace EQt {
 
     void GraphicsMultiTextGroup::setTextPen(const QPen& newPen) {
         currentTextPen = newPen;
-        update();
+        requestUpdate();
     }
 
 
@@ -207,50 +393,62 @@ namespace EQt {
 
 
     void GraphicsMultiTextGroup::clearText() {
-        currentTextEntries.clear();
+        if (!currentTextEntries.isEmpty()) {
+            prepareTextGeometryChange();
+
+            currentTextEntries.clear();
+            currentTextBoundingRectangle        = QRectF();
+            currentTextBoundingRectangleIsValid = true;
 
-        updateGeometryNeeded();
-        update();
+            requestUpdate();
+        }
     }
 
 
     void GraphicsMultiTextGroup::removeFirst() {
+        QRectF oldBoundingRectangle = currentTextEntries.first().boundingRect();
         currentTextEntries.removeFirst();
 
-        updateGeometryNeeded();
-        update();
+        textEntryRemoved(oldBoundingRectangle);
     }
 
 
     void GraphicsMultiTextGroup::removeLast() {
+        QRectF oldBoundingRectangle = currentTextEntries.last().boundingRect();
         currentTextEntries.removeLast();
 
-        updateGeometryNeeded();
-        update();
+        textEntryRemoved(oldBoundingRectangle);
     }
 
 
     void GraphicsMultiTextGroup::removeAt(unsigned index) {
+        QRectF oldBoundingRectangle = currentTextEntries.at(index).boundingRect();
         currentTextEntries.removeAt(index);
 
-        updateGeometryNeeded();
-        update();
+        textEntryRemoved(oldBoundingRectangle);
     }
 
 
     void GraphicsMultiTextGroup::setNumberEntries(unsigned newNumberEntries) {
         if (newNumberEntries < static_cast<unsigned>(currentTextEntries.size())) {
+            prepareTextGeometryChange();
+
             currentTextEntries.erase(currentTextEntries.begin() + newNumberEntries, currentTextEntries.end());
+            currentTextBoundingRectangleIsValid = false;
+
+            requestUpdate();
         }
     }
 
 
     void GraphicsMultiTextGroup::append(const GraphicsMultiTextGroup::TextEntry& newEntry) {
+        const TextEntry* oldData = currentTextEntries.constData();
         currentTextEntries.append(newEntry);
-        currentTextEntries.last().itemGroup = this;
 
-        updateGeometryNeeded();
-        update();
+        attachEntries(
+            currentTextEntries.constData() == oldData ? static_cast<unsigned>(currentTextEntries.size() - 1) : 0
+        );
+        textEntryAdded(currentTextEntries.last().boundingRect());
     }
 
 
@@ -259,12 +457,52 @@ namespace EQt {
     }
 
 
+    void GraphicsMultiTextGroup::append(GraphicsMultiTextGroup::TextEntries&& newEntries) {
+        if (!newEntries.isEmpty()) {
+            prepareTextGeometryChange();
+
+            unsigned               firstNewIndex = static_cast<unsigned>(currentTextEntries.size());
+            TextEntries::size_type requiredSize  = currentTextEntries.size() + newEntries.size();
+            const TextEntry*       oldData;
+
+            if (requiredSize > currentTextEntries.capacity()) {
+                currentTextEntries.reserve(
+                    std::max(requiredSize, static_cast<TextEntries::size_type>(2 * currentTextEntries.capacity()))
+                );
+            }
+
+            oldData = currentTextEntries.constData();
+            for (  TextEntries::iterator newEntryIterator    = newEntries.begin(),
+                                         newEntryEndIterator = newEntries.end()
+                 ; newEntryIterator != newEntryEndIterator
+                 ; ++newEntryIterator
+                ) {
+                currentTextEntries.append(std::move(*newEntryIterator));
+            }
+
+            newEntries.clear();
+            attachEntries(currentTextEntries.constData() == oldData ? firstNewIndex : 0);
+
+            if (currentTextBoundingRectangleIsValid) {
+                for (  TextEntries::const_iterator entryIterator    = currentTextEntries.constBegin() + firstNewIndex,
+                                                   entryEndIterator = currentTextEntries.constEnd()
+                     ; entryIterator != entryEndIterator
+                     ; ++entryIterator
+                    ) {
+                    currentTextBoundingRectangle |= entryIterator->boundingRect();
+                }
+            }
+
+            requestUpdate();
+        }
+    }
+
+
     void GraphicsMultiTextGroup::prepend(const GraphicsMultiTextGroup::TextEntry& newEntry) {
         currentTextEntries.prepend(newEntry);
-        currentTextEntries.first().itemGroup = this;
 
-        updateGeometryNeeded();
-        update();
+        attachEntries(0);
+        textEntryAdded(currentTextEntries.first().boundingRect());
     }
 
 
@@ -318,6 +556,77 @@ namespace EQt {
     }
 
 
+    unsigned GraphicsMultiTextGroup::textEntryAt(const QPointF& position) const {
+        unsigned result = noTextEntry;
+
+        if (!currentTextEntries.isEmpty()) {
+            updateHitTestIndex();
+
+            if (currentHitTestBounds.contains(position)) {
+                // Cell entries are in ascending order so the first hit, walking backwards, was painted last.
+
+                unsigned cellIndex  = hitTestRow(position.y()) * currentHitTestColumns + hitTestColumn(position.x());
+                unsigned firstEntry = currentHitTestCellStarts.at(cellIndex);
+                unsigned index      = currentHitTestCellStarts.at(cellIndex + 1);
+
+                while (result == noTextEntry && index > firstEntry) {
+                    --index;
+
+                    unsigned entryIndex = currentHitTestCellEntries.at(index);
+                    if (currentTextEntries.at(entryIndex).boundingRect().contains(position)) {
+                        result = entryIndex;
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    bool GraphicsMultiTextGroup::textPositionAt(
+            const QPointF& position,
+            unsigned&      entryIndex,
+            unsigned&      characterOffset
+        ) const {
+        bool     success;
+        unsigned index = textEntryAt(position);
+
+        if (index == noTextEntry) {
+            success = false;
+        } else {
+            entryIndex      = index;
+            characterOffset = currentTextEntries.at(index).characterOffsetAt(position.x());
+            success         = true;
+        }
+
+        return success;
+    }
+
+
+    unsigned GraphicsMultiTextGroup::internFont(const QFont& font) {
+        unsigned     result;
+        QMutexLocker locker(&internedFontMutex);
+
+        QHash<QFont, unsigned>::const_iterator it = internedFontIndexes.constFind(font);
+        if (it != internedFontIndexes.constEnd()) {
+            result = it.value();
+        } else {
+            result = static_cast<unsigned>(internedFonts.size());
+            internedFonts.append(new QFont(font));
+            internedFontIndexes.insert(font, result);
+        }
+
+        return result;
+    }
+
+
+    const QFont& GraphicsMultiTextGroup::internedFont(unsigned fontIndex) {
+        QMutexLocker locker(&internedFontMutex);
+        return *internedFonts.at(fontIndex);
+    }
+
+
     QRectF GraphicsMultiTextGroup::boundingRect() const {
         QRectF result;
 
@@ -326,35 +635,19 @@ namespace EQt {
         } else if (currentTextEntries.isEmpty()) {
             result = childrenBoundingRect();
         } else {
-            if (currentTextBoundingRectangle.isNull()) {
-                QList<TextEntry>::const_iterator textEntryIterator    = currentTextEntries.constBegin();
-                QList<TextEntry>::const_iterator textEntryEndIterator = currentTextEntries.constEnd();
-
-                const TextEntry& entry    = *textEntryIterator;
-                const QString&   text     = entry.text();
-                const QFont&     font     = entry.font();
-                const QPointF&   position = entry.position();
+            if (!currentTextBoundingRectangleIsValid) {
+                TextEntries::const_iterator textEntryIterator    = currentTextEntries.constBegin();
+                TextEntries::const_iterator textEntryEndIterator = currentTextEntries.constEnd();
 
-                QFontMetricsF fontMetrics(font);
-                currentTextBoundingRectangle.setTopLeft(QPointF(position.x(), position.y() - fontMetrics.ascent()));
-                currentTextBoundingRectangle.setWidth(fontMetrics.horizontalAdvance(text));
-                currentTextBoundingRectangle.setHeight(fontMetrics.height());
+                currentTextBoundingRectangle = textEntryIterator->boundingRect();
 
                 ++textEntryIterator;
                 while (textEntryIterator != textEntryEndIterator) {
-                    const TextEntry& entry    = *textEntryIterator;
-                    const QString&   text     = entry.text();
-                    const QFont&     font     = entry.font();
-                    const QPointF&   position = entry.position();
-
-                    QFontMetricsF fontMetrics(font);
-                    currentTextBoundingRectangle |= QRectF(
-                        QPointF(position.x(), position.y() - fontMetrics.ascent()),
-                        QSizeF(fontMetrics.horizontalAdvance(text), fontMetrics.height())
-                    );
-
+                    currentTextBoundingRectangle |= textEntryIterator->boundingRect();
                     ++textEntryIterator;
                 }
+
+                currentTextBoundingRectangleIsValid = true;
             }
 
             result = currentTextBoundingRectangle | childrenBoundingRect();
@@ -378,7 +671,7 @@ namespace EQt {
         QPaintDevice* device             = painter->device();
         bool          convertToPixelSize = dynamic_cast<QWidget*>(device) == Q_NULLPTR;
 
-        for (  QList<TextEntry>::const_iterator textEntryIterator    = currentTextEntries.constBegin(),
+        for (  TextEntries::const_iterator textEntryIterator    = currentTextEntries.constBegin(),
                                                 textEntryEndIterator = currentTextEntries.constEnd()
              ; textEntryIterator != textEntryEndIterator
              ; ++textEntryIterator
@@ -389,49 +682,275 @@ namespace EQt {
             const QFont&     font     = entry.font();
 
             if (convertToPixelSize) {
-                QFontMetricsF fontMetrics(font);
-                unsigned screenHeight = static_cast<unsigned>(fontMetrics.height());
-                float    screenWidth  = fontMetrics.horizontalAdvance(text);
-
                 QFont tweakedFont = QFont(font, device);
-                tweakedFont.setPixelSize(screenHeight);
+                tweakedFont.setPixelSize(fittedPixelSize(font, text, device));
+
+                painter->setFont(tweakedFont);
+                painter->drawText(position, text);
+            } else {
+                // The static text is positioned by its top-left corner rather than its baseline.
+
+                const QStaticText& staticText = entry.staticText();
+                painter->setFont(font);
+                painter->drawStaticText(QPointF(position.x(), position.y() - entry.currentTextAscent), staticText);
+            }
+        }
+    }
+
+
+    int GraphicsMultiTextGroup::fittedPixelSize(const QFont& font, const QString& text, QPaintDevice* device) {
+        QString key = (
+              QString("%1|%2|%3|").arg(font.key()).arg(device->logicalDpiX()).arg(device->logicalDpiY())
+            + text
+        );
+
+        QMutexLocker locker(&fontFitCacheMutex);
+
+        int* cachedPixelSize = fontFitCache.object(key);
+        int  result;
+
+        if (cachedPixelSize != Q_NULLPTR) {
+            result = *cachedPixelSize;
+        } else {
+            QFontMetricsF fontMetrics(font);
+            int           screenHeight = std::max(1, static_cast<int>(fontMetrics.height()));
+            double        screenWidth  = fontMetrics.horizontalAdvance(text);
 
-                unsigned smallerHeight = screenHeight;
-                float    smallerWidth  = QFontMetricsF(tweakedFont).horizontalAdvance(text);
-                unsigned biggerHeight  = smallerHeight;
-                float    biggerWidth   = smallerWidth;
+            QFont tweakedFont = QFont(font, device);
 
-                while (smallerWidth > screenWidth) {
-                    biggerHeight = smallerHeight;
-                    biggerWidth = smallerWidth;
+            // Find the largest pixel size whose rendered width does not exceed the screen width, then pick between
+            // that size and the next larger size based on which is closer to the screen width.
 
-                    --smallerHeight;
+            tweakedFont.setPixelSize(screenHeight);
+            double screenHeightWidth = QFontMetricsF(tweakedFont).horizontalAdvance(text);
 
-                    tweakedFont.setPixelSize(smallerHeight);
-                    smallerWidth = QFontMetricsF(tweakedFont).horizontalAdvance(text);
+            if (screenHeightWidth <= screenWidth) {
+                result = screenHeight;
+            } else {
+                int    smallerHeight = 1;
+                int    biggerHeight  = screenHeight;
+                double biggerWidth   = screenHeightWidth;
+
+                tweakedFont.setPixelSize(smallerHeight);
+                double smallerWidth = QFontMetricsF(tweakedFont).horizontalAdvance(text);
+
+                if (smallerWidth > screenWidth) {
+                    result = smallerHeight;
+                } else {
+                    while (biggerHeight - smallerHeight > 1) {
+                        int middleHeight = (smallerHeight + biggerHeight) / 2;
+
+                        tweakedFont.setPixelSize(middleHeight);
+                        double middleWidth = QFontMetricsF(tweakedFont).horizontalAdvance(text);
+
+                        if (middleWidth > screenWidth) {
+                            biggerHeight = middleHeight;
+                            biggerWidth  = middleWidth;
+                        } else {
+                            smallerHeight = middleHeight;
+                            smallerWidth  = middleWidth;
+                        }
+                    }
+
+                    if (std::abs(screenWidth - smallerWidth) > std::abs(biggerWidth - screenWidth)) {
+                        result = biggerHeight;
+                    } else {
+                        result = smallerHeight;
+                    }
                 }
+            }
+
+            fontFitCache.insert(key, new int(result));
+        }
+
+        return result;
+    }
+
+
+    void GraphicsMultiTextGroup::attachEntries(unsigned startingIndex) {
+        for (  TextEntries::iterator entryIterator    = currentTextEntries.begin() + startingIndex,
+                                     entryEndIterator = currentTextEntries.end()
+             ; entryIterator != entryEndIterator
+             ; ++entryIterator
+            ) {
+            entryIterator->itemGroup = this;
+        }
+    }
+
+
+    void GraphicsMultiTextGroup::prepareTextGeometryChange() {
+        currentHitTestIndexIsValid = false;
+
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+    }
+
+
+    bool GraphicsMultiTextGroup::touchesTextBoundary(const QRectF& rectangle) const {
+        return (
+               rectangle.left() <= currentTextBoundingRectangle.left()
+            || rectangle.top() <= currentTextBoundingRectangle.top()
+            || rectangle.right() >= currentTextBoundingRectangle.right()
+            || rectangle.bottom() >= currentTextBoundingRectangle.bottom()
+        );
+    }
+
+
+    void GraphicsMultiTextGroup::textEntryAdded(const QRectF& newBoundingRectangle) {
+        prepareTextGeometryChange();
+
+        if (currentTextBoundingRectangleIsValid) {
+            currentTextBoundingRectangle |= newBoundingRectangle;
+        }
+
+        requestUpdate();
+    }
 
-                Q_ASSERT(smallerWidth <= screenWidth);
 
-                if (abs(screenWidth - smallerWidth) > abs(biggerWidth - screenWidth)) {
-                    tweakedFont.setPixelSize(biggerHeight);
+    void GraphicsMultiTextGroup::textEntryRemoved(const QRectF& oldBoundingRectangle) {
+        prepareTextGeometryChange();
+
+        if (currentTextEntries.isEmpty()) {
+            currentTextBoundingRectangle        = QRectF();
+            currentTextBoundingRectangleIsValid = true;
+        } else if (currentTextBoundingRectangleIsValid && touchesTextBoundary(oldBoundingRectangle)) {
+            currentTextBoundingRectangleIsValid = false;
+        }
+
+        requestUpdate();
+    }
+
+
+    void GraphicsMultiTextGroup::textEntryChanged(
+            const QRectF& oldBoundingRectangle,
+            const QRectF& newBoundingRectangle
+        ) {
+        if (oldBoundingRectangle != newBoundingRectangle) {
+            prepareTextGeometryChange();
+
+            if (currentTextBoundingRectangleIsValid) {
+                if (touchesTextBoundary(oldBoundingRectangle)             &&
+                    !newBoundingRectangle.contains(oldBoundingRectangle)     ) {
+                    // The entry defined part of the boundary and has moved away from it.  Recalculate the boundary
+                    // the next time it is needed.
+                    currentTextBoundingRectangleIsValid = false;
+                } else {
+                    currentTextBoundingRectangle |= newBoundingRectangle;
                 }
+            }
+        }
 
-                painter->setFont(tweakedFont);
+        requestUpdate();
+    }
+
+
+    void GraphicsMultiTextGroup::updateHitTestIndex() const {
+        if (!currentHitTestIndexIsValid) {
+            unsigned numberEntries = static_cast<unsigned>(currentTextEntries.size());
+
+            QVector<QRectF> entryRectangles;
+            entryRectangles.reserve(numberEntries);
+
+            QRectF bounds;
+            for (unsigned entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                QRectF entryRectangle = currentTextEntries.at(entryIndex).boundingRect();
+                entryRectangles.append(entryRectangle);
+                bounds = entryIndex == 0 ? entryRectangle : bounds.united(entryRectangle);
+            }
+
+            // Size the grid for roughly one cell per entry, matching the aspect ratio of the text.
+
+            double width  = bounds.width();
+            double height = bounds.height();
+
+            unsigned columns;
+            unsigned rows;
+            if (width <= 0 || height <= 0) {
+                columns = width  > 0 ? std::max(1U, numberEntries) : 1;
+                rows    = height > 0 ? std::max(1U, numberEntries) : 1;
             } else {
-                painter->setFont(font);
+                double scale       = std::sqrt(numberEntries / (width * height));
+                double columnCount = std::max(1.0, std::ceil(width * scale));
+                double rowCount    = std::max(1.0, std::ceil(height * scale));
+
+                columns = static_cast<unsigned>(std::min<double>(columnCount, numberEntries));
+                rows    = static_cast<unsigned>(std::min<double>(rowCount, numberEntries));
             }
 
-            painter->drawText(position, text);
+            currentHitTestBounds     = bounds;
+            currentHitTestColumns    = columns;
+            currentHitTestRows       = rows;
+            currentHitTestCellWidth  = width / columns;
+            currentHitTestCellHeight = height / rows;
+
+            // Count the entries overlapping each cell, convert the counts to offsets, then fill in the entries.
+
+            unsigned numberCells = columns * rows;
+            currentHitTestCellStarts.fill(0, numberCells + 1);
+
+            for (unsigned entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                const QRectF& entryRectangle = entryRectangles.at(entryIndex);
+
+                unsigned firstColumn = hitTestColumn(entryRectangle.left());
+                unsigned lastColumn  = hitTestColumn(entryRectangle.right());
+                unsigned firstRow    = hitTestRow(entryRectangle.top());
+                unsigned lastRow     = hitTestRow(entryRectangle.bottom());
+
+                for (unsigned row=firstRow ; row<=lastRow ; ++row) {
+                    for (unsigned column=firstColumn ; column<=lastColumn ; ++column) {
+                        ++currentHitTestCellStarts[row * columns + column + 1];
+                    }
+                }
+            }
+
+            for (unsigned cellIndex=0 ; cellIndex<numberCells ; ++cellIndex) {
+                currentHitTestCellStarts[cellIndex + 1] += currentHitTestCellStarts.at(cellIndex);
+            }
+
+            currentHitTestCellEntries.resize(currentHitTestCellStarts.at(numberCells));
+
+            QVector<unsigned> nextSlot = currentHitTestCellStarts;
+            for (unsigned entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                const QRectF& entryRectangle = entryRectangles.at(entryIndex);
+
+                unsigned firstColumn = hitTestColumn(entryRectangle.left());
+                unsigned lastColumn  = hitTestColumn(entryRectangle.right());
+                unsigned firstRow    = hitTestRow(entryRectangle.top());
+                unsigned lastRow     = hitTestRow(entryRectangle.bottom());
+
+                for (unsigned row=firstRow ; row<=lastRow ; ++row) {
+                    for (unsigned column=firstColumn ; column<=lastColumn ; ++column) {
+                        currentHitTestCellEntries[nextSlot[row * columns + column]++] = entryIndex;
+                    }
+                }
+            }
+
+            currentHitTestIndexIsValid = true;
         }
     }
 
 
-    void GraphicsMultiTextGroup::updateGeometryNeeded() {
-        if (!currentUpdatesAreDeferred) {
-            prepareGeometryChange();
-            currentTextBoundingRectangle = QRectF();
+    unsigned GraphicsMultiTextGroup::hitTestColumn(double x) const {
+        unsigned result = 0;
+
+        if (currentHitTestCellWidth > 0) {
+            double column = std::floor((x - currentHitTestBounds.left()) / currentHitTestCellWidth);
+            result = static_cast<unsigned>(std::min<double>(std::max(0.0, column), currentHitTestColumns - 1));
         }
+
+        return result;
     }
-}
 
+
+    unsigned GraphicsMultiTextGroup::hitTestRow(double y) const {
+        unsigned result = 0;
+
+        if (currentHitTestCellHeight > 0) {
+            double row = std::floor((y - currentHitTestBounds.top()) / currentHitTestCellHeight);
+            result = static_cast<unsigned>(std::min<double>(std::max(0.0, row), currentHitTestRows - 1));
+        }
+
+        return result;
+    }
+}
@@ -26,14 +26,29 @@
 ***********************************************************************************************************************/
 
 #include <QPixmap>
+#include <QString>
+#include <QSize>
+#include <QRectF>
+#include <QPointF>
+#include <QColor>
+#include <QPen>
+#include <QPainter>
+#include <QPainterPath>
+#include <QTransform>
 #include <QGraphicsItem>
 #include <QGraphicsPixmapItem>
 
+#include <cmath>
+#include <algorithm>
+
 #include "eqt_graphics_item.h"
+#include "graphics_pixmap_pyramid.h"
 #include "eqt_graphics_pixmap_item.h"
 
 namespace EQt {
-    GraphicsPixmapItem::GraphicsPixmapItem(QGraphicsItem* parent):QGraphicsPixmapItem(parent) {}
+    GraphicsPixmapItem::GraphicsPixmapItem(QGraphicsItem* parent):QGraphicsPixmapItem(parent) {
+        currentPyramid = Q_NULLPTR;
+    }
 
 
     GraphicsPixmapItem::GraphicsPixmapItem(
@@ -42,10 +57,14 @@ namespace EQt {
         ):QGraphicsPixmapItem(
             pixmap,
             parent
-        ) {}
+        ) {
+        currentPyramid = Q_NULLPTR;
+    }
 
 
-    GraphicsPixmapItem::~GraphicsPixmapItem() {}
+    GraphicsPixmapItem::~GraphicsPixmapItem() {
+        delete currentPyramid;
+    }
 
 
     int GraphicsPixmapItem::type() const {
@@ -53,8 +72,143 @@ namespace EQt {
     }
 
 
+    void GraphicsPixmapItem::setImageFile(const QString& filename) {
+        if (reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
+        delete currentPyramid;
+
+        if (filename.isEmpty()) {
+            currentPyramid = Q_NULLPTR;
+        } else {
+            currentPyramid = new GraphicsPixmapPyramid(this, filename);
+        }
+
+        requestUpdate();
+    }
+
+
+    QString GraphicsPixmapItem::imageFile() const {
+        return currentPyramid != Q_NULLPTR ? currentPyramid->filename() : QString();
+    }
+
+
+    bool GraphicsPixmapItem::imageIsLoading() const {
+        return currentPyramid != Q_NULLPTR && currentPyramid->isLoading();
+    }
+
+
+    bool GraphicsPixmapItem::imageLoadFailed() const {
+        return currentPyramid != Q_NULLPTR && currentPyramid->decodeFailed();
+    }
+
+
+    QSize GraphicsPixmapItem::imageLevelSize(double scale) const {
+        return currentPyramid != Q_NULLPTR ? currentPyramid->levelSizeForScale(scale) : QSize(0, 0);
+    }
+
+
+    void GraphicsPixmapItem::setImageMemoryBudget(unsigned newMemoryBudget) {
+        GraphicsPixmapPyramid::setMemoryBudget(newMemoryBudget);
+    }
+
+
+    unsigned GraphicsPixmapItem::imageMemoryBudget() {
+        return GraphicsPixmapPyramid::memoryBudget();
+    }
+
+
+    QRectF GraphicsPixmapItem::boundingRect() const {
+        QRectF result;
+
+        if (currentPyramid != Q_NULLPTR) {
+            QSize imageSize = currentPyramid->imageSize();
+            result = QRectF(offset(), imageSize.isValid() ? QSizeF(imageSize) : QSizeF(0, 0));
+        } else {
+            result = QGraphicsPixmapItem::boundingRect();
+        }
+
+        return result;
+    }
+
+
+    QPainterPath GraphicsPixmapItem::shape() const {
+        QPainterPath result;
+
+        if (currentPyramid != Q_NULLPTR) {
+            result.addRect(boundingRect());
+        } else {
+            result = QGraphicsPixmapItem::shape();
+        }
+
+        return result;
+    }
+
+
+    bool GraphicsPixmapItem::contains(const QPointF& point) const {
+        bool result;
+
+        if (currentPyramid != Q_NULLPTR) {
+            result = boundingRect().contains(point);
+        } else {
+            result = QGraphicsPixmapItem::contains(point);
+        }
+
+        return result;
+    }
+
+
+    void GraphicsPixmapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+        if (currentPyramid == Q_NULLPTR) {
+            QGraphicsPixmapItem::paint(painter, option, widget);
+        } else if (!currentPyramid->decodeFailed()) {
+            QRectF bounds = boundingRect();
+
+            const QTransform& transform = painter->worldTransform();
+            double horizontalScale = std::sqrt(transform.m11() * transform.m11() + transform.m12() * transform.m12());
+            double verticalScale   = std::sqrt(transform.m21() * transform.m21() + transform.m22() * transform.m22());
+            double scale           = (
+                  std::max(horizontalScale, verticalScale)
+                * painter->device()->devicePixelRatioF()
+            );
+
+            QPixmap pixmap = currentPyramid->pixmapForScale(scale);
+            if (pixmap.isNull()) {
+                painter->save();
+                painter->setPen(QPen(QColor(Qt::gray), 0));
+                painter->setBrush(QColor(Qt::lightGray));
+                painter->drawRect(bounds);
+                painter->restore();
+            } else {
+                painter->save();
+                painter->setRenderHint(
+                    QPainter::SmoothPixmapTransform,
+                    transformationMode() == Qt::SmoothTransformation
+                );
+                painter->drawPixmap(bounds, pixmap, QRectF(pixmap.rect()));
+                painter->restore();
+            }
+        }
+    }
+
+
     void GraphicsPixmapItem::removeFromScene() {
         prepareGeometryChange();
         removeGraphicsItemFromScene(this);
     }
+
+
+    void GraphicsPixmapItem::notifyDeferredGeometryChange() {
+        prepareGeometryChange();
+    }
+
+
+    void GraphicsPixmapItem::imageDecoded(bool sizeChanged) {
+        if (sizeChanged && reportGeometryChange()) {
+            prepareGeometryChange();
+        }
+
+        requestUpdate();
+    }
 }
@@ -0,0 +1,162 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::GraphicsRasterCacheEffect class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QGraphicsEffect>
+#include <QPainter>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QSizeF>
+#include <QTransform>
+#include <QWidget>
+
+#include <cmath>
+
+#include "eqt_graphics_raster_cache_effect.h"
+
+namespace EQt {
+    GraphicsRasterCacheEffect::GraphicsRasterCacheEffect(QObject* parent):QGraphicsEffect(parent) {
+        currentInteractionDepth = 0;
+        currentCacheHits        = 0;
+        currentCacheMisses      = 0;
+    }
+
+
+    GraphicsRasterCacheEffect::~GraphicsRasterCacheEffect() {}
+
+
+    void GraphicsRasterCacheEffect::beginInteraction() {
+        ++currentInteractionDepth;
+        if (currentInteractionDepth == 1) {
+            update();
+        }
+    }
+
+
+    void GraphicsRasterCacheEffect::endInteraction() {
+        if (currentInteractionDepth > 0) {
+            --currentInteractionDepth;
+            if (currentInteractionDepth == 0) {
+                update();
+            }
+        }
+    }
+
+
+    bool GraphicsRasterCacheEffect::interactionInProgress() const {
+        return currentInteractionDepth > 0;
+    }
+
+
+    unsigned long long GraphicsRasterCacheEffect::cacheHits() const {
+        return currentCacheHits;
+    }
+
+
+    unsigned long long GraphicsRasterCacheEffect::cacheMisses() const {
+        return currentCacheMisses;
+    }
+
+
+    void GraphicsRasterCacheEffect::resetCacheStatistics() {
+        currentCacheHits   = 0;
+        currentCacheMisses = 0;
+    }
+
+
+    void GraphicsRasterCacheEffect::draw(QPainter* painter) {
+        QWidget* widget = dynamic_cast<QWidget*>(painter->device());
+
+        if (currentInteractionDepth > 0 || widget == Q_NULLPTR) {
+            drawSource(painter);
+        } else {
+            // The pixmap is reused when the view has only been translated by whole pixels, such as by scrolling, and
+            // the pixmap covers the part of the item now visible.  Qt clips the rendered pixmap to the widget.
+
+            const QTransform& transform    = painter->worldTransform();
+            QRectF            sourceBounds = sourceBoundingRect(Qt::LogicalCoordinates);
+            QRect             visibleRect  = transform.mapRect(sourceBounds).toAlignedRect() & widget->rect();
+
+            QPoint offset;
+            bool   cacheHit = false;
+
+            if (!currentPixmap.isNull() && differOnlyByTranslation(transform, currentPixmapTransform)) {
+                double deltaX = transform.dx() - currentPixmapTransform.dx();
+                double deltaY = transform.dy() - currentPixmapTransform.dy();
+
+                double pixelDeltaX = std::round(deltaX);
+                double pixelDeltaY = std::round(deltaY);
+
+                if (std::abs(deltaX - pixelDeltaX) < 1.0E-6 && std::abs(deltaY - pixelDeltaY) < 1.0E-6) {
+                    QSizeF pixmapSize = QSizeF(currentPixmap.size()) / currentPixmap.devicePixelRatioF();
+                    QPoint shift(static_cast<int>(pixelDeltaX), static_cast<int>(pixelDeltaY));
+
+                    offset   = currentPixmapOffset + shift;
+                    cacheHit = QRect(offset, pixmapSize.toSize()).contains(visibleRect);
+                }
+            }
+
+            if (cacheHit) {
+                ++currentCacheHits;
+            } else {
+                ++currentCacheMisses;
+
+                currentPixmap          = sourcePixmap(Qt::DeviceCoordinates, &offset, QGraphicsEffect::NoPad);
+                currentPixmapOffset    = offset;
+                currentPixmapTransform = transform;
+            }
+
+            if (!currentPixmap.isNull()) {
+                painter->save();
+                painter->setWorldTransform(QTransform());
+                painter->drawPixmap(offset, currentPixmap);
+                painter->restore();
+            }
+        }
+    }
+
+
+    void GraphicsRasterCacheEffect::sourceChanged(QGraphicsEffect::ChangeFlags) {
+        currentPixmap = QPixmap();
+    }
+
+
+    bool GraphicsRasterCacheEffect::differOnlyByTranslation(const QTransform& first, const QTransform& second) {
+        return (
+               first.m11() == second.m11()
+            && first.m12() == second.m12()
+            && first.m13() == second.m13()
+            && first.m21() == second.m21()
+            && first.m22() == second.m22()
+            && first.m23() == second.m23()
+            && first.m33() == second.m33()
+        );
+    }
+}
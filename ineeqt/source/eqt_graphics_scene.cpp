@@ -29,12 +29,38 @@
 #include <QRectF>
 #include <QGraphicsItem>
 #include <QList>
+#include <QSet>
 #include <QGraphicsScene>
 
+#include "eqt_graphics_item.h"
 #include "eqt_graphics_scene.h"
 
+/***********************************************************************************************************************
+ * EQt::GraphicsScene::UpdateTransaction
+ */
+
 namespace EQt {
-    GraphicsScene::GraphicsScene(QObject* parent):QGraphicsScene(parent) {}
+    GraphicsScene::UpdateTransaction::UpdateTransaction(GraphicsScene* scene) {
+        currentScene = scene;
+        currentScene->beginUpdateTransaction();
+    }
+
+
+    GraphicsScene::UpdateTransaction::~UpdateTransaction() {
+        currentScene->commitUpdateTransaction();
+    }
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsScene
+ */
+
+namespace EQt {
+    unsigned GraphicsScene::numberOpenTransactions = 0;
+
+    GraphicsScene::GraphicsScene(QObject* parent):QGraphicsScene(parent) {
+        currentTransactionDepth = 0;
+    }
 
 
     GraphicsScene::GraphicsScene(
@@ -43,7 +69,9 @@ namespace EQt {
         ):QGraphicsScene(
             sceneRectangle,
             parent
-        ) {}
+        ) {
+        currentTransactionDepth = 0;
+    }
 
 
     GraphicsScene::GraphicsScene(
@@ -58,10 +86,19 @@ namespace EQt {
             width,
             height,
             parent
-        ) {}
+        ) {
+        currentTransactionDepth = 0;
+    }
 
 
     GraphicsScene::~GraphicsScene() {
+        if (currentTransactionDepth > 0) {
+            numberOpenTransactions  -= currentTransactionDepth - 1;
+            currentTransactionDepth  = 1;
+
+            commitUpdateTransaction();
+        }
+
         QList<QGraphicsItem*> children = items();
         for (QList<QGraphicsItem*>::const_iterator it=children.constBegin(),end=children.constEnd() ; it!=end ; ++it) {
             QGraphicsItem* item = *it;
@@ -69,4 +106,49 @@ namespace EQt {
             item->setParentItem(Q_NULLPTR);
         }
     }
+
+
+    void GraphicsScene::beginUpdateTransaction() {
+        ++currentTransactionDepth;
+        ++numberOpenTransactions;
+    }
+
+
+    void GraphicsScene::commitUpdateTransaction() {
+        if (currentTransactionDepth > 0) {
+            --currentTransactionDepth;
+            --numberOpenTransactions;
+
+            if (currentTransactionDepth == 0) {
+                QSet<GraphicsItem*> itemsToRestore;
+                itemsToRestore.swap(deferredItems);
+
+                for (  QSet<GraphicsItem*>::const_iterator it  = itemsToRestore.constBegin(),
+                                                           end = itemsToRestore.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    GraphicsItem* item = *it;
+                    item->currentTransactionScene = Q_NULLPTR;
+                    item->restoreUpdates();
+                }
+            }
+        }
+    }
+
+
+    bool GraphicsScene::updateTransactionIsOpen() const {
+        return currentTransactionDepth > 0;
+    }
+
+
+    void GraphicsScene::addDeferredItem(GraphicsItem* item) {
+        deferredItems.insert(item);
+        item->currentTransactionScene = this;
+    }
+
+
+    void GraphicsScene::removeDeferredItem(GraphicsItem* item) {
+        deferredItems.remove(item);
+    }
 }
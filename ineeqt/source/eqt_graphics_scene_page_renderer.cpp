@@ -0,0 +1,395 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::GraphicsScenePageRenderer class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QList>
+#include <QMap>
+#include <QRectF>
+#include <QSize>
+#include <QImage>
+#include <QColor>
+#include <QPicture>
+#include <QPainter>
+#include <QGraphicsScene>
+#include <QPointer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+
+#include <algorithm>
+#include <cmath>
+
+#include "eqt_graphics_scene_page_renderer.h"
+
+/***********************************************************************************************************************
+ * EQt::GraphicsScenePageRenderer::Context
+ */
+
+namespace EQt {
+    /**
+     * Class that holds state shared between the renderer and the worker threads.  The context outlives the renderer
+     * if worker threads are still running when the renderer is destroyed.
+     */
+    class GraphicsScenePageRenderer::Context {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] renderer The renderer that should receive rasterized pages.
+             */
+            Context(GraphicsScenePageRenderer* renderer) {
+                currentRenderer = renderer;
+            }
+
+            /**
+             * Method that is called by a worker thread to deliver a rasterized page.  The page is silently discarded
+             * if the operation was canceled or the renderer was destroyed.
+             *
+             * \param[in] pageIndex The zero based page index.
+             *
+             * \param[in] image     The rasterized page.
+             */
+            void deliver(unsigned pageIndex, const QImage& image) {
+                QMutexLocker locker(&mutex);
+                if (currentRenderer != Q_NULLPTR && !isCanceled()) {
+                    QMetaObject::invokeMethod(
+                        currentRenderer,
+                        "pageRasterized",
+                        Qt::QueuedConnection,
+                        Q_ARG(unsigned, pageIndex),
+                        Q_ARG(QImage, image)
+                    );
+                }
+            }
+
+            /**
+             * Method that is called to detach the renderer from this context.
+             */
+            void detach() {
+                QMutexLocker locker(&mutex);
+                currentRenderer = Q_NULLPTR;
+                canceled.storeRelease(1);
+            }
+
+            /**
+             * Method that is called to cancel outstanding work.
+             */
+            void cancel() {
+                canceled.storeRelease(1);
+            }
+
+            /**
+             * Method that is called to determine if outstanding work has been canceled.
+             *
+             * \return Returns true if outstanding work has been canceled.
+             */
+            bool isCanceled() const {
+                return canceled.loadAcquire() != 0;
+            }
+
+        private:
+            /**
+             * Mutex used to guard the renderer pointer.
+             */
+            QMutex mutex;
+
+            /**
+             * The renderer to receive pages.
+             */
+            GraphicsScenePageRenderer* currentRenderer;
+
+            /**
+             * Flag indicating that outstanding work has been canceled.
+             */
+            QAtomicInt canceled;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsScenePageRenderer::PageRasterizer
+ */
+
+namespace EQt {
+    /**
+     * Runnable that plays back a single recorded page into an image.
+     */
+    class GraphicsScenePageRenderer::PageRasterizer:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] context         The shared context used to deliver the page.
+             *
+             * \param[in] pageIndex       The zero based page index.
+             *
+             * \param[in] picture         The recorded page.  This object will take ownership of the picture.
+             *
+             * \param[in] pageSize        The page size, in pixels.
+             *
+             * \param[in] backgroundColor The color used to fill the image before the page is drawn.
+             */
+            PageRasterizer(
+                    QSharedPointer<Context> context,
+                    unsigned                pageIndex,
+                    QPicture*               picture,
+                    const QSize&            pageSize,
+                    const QColor&           backgroundColor
+                ):currentContext(
+                    context
+                ),currentPageIndex(
+                    pageIndex
+                ),currentPicture(
+                    picture
+                ),currentPageSize(
+                    pageSize
+                ),currentBackgroundColor(
+                    backgroundColor
+                ) {}
+
+            ~PageRasterizer() override {
+                delete currentPicture;
+            }
+
+            /**
+             * Method that performs the rasterization.
+             */
+            void run() override {
+                if (!currentContext->isCanceled()) {
+                    QImage image(currentPageSize, QImage::Format_ARGB32_Premultiplied);
+                    image.fill(currentBackgroundColor);
+
+                    QPainter painter(&image);
+                    painter.setRenderHint(QPainter::Antialiasing);
+                    painter.setRenderHint(QPainter::TextAntialiasing);
+                    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+                    painter.drawPicture(0, 0, *currentPicture);
+                    painter.end();
+
+                    currentContext->deliver(currentPageIndex, image);
+                }
+            }
+
+        private:
+            QSharedPointer<Context> currentContext;
+            unsigned                currentPageIndex;
+            QPicture*               currentPicture;
+            QSize                   currentPageSize;
+            QColor                  currentBackgroundColor;
+    };
+}
+
+/***********************************************************************************************************************
+ * EQt::GraphicsScenePageRenderer
+ */
+
+namespace EQt {
+    const unsigned GraphicsScenePageRenderer::automaticPagesInFlight = 0;
+
+    GraphicsScenePageRenderer::GraphicsScenePageRenderer(QObject* parent):QObject(parent) {
+        currentThreadPool           = Q_NULLPTR;
+        currentMaximumPagesInFlight = automaticPagesInFlight;
+        currentScaleFactor          = 1.0;
+        currentBackgroundColor      = QColor(Qt::white);
+        nextPageToStart             = 0;
+        nextPageToReport            = 0;
+    }
+
+
+    GraphicsScenePageRenderer::~GraphicsScenePageRenderer() {
+        if (!currentContext.isNull()) {
+            currentContext->detach();
+        }
+    }
+
+
+    void GraphicsScenePageRenderer::setThreadPool(QThreadPool* newThreadPool) {
+        currentThreadPool = newThreadPool;
+    }
+
+
+    QThreadPool* GraphicsScenePageRenderer::threadPool() const {
+        return currentThreadPool != Q_NULLPTR ? currentThreadPool : QThreadPool::globalInstance();
+    }
+
+
+    void GraphicsScenePageRenderer::setMaximumPagesInFlight(unsigned newMaximumPagesInFlight) {
+        currentMaximumPagesInFlight = newMaximumPagesInFlight;
+    }
+
+
+    unsigned GraphicsScenePageRenderer::maximumPagesInFlight() const {
+        unsigned result;
+
+        if (currentMaximumPagesInFlight == automaticPagesInFlight) {
+            result = 2 * static_cast<unsigned>(std::max(1, threadPool()->maxThreadCount()));
+        } else {
+            result = currentMaximumPagesInFlight;
+        }
+
+        return result;
+    }
+
+
+    void GraphicsScenePageRenderer::setScaleFactor(double newScaleFactor) {
+        currentScaleFactor = newScaleFactor;
+    }
+
+
+    double GraphicsScenePageRenderer::scaleFactor() const {
+        return currentScaleFactor;
+    }
+
+
+    void GraphicsScenePageRenderer::setBackgroundColor(const QColor& newBackgroundColor) {
+        currentBackgroundColor = newBackgroundColor;
+    }
+
+
+    const QColor& GraphicsScenePageRenderer::backgroundColor() const {
+        return currentBackgroundColor;
+    }
+
+
+    bool GraphicsScenePageRenderer::isActive() const {
+        return !currentContext.isNull();
+    }
+
+
+    bool GraphicsScenePageRenderer::render(QGraphicsScene* scene, const QList<QRectF>& pageRectangles) {
+        bool success;
+
+        if (!currentContext.isNull()) {
+            success = false;
+        } else {
+            currentContext        = QSharedPointer<Context>(new Context(this));
+            currentScene          = scene;
+            currentPageRectangles = pageRectangles;
+            nextPageToStart       = 0;
+            nextPageToReport      = 0;
+
+            if (currentPageRectangles.isEmpty()) {
+                endRender(true);
+            } else {
+                startPages();
+            }
+
+            success = true;
+        }
+
+        return success;
+    }
+
+
+    void GraphicsScenePageRenderer::cancel() {
+        if (!currentContext.isNull()) {
+            currentContext->cancel();
+            endRender(false);
+        }
+    }
+
+
+    void GraphicsScenePageRenderer::pageRasterized(unsigned pageIndex, const QImage& image) {
+        if (!currentContext.isNull() && !currentContext->isCanceled()) {
+            completedPages.insert(pageIndex, image);
+
+            unsigned numberPages = static_cast<unsigned>(currentPageRectangles.size());
+            while (!currentContext.isNull()   &&
+                   !completedPages.isEmpty()  &&
+                   completedPages.firstKey() == nextPageToReport) {
+                QImage pageImage = completedPages.take(nextPageToReport);
+                emit pageRendered(nextPageToReport, pageImage);
+
+                ++nextPageToReport;
+                emit progress(nextPageToReport, numberPages);
+            }
+
+            if (!currentContext.isNull()) {
+                if (nextPageToReport == numberPages) {
+                    endRender(true);
+                } else {
+                    startPages();
+                }
+            }
+        }
+    }
+
+
+    void GraphicsScenePageRenderer::startPages() {
+        if (currentScene.isNull()) {
+            // The scene was destroyed before every page could be recorded.
+            currentContext->cancel();
+            endRender(false);
+        } else {
+            unsigned     numberPages   = static_cast<unsigned>(currentPageRectangles.size());
+            unsigned     pagesInFlight = maximumPagesInFlight();
+            QThreadPool* pool          = threadPool();
+
+            // Pages are recorded just ahead of the worker threads so only the pages in flight are ever held in memory.
+            // Each recorded page is owned, and released, by the runnable that rasterizes it.
+
+            while (nextPageToStart < numberPages && nextPageToStart - nextPageToReport < pagesInFlight) {
+                const QRectF& sceneRectangle = currentPageRectangles.at(nextPageToStart);
+                QSize         pageSize(
+                    static_cast<int>(std::ceil(sceneRectangle.width() * currentScaleFactor)),
+                    static_cast<int>(std::ceil(sceneRectangle.height() * currentScaleFactor))
+                );
+
+                QPicture* picture = new QPicture;
+                QPainter  painter(picture);
+                currentScene->render(&painter, QRectF(QPointF(0, 0), pageSize), sceneRectangle, Qt::KeepAspectRatio);
+                painter.end();
+
+                PageRasterizer* rasterizer = new PageRasterizer(
+                    currentContext,
+                    nextPageToStart,
+                    picture,
+                    pageSize,
+                    currentBackgroundColor
+                );
+
+                pool->start(rasterizer);
+
+                ++nextPageToStart;
+            }
+        }
+    }
+
+
+    void GraphicsScenePageRenderer::endRender(bool completed) {
+        currentContext.reset();
+        currentScene.clear();
+
+        currentPageRectangles.clear();
+        completedPages.clear();
+
+        emit finished(completed);
+    }
+}
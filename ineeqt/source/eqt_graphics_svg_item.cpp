@@ -25,14 +25,42 @@
 * This file implements the \ref EQt::GraphicsSvgItem class.
 ***********************************************************************************************************************/
 
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QCache>
+#include <QWeakPointer>
+#include <QSharedPointer>
+#include <QFile>
+#include <QFileInfo>
+#include <QCryptographicHash>
 #include <QPixmap>
+#include <QPainter>
+#include <QTransform>
+#include <QRectF>
+#include <QSize>
+#include <QStyle>
+#include <QStyleOptionGraphicsItem>
+#include <QSvgRenderer>
 #include <QGraphicsItem>
 #include <QGraphicsSvgItem>
 
+#include <cmath>
+
 #include "eqt_graphics_item.h"
 #include "eqt_graphics_svg_item.h"
 
 namespace EQt {
+    const unsigned GraphicsSvgItem::defaultRasterCacheSize = 32768;
+
+    static QHash<QByteArray, QWeakPointer<QSvgRenderer>> sharedSvgRenderers;
+    static unsigned long long                            rendererCacheHitCount  = 0;
+    static unsigned long long                            rendererCacheMissCount = 0;
+
+    static QCache<QString, QPixmap> svgRasterCache(GraphicsSvgItem::defaultRasterCacheSize);
+    static unsigned long long       rasterCacheHitCount  = 0;
+    static unsigned long long       rasterCacheMissCount = 0;
+
     GraphicsSvgItem::GraphicsSvgItem(QGraphicsItem* parent):QGraphicsSvgItem(parent) {}
 
 
@@ -40,9 +68,10 @@ namespace EQt {
             const QString& filename,
             QGraphicsItem* parent
         ):QGraphicsSvgItem(
-            filename,
             parent
-        ) {}
+        ) {
+        loadSharedRenderer(filename);
+    }
 
 
     GraphicsSvgItem::~GraphicsSvgItem() {}
@@ -52,8 +81,184 @@ namespace EQt {
         return Type;
     }
 
+
+    void GraphicsSvgItem::setRasterCacheSize(unsigned newCacheSize) {
+        svgRasterCache.setMaxCost(static_cast<int>(newCacheSize));
+    }
+
+
+    unsigned GraphicsSvgItem::rasterCacheSize() {
+        return static_cast<unsigned>(svgRasterCache.maxCost());
+    }
+
+
+    void GraphicsSvgItem::clearRasterCache() {
+        svgRasterCache.clear();
+        rasterCacheHitCount  = 0;
+        rasterCacheMissCount = 0;
+    }
+
+
+    unsigned long long GraphicsSvgItem::rasterCacheHits() {
+        return rasterCacheHitCount;
+    }
+
+
+    unsigned long long GraphicsSvgItem::rasterCacheMisses() {
+        return rasterCacheMissCount;
+    }
+
+
+    unsigned GraphicsSvgItem::numberSharedRenderers() {
+        unsigned result = 0;
+
+        for (  QHash<QByteArray, QWeakPointer<QSvgRenderer>>::const_iterator
+                   rendererIterator    = sharedSvgRenderers.constBegin(),
+                   rendererEndIterator = sharedSvgRenderers.constEnd()
+             ; rendererIterator != rendererEndIterator
+             ; ++rendererIterator
+            ) {
+            if (!rendererIterator.value().isNull()) {
+                ++result;
+            }
+        }
+
+        return result;
+    }
+
+
+    unsigned long long GraphicsSvgItem::rendererCacheHits() {
+        return rendererCacheHitCount;
+    }
+
+
+    unsigned long long GraphicsSvgItem::rendererCacheMisses() {
+        return rendererCacheMissCount;
+    }
+
+
+    void GraphicsSvgItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+        const QTransform& transform = painter->worldTransform();
+        QSvgRenderer*     renderer  = QGraphicsSvgItem::renderer();
+
+        // Fall back to the vector path when printing, when the item is rotated or sheared, when the selection
+        // outline must be drawn, or when the renderer was replaced through setSharedRenderer.
+
+        if (widget == Q_NULLPTR                                  ||
+            svgRasterCache.maxCost() == 0                        ||
+            currentContentHash.isEmpty()                         ||
+            renderer != currentSharedRenderer.data()             ||
+            !renderer->isValid()                                 ||
+            renderer->animated()                                 ||
+            transform.type() > QTransform::TxScale               ||
+            (option->state & QStyle::State_Selected) != 0           ) {
+            QGraphicsSvgItem::paint(painter, option, widget);
+        } else {
+            QRectF bounds           = boundingRect();
+            QRectF deviceBounds     = transform.mapRect(bounds);
+            double devicePixelRatio = painter->device()->devicePixelRatioF();
+
+            QSize pixelSize(
+                static_cast<int>(std::ceil(deviceBounds.width() * devicePixelRatio)),
+                static_cast<int>(std::ceil(deviceBounds.height() * devicePixelRatio))
+            );
+
+            int cost = static_cast<int>((4LL * pixelSize.width() * pixelSize.height() + 1023) / 1024);
+
+            if (pixelSize.isEmpty() || cost > svgRasterCache.maxCost()) {
+                QGraphicsSvgItem::paint(painter, option, widget);
+            } else {
+                QString key = QString("%1:%2:%3x%4").arg(
+                    QString::fromLatin1(currentContentHash.toHex()),
+                    elementId(),
+                    QString::number(pixelSize.width()),
+                    QString::number(pixelSize.height())
+                );
+
+                QPixmap* pixmap = svgRasterCache.object(key);
+                if (pixmap != Q_NULLPTR) {
+                    ++rasterCacheHitCount;
+                } else {
+                    ++rasterCacheMissCount;
+
+                    pixmap = new QPixmap(pixelSize);
+                    pixmap->fill(Qt::transparent);
+
+                    QPainter pixmapPainter(pixmap);
+                    pixmapPainter.setRenderHints(painter->renderHints());
+
+                    QRectF pixmapBounds(0, 0, pixelSize.width(), pixelSize.height());
+                    if (elementId().isEmpty()) {
+                        renderer->render(&pixmapPainter, pixmapBounds);
+                    } else {
+                        renderer->render(&pixmapPainter, elementId(), pixmapBounds);
+                    }
+
+                    pixmapPainter.end();
+
+                    svgRasterCache.insert(key, pixmap, cost);
+                    pixmap = svgRasterCache.object(key);
+                }
+
+                if (pixmap != Q_NULLPTR) {
+                    painter->save();
+                    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+                    painter->drawPixmap(bounds, *pixmap, QRectF(pixmap->rect()));
+                    painter->restore();
+                } else {
+                    QGraphicsSvgItem::paint(painter, option, widget);
+                }
+            }
+        }
+    }
+
+
     void GraphicsSvgItem::removeFromScene() {
         prepareGeometryChange();
         removeGraphicsItemFromScene(this);
     }
+
+
+    void GraphicsSvgItem::loadSharedRenderer(const QString& filename) {
+        QFileInfo fileInfo(filename);
+        QString   path = fileInfo.canonicalFilePath();
+
+        if (!path.isEmpty()) {
+            // The content is hashed on every load.  A modification time and size can survive an edit, for example
+            // when a file is rewritten within the file system's timestamp resolution.  Reading and hashing the file
+            // costs far less than parsing it.
+
+            QFile file(path);
+            if (file.open(QFile::ReadOnly)) {
+                QByteArray contents = file.readAll();
+
+                currentContentHash    = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+                currentSharedRenderer = sharedSvgRenderers.value(currentContentHash).toStrongRef();
+
+                if (!currentSharedRenderer.isNull()) {
+                    ++rendererCacheHitCount;
+                } else {
+                    ++rendererCacheMissCount;
+
+                    currentSharedRenderer = QSharedPointer<QSvgRenderer>(new QSvgRenderer(contents));
+                    sharedSvgRenderers.insert(currentContentHash, currentSharedRenderer.toWeakRef());
+                }
+
+                setSharedRenderer(currentSharedRenderer.data());
+
+                // The shared raster cache already holds the rendered pixmap.  A per-item cache would hold a second
+                // copy for every item.
+
+                setCacheMode(QGraphicsItem::NoCache);
+            }
+        }
+
+        if (currentSharedRenderer.isNull()) {
+            // The file could not be read directly, so let the renderer resolve the filename without sharing it.
+
+            currentContentHash.clear();
+            currentSharedRenderer = QSharedPointer<QSvgRenderer>(new QSvgRenderer(filename));
+            setSharedRenderer(currentSharedRenderer.data());
+        }
+    }
 }
@@ -31,6 +31,7 @@
 #include <QWidget>
 
 #include "eqt_graphics_item.h"
+#include "eqt_graphics_raster_cache_effect.h"
 #include "eqt_polar_2d_chart_item.h"
 
 namespace EQt {
@@ -40,15 +41,24 @@ namespace EQt {
         ):QPolarChart(
             parent,
             windowFlags
-        ) {}
+        ) {
+        currentGeometryIsPending = false;
+    }
 
 
     Polar2DChartItem::~Polar2DChartItem() {}
 
 
     void Polar2DChartItem::setGeometry(const QRectF& rectangle) {
-        currentEnforcedBoundingRectangle = rectangle;
-        QPolarChart::setGeometry(rectangle);
+        if (deferringUpdates()) {
+            currentPendingGeometry   = rectangle;
+            currentGeometryIsPending = true;
+
+            requestUpdate();
+        } else {
+            currentEnforcedBoundingRectangle = rectangle;
+            QPolarChart::setGeometry(rectangle);
+        }
     }
 
 
@@ -66,4 +76,55 @@ namespace EQt {
         prepareGeometryChange();
         removeGraphicsItemFromScene(this);
     }
+
+
+    void Polar2DChartItem::setRasterCacheEnabled(bool nowEnabled) {
+        if (nowEnabled && currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect = new GraphicsRasterCacheEffect;
+            setGraphicsEffect(currentRasterCacheEffect.data());
+        } else if (!nowEnabled && !currentRasterCacheEffect.isNull()) {
+            setGraphicsEffect(Q_NULLPTR);
+        }
+    }
+
+
+    void Polar2DChartItem::setRasterCacheDisabled(bool nowDisabled) {
+        setRasterCacheEnabled(!nowDisabled);
+    }
+
+
+    bool Polar2DChartItem::rasterCacheEnabled() const {
+        return !currentRasterCacheEffect.isNull();
+    }
+
+
+    bool Polar2DChartItem::rasterCacheDisabled() const {
+        return currentRasterCacheEffect.isNull();
+    }
+
+
+    void Polar2DChartItem::beginInteraction() {
+        if (!currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect->beginInteraction();
+        }
+    }
+
+
+    void Polar2DChartItem::endInteraction() {
+        if (!currentRasterCacheEffect.isNull()) {
+            currentRasterCacheEffect->endInteraction();
+        }
+    }
+
+
+    void Polar2DChartItem::applyDeferredUpdates() {
+        if (currentGeometryIsPending) {
+            currentGeometryIsPending         = false;
+            currentEnforcedBoundingRectangle = currentPendingGeometry;
+
+            QPolarChart::setGeometry(currentPendingGeometry);
+        }
+
+        GraphicsItem::applyDeferredUpdates();
+    }
 }
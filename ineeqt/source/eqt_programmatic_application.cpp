@@ -27,17 +27,59 @@
 
 #include <QString>
 #include <QList>
+#include <QSet>
 #include <QAction>
 #include <QApplication>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include "eqt_application.h"
 #include "eqt_unique_application.h"
 #include "eqt_builder_base.h"
 #include "eqt_builder.h"
+#include "eqt_builder_profiler.h"
 #include "eqt_programmatic_application.h"
 
+/***********************************************************************************************************************
+ * Class ProgrammaticApplication::Preparer
+ */
+
+namespace EQt {
+    class ProgrammaticApplication::Preparer:public QRunnable {
+        public:
+            Preparer(Builder* builder);
+
+            ~Preparer() override;
+
+            void run() override;
+
+        private:
+            Builder* currentBuilder;
+    };
+
+
+    ProgrammaticApplication::Preparer::Preparer(Builder* builder) {
+        currentBuilder = builder;
+    }
+
+
+    ProgrammaticApplication::Preparer::~Preparer() {}
+
+
+    void ProgrammaticApplication::Preparer::run() {
+        BuilderProfiler::Scope scope(currentBuilder, "prepare");
+        currentBuilder->prepare();
+    }
+}
+
+/***********************************************************************************************************************
+ * Class ProgrammaticApplication
+ */
+
 namespace EQt {
     QList<BuilderBase*> ProgrammaticApplication::builderList;
+    QList<Builder*>     ProgrammaticApplication::typedBuilderList;
+    QSet<Builder*>      ProgrammaticApplication::preparedBuilders;
 
     ProgrammaticApplication::ProgrammaticApplication(
             int&           applicationCount,
@@ -60,6 +102,10 @@ namespace EQt {
         for (auto it=builderList.begin(),end=builderList.end() ; it!=end ; ++it) {
             delete *it;
         }
+
+        builderList.clear();
+        typedBuilderList.clear();
+        preparedBuilders.clear();
     }
 
 
@@ -72,15 +118,53 @@ namespace EQt {
         }
 
         builderList.insert(index, newBuilder);
+
+        Builder* builder = dynamic_cast<Builder*>(newBuilder);
+        if (builder != Q_NULLPTR) {
+            // Both lists are ordered by priority, with ties kept in the order added, so the typed list can be
+            // searched the same way.
+
+            int typedIndex = 0;
+            while (typedIndex < typedBuilderList.size() && typedBuilderList[typedIndex]->priority() <= priority) {
+                ++typedIndex;
+            }
+
+            typedBuilderList.insert(typedIndex, builder);
+        }
     }
 
 
-    void ProgrammaticApplication::runBuilders() {
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->registerResources(this);
+    void ProgrammaticApplication::prepareBuilders() {
+        QList<Builder*> unpreparedBuilders;
+        for (auto it=typedBuilderList.constBegin(),end=typedBuilderList.constEnd() ; it!=end ; ++it) {
+            Builder* builder = *it;
+            if (!preparedBuilders.contains(builder)) {
+                unpreparedBuilders.append(builder);
+                preparedBuilders.insert(builder);
+            }
+        }
+
+        if (!unpreparedBuilders.isEmpty()) {
+            // A dedicated pool lets us wait for our builders without waiting on unrelated work in the global pool.
+
+            QThreadPool threadPool;
+            for (auto it=unpreparedBuilders.constBegin(),end=unpreparedBuilders.constEnd() ; it!=end ; ++it) {
+                threadPool.start(new Preparer(*it));
             }
+
+            threadPool.waitForDone();
+        }
+    }
+
+
+    void ProgrammaticApplication::runBuilders() {
+        prepareBuilders();
+
+        for (auto it=typedBuilderList.constBegin(),end=typedBuilderList.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "registerResources");
+
+            builder->registerResources(this);
         }
     }
 }
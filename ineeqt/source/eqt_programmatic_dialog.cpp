@@ -27,6 +27,7 @@
 
 #include <QWidget>
 #include <QString>
+#include <QList>
 #include <QMap>
 #include <QLayout>
 #include <QHBoxLayout>
@@ -41,6 +42,7 @@
 #include "eqt_common.h"
 #include "eqt_programmatic_application.h"
 #include "eqt_builder.h"
+#include "eqt_builder_profiler.h"
 #include "eqt_programmatic_window.h"
 #include "eqt_programmatic_dialog_proxy.h"
 #include "eqt_programmatic_dialog.h"
@@ -121,30 +123,34 @@ namespace EQt {
 
 
     void ProgrammaticDialog::runBuilders() {
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildDialogGui(currentDialogName, this);
-            }
+        ProgrammaticApplication::prepareBuilders();
+
+        const QList<Builder*>& builders = ProgrammaticApplication::builders();
+
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildDialogGui");
+
+            builder->buildDialogGui(currentDialogName, this);
         }
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                ProgrammaticDialogProxy* proxy = builder->createDialogProxy(currentDialogName, this);
-                if (proxy != Q_NULLPTR) {
-                    addProxy(builder->builderIdentifier(), proxy);
-                }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "createDialogProxy");
+
+            ProgrammaticDialogProxy* proxy = builder->createDialogProxy(currentDialogName, this);
+            if (proxy != Q_NULLPTR) {
+                addProxy(builder->builderIdentifier(), proxy);
             }
         }
 
         bind();
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildDialogFinal(currentDialogName, this);
-            }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildDialogFinal");
+
+            builder->buildDialogFinal(currentDialogName, this);
         }
     }
 
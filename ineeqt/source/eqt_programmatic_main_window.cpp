@@ -26,9 +26,12 @@
 ***********************************************************************************************************************/
 
 #include <QWidget>
+#include <QPointer>
+#include <QList>
 #include <QMap>
 #include <QSet>
 #include <QHash>
+#include <QVector>
 #include <QPair>
 #include <QSize>
 #include <QRect>
@@ -47,6 +50,7 @@
 
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 #include "dock_widget_location.h"
 #include "dock_widget_locations.h"
@@ -54,6 +58,7 @@
 #include "eqt_programmatic_dock_widget.h"
 #include "eqt_dock_widget_defaults.h"
 #include "eqt_builder.h"
+#include "eqt_builder_profiler.h"
 #include "eqt_programmatic_main_window_proxy.h"
 #include "eqt_programmatic_main_window.h"
 
@@ -66,7 +71,12 @@ namespace EQt {
         public:
             typedef QMap<QString, Node*>::iterator ChildIterator;
 
-            Node(const QString& title, bool topLevel, QWidget* parentWidget, Node* newParent = Q_NULLPTR);
+            Node(
+                const QString&          title,
+                bool                    topLevel,
+                ProgrammaticMainWindow* window,
+                Node*                   newParent = Q_NULLPTR
+            );
 
             ~Node();
 
@@ -78,6 +88,16 @@ namespace EQt {
                 return currentParent;
             }
 
+            inline bool isPopulated() const {
+                return populated;
+            }
+
+            QMenu* createMenu();
+
+            void populate();
+
+            void addEntry(QAction* action);
+
             ProgrammaticMainWindow::Node* addChildMenu(const QString& childName);
 
             inline Node* child(const QString& childName) {
@@ -97,41 +117,117 @@ namespace EQt {
             }
 
         private:
-            Node*                currentParent;
-            QMap<QString, Node*> children;
-            QMenu*               currentMenu;
+            /**
+             * Descriptor for a single menu entry.  Exactly one of the action or child node is set.  The action is
+             * tracked so that actions deleted before the menu is built are skipped.
+             */
+            struct Entry {
+                QPointer<QAction> action;
+                Node*             childNode;
+            };
+
+            void insertEntry(const Entry& entry);
+
+            Node*                   currentParent;
+            ProgrammaticMainWindow* currentWindow;
+            QString                 currentTitle;
+            bool                    currentTopLevel;
+            QMap<QString, Node*>    children;
+            QList<Entry>            entries;
+            QMenu*                  currentMenu;
+            bool                    populated;
     };
 
 
-    ProgrammaticMainWindow::Node::Node(const QString& title, bool topLevel, QWidget* parentWidget, Node* newParent) {
-        currentParent = newParent;
+    ProgrammaticMainWindow::Node::Node(
+            const QString&          title,
+            bool                    topLevel,
+            ProgrammaticMainWindow* window,
+            Node*                   newParent
+        ) {
+        currentParent   = newParent;
+        currentWindow   = window;
+        currentTitle    = title;
+        currentTopLevel = topLevel;
+        currentMenu     = Q_NULLPTR;
+        populated       = false;
+    }
+
 
-        // The hack below is loosely based on the write-up at:
-        //
-        //     https://stackoverflow.com/questions/15434683/disable-start-dictation-for-an-app-in-qt#16009541
+    ProgrammaticMainWindow::Node::~Node() {
+        // We rely on Qt to delete the QMenu instance associated with each child.
 
-        #if (defined(Q_OS_DARWIN))
+        for (auto it=children.begin(),end=children.end() ; it!=end ; ++it) {
+            delete it.value();
+        }
+    }
 
-            if ((title == tr("&Edit") || title == tr("&Help") || title == tr("&View")) && topLevel) {
-                currentMenu = new QMenu(QString("%1%2").arg(QChar(0x200C)).arg(title), parentWidget);
-            } else {
-                currentMenu = new QMenu(title, parentWidget);
-            }
 
-        #else
+    QMenu* ProgrammaticMainWindow::Node::createMenu() {
+        if (currentMenu == Q_NULLPTR) {
+            // The hack below is loosely based on the write-up at:
+            //
+            //     https://stackoverflow.com/questions/15434683/disable-start-dictation-for-an-app-in-qt#16009541
 
-            (void) topLevel;
-            currentMenu   = new QMenu(title, parentWidget);
+            #if (defined(Q_OS_DARWIN))
 
-        #endif
+                bool hiddenItemsMenu = (
+                       currentTitle == tr("&Edit")
+                    || currentTitle == tr("&Help")
+                    || currentTitle == tr("&View")
+                );
+
+                if (hiddenItemsMenu && currentTopLevel) {
+                    currentMenu = new QMenu(QString("%1%2").arg(QChar(0x200C)).arg(currentTitle), currentWindow);
+                } else {
+                    currentMenu = new QMenu(currentTitle, currentWindow);
+                }
+
+            #else
+
+                currentMenu = new QMenu(currentTitle, currentWindow);
+
+            #endif
+
+            currentWindow->unpopulatedMenus.insert(currentMenu, this);
+            QObject::connect(currentMenu, SIGNAL(aboutToShow()), currentWindow, SLOT(menuAboutToShow()));
+        }
+
+        return currentMenu;
     }
 
 
-    ProgrammaticMainWindow::Node::~Node() {
-        // We rely on Qt to delete the QMenu instance associated with each child.
+    void ProgrammaticMainWindow::Node::populate() {
+        if (!populated) {
+            createMenu();
 
-        for (auto it=children.begin(),end=children.end() ; it!=end ; ++it) {
-            delete it.value();
+            currentWindow->unpopulatedMenus.remove(currentMenu);
+            QObject::disconnect(currentMenu, SIGNAL(aboutToShow()), currentWindow, SLOT(menuAboutToShow()));
+
+            populated = true;
+
+            QList<Entry>::const_iterator entryIterator    = entries.constBegin();
+            QList<Entry>::const_iterator entryEndIterator = entries.constEnd();
+            while (entryIterator != entryEndIterator) {
+                if (entryIterator->childNode != Q_NULLPTR || !entryIterator->action.isNull()) {
+                    insertEntry(*entryIterator);
+                }
+
+                ++entryIterator;
+            }
+        }
+    }
+
+
+    void ProgrammaticMainWindow::Node::addEntry(QAction* action) {
+        Entry entry;
+        entry.action    = action;
+        entry.childNode = Q_NULLPTR;
+
+        entries.append(entry);
+
+        if (populated) {
+            insertEntry(entry);
         }
     }
 
@@ -142,16 +238,35 @@ namespace EQt {
         ProgrammaticMainWindow::Node* newNode = new ProgrammaticMainWindow::Node(
             childName,
             false,
-            dynamic_cast<QWidget*>(currentMenu->parent()),
+            currentWindow,
             this
         );
 
         children.insert(childName, newNode);
 
-        currentMenu->addMenu(newNode->currentMenu);
+        Entry entry;
+        entry.action    = Q_NULLPTR;
+        entry.childNode = newNode;
+
+        entries.append(entry);
+
+        if (populated) {
+            insertEntry(entry);
+        }
 
         return newNode;
     }
+
+
+    void ProgrammaticMainWindow::Node::insertEntry(const Entry& entry) {
+        if (entry.childNode != Q_NULLPTR) {
+            // Child menus are created empty so the submenu indicator is drawn.  Their entries are added when the child
+            // menu is first about to be shown.
+            currentMenu->addMenu(entry.childNode->createMenu());
+        } else {
+            currentMenu->addAction(entry.action);
+        }
+    }
 }
 
 /***********************************************************************************************************************
@@ -161,6 +276,7 @@ namespace EQt {
 namespace EQt {
     ProgrammaticMainWindow::ProgrammaticMainWindow(QWidget* parent):QMainWindow(parent) {
         currentActionState.clear();
+        currentActionUpdateDepth = 0;
 
         dockWidgetUpdateTimer = new QTimer(this);
         dockWidgetUpdateTimer->setSingleShot(true);
@@ -353,7 +469,8 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree);
 
-        QAction* newAction = node->menu()->addAction(menuItemName);
+        QAction* newAction = new QAction(menuItemName, this);
+        addMenuEntry(node, newAction);
         addAction(newAction, newActionName);
 
         return newAction;
@@ -387,7 +504,8 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree);
 
-        QAction* newAction = node->menu()->addAction(icon, menuItemName);
+        QAction* newAction = new QAction(icon, menuItemName, this);
+        addMenuEntry(node, newAction);
         addAction(newAction, newActionName);
 
         return newAction;
@@ -423,7 +541,8 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree);
 
-        QAction* newAction = node->menu()->addAction(icon, menuItemName);
+        QAction* newAction = new QAction(icon, menuItemName, this);
+        addMenuEntry(node, newAction);
 
         QToolBar* toolbar;
         if (!toolbars.contains(toolbarName)) {
@@ -507,7 +626,10 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree, true);
 
-        node->menu()->addSeparator();
+        QAction* separator = new QAction(this);
+        separator->setSeparator(true);
+
+        node->addEntry(separator);
     }
 
 
@@ -518,7 +640,10 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree);
 
-        QAction* newAction = node->menu()->addSection(menuItemName);
+        QAction* newAction = new QAction(menuItemName, this);
+        newAction->setSeparator(true);
+
+        node->addEntry(newAction);
         addAction(newAction, newActionName);
 
         return newAction;
@@ -538,6 +663,10 @@ namespace EQt {
             menuLocation.split("|", Qt::SplitBehaviorFlags::SkipEmptyParts),
             true
         );
+
+        // The caller is free to add entries to the returned menu directly so the menu and the path leading to it are
+        // built now.
+        materializeNode(node);
         return node->menu();
     }
 
@@ -546,10 +675,11 @@ namespace EQt {
         QStringList                   menuTree     = menuLocation.split("|", Qt::SplitBehaviorFlags::SkipEmptyParts);
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree);
-        QMenu*                        parentMenu   = node->menu();
 
         menu->setTitle(menuItemName);
-        QAction* action = parentMenu->addMenu(menu);
+
+        QAction* action = menu->menuAction();
+        node->addEntry(action);
 
         return action;
     }
@@ -660,7 +790,7 @@ namespace EQt {
         QString                       menuItemName = menuTree.last().trimmed();
         ProgrammaticMainWindow::Node* node         = locateNode(menuTree, true);
 
-        node->menu()->addAction(toggleAction);
+        addMenuEntry(node, toggleAction);
 
         if (!actionName.isEmpty()) {
             addAction(toggleAction, actionName);
@@ -673,26 +803,53 @@ namespace EQt {
     void ProgrammaticMainWindow::setActionState(const Util::BitSet& newActionState) {
         Util::BitSet oldActionState = currentActionState;
 
-        ActionStateMap removedMap  = processActionState(~newActionState, &currentlyEnabledActions, false);
-        ActionStateMap insertedMap = processActionState(newActionState, &currentlyDisabledActions, true);
+        beginActionStateUpdate();
+
+        QVector<unsigned long> oldBits = setBitIndexes(oldActionState);
+        QVector<unsigned long> newBits = setBitIndexes(newActionState);
+        QVector<unsigned long> changedBits;
+
+        std::set_symmetric_difference(
+            oldBits.constBegin(),
+            oldBits.constEnd(),
+            newBits.constBegin(),
+            newBits.constEnd(),
+            std::back_inserter(changedBits)
+        );
+
+        // An action may depend on several of the changed bits so the affected actions are collected first so that
+        // each is only updated once.
 
-        currentlyDisabledActions += removedMap;
-        currentlyEnabledActions += insertedMap;
+        ActionSet affectedActions;
+        for (  QVector<unsigned long>::const_iterator bitIterator    = changedBits.constBegin(),
+                                                      bitEndIterator = changedBits.constEnd()
+             ; bitIterator != bitEndIterator
+             ; ++bitIterator
+            ) {
+            ActionsByBit::const_iterator actionsIterator = currentActionsByBit.constFind(*bitIterator);
+            if (actionsIterator != currentActionsByBit.constEnd()) {
+                affectedActions.unite(actionsIterator.value());
+            }
+        }
+
+        currentActionState = newActionState;
 
-        for (  ActionStateMap::const_iterator it  = currentMultiBitMaskActions.constBegin(),
-                                              end = currentMultiBitMaskActions.constEnd()
+        for (  ActionSet::const_iterator it  = affectedActions.constBegin(),
+                                         end = affectedActions.constEnd()
              ; it != end
              ; ++it
             ) {
-            QAction* action = it.value();
-            action->setEnabled(newActionState.intersects(it.key()));
+            QAction* action = *it;
+            updateActionEnabled(action, newActionState.intersects(currentMasksByAction.value(action)));
         }
 
-        currentActionState = newActionState;
+        // Proxies are notified inside the batch so that masks they adjust are applied along with ours.
 
         for (ProxyList::const_iterator it=beginProxies(),end=endProxies() ; it!=end ; ++it) {
             (*it)->actionStateChanged(oldActionState, newActionState);
         }
+
+        endActionStateUpdate();
     }
 
 
@@ -702,39 +859,35 @@ namespace EQt {
 
 
     void ProgrammaticMainWindow::setActionMask(QAction* action, const Util::BitSet& actionMask) {
-        if (currentMasksByAction.contains(action)) {
-            // Action is already defined, remove it.
-            Util::BitSet oldMask = currentMasksByAction.value(action);
-
-            unsigned numberRemoved = currentlyEnabledActions.remove(oldMask, action);
-            numberRemoved += currentlyDisabledActions.remove(oldMask, action);
-
-            Q_ASSERT(numberRemoved == 1);
-        }
-
-        currentMasksByAction.insert(action, actionMask);
-
-        if (actionMask.numberSetBits() == 1) {
-            if (currentActionState.intersects(actionMask)) {
-                removeFromMap(action, currentlyDisabledActions);
-                removeFromMap(action, currentMultiBitMaskActions);
-
-                currentlyEnabledActions.insert(actionMask, action);
-                action->setEnabled(true);
-            } else {
-                removeFromMap(action, currentlyEnabledActions);
-                removeFromMap(action, currentMultiBitMaskActions);
-
-                currentlyDisabledActions.insert(actionMask, action);
-                action->setEnabled(false);
+        QHash<QAction*, Util::BitSet>::iterator maskIterator = currentMasksByAction.find(action);
+        if (maskIterator != currentMasksByAction.end()) {
+            // Action is already defined, remove it from the index.
+            QVector<unsigned long> oldBits = setBitIndexes(maskIterator.value());
+            for (  QVector<unsigned long>::const_iterator it  = oldBits.constBegin(),
+                                                          end = oldBits.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                ActionsByBit::iterator actionsIterator = currentActionsByBit.find(*it);
+                if (actionsIterator != currentActionsByBit.end()) {
+                    actionsIterator.value().remove(action);
+                    if (actionsIterator.value().isEmpty()) {
+                        currentActionsByBit.erase(actionsIterator);
+                    }
+                }
             }
+
+            maskIterator.value() = actionMask;
         } else {
-            removeFromMap(action, currentlyEnabledActions);
-            removeFromMap(action, currentlyDisabledActions);
+            currentMasksByAction.insert(action, actionMask);
+        }
 
-            currentMultiBitMaskActions.insert(actionMask, action);
-            action->setEnabled(currentActionState.intersects(actionMask));
+        QVector<unsigned long> newBits = setBitIndexes(actionMask);
+        for (QVector<unsigned long>::const_iterator it=newBits.constBegin(),end=newBits.constEnd() ; it!=end ; ++it) {
+            currentActionsByBit[*it].insert(action);
         }
+
+        updateActionEnabled(action, currentActionState.intersects(actionMask));
     }
 
 
@@ -766,49 +919,87 @@ namespace EQt {
     }
 
 
-    void ProgrammaticMainWindow::runBuilders() {
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildMainWindowGui(this);
+    void ProgrammaticMainWindow::beginActionStateUpdate() {
+        ++currentActionUpdateDepth;
+    }
+
+
+    void ProgrammaticMainWindow::endActionStateUpdate() {
+        Q_ASSERT(currentActionUpdateDepth > 0);
+
+        if (currentActionUpdateDepth > 0) {
+            --currentActionUpdateDepth;
+
+            if (currentActionUpdateDepth == 0 && !pendingActionEnables.isEmpty()) {
+                QHash<QAction*, bool> actionsToUpdate;
+                actionsToUpdate.swap(pendingActionEnables);
+
+                for (  QHash<QAction*, bool>::const_iterator it  = actionsToUpdate.constBegin(),
+                                                             end = actionsToUpdate.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    // QAction::isEnabled reports false for hidden actions so it can not be used to skip the call.
+                    // QAction::setEnabled already ignores requests that do not change the explicit state.
+                    it.key()->setEnabled(it.value());
+                }
             }
         }
+    }
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildAdditionalMainWindowActions(this);
-            }
+
+    bool ProgrammaticMainWindow::actionStateUpdateInProgress() const {
+        return currentActionUpdateDepth > 0;
+    }
+
+
+    void ProgrammaticMainWindow::runBuilders() {
+        ProgrammaticApplication::prepareBuilders();
+
+        const QList<Builder*>& builders = ProgrammaticApplication::builders();
+
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildMainWindowGui");
+
+            builder->buildMainWindowGui(this);
         }
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildMainWindowDocks(this);
-            }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildAdditionalMainWindowActions");
+
+            builder->buildAdditionalMainWindowActions(this);
+        }
+
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildMainWindowDocks");
+
+            builder->buildMainWindowDocks(this);
         }
 
         for (auto it=dockWidgets.begin(),end=dockWidgets.end() ; it!=end ; ++it) {
             it.value()->configureDockWidget(this);
         }
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                ProgrammaticMainWindowProxy* proxy = builder->createMainWindowProxy(this);
-                if (proxy != Q_NULLPTR) {
-                    addProxy(builder->builderIdentifier(), proxy);
-                }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "createMainWindowProxy");
+
+            ProgrammaticMainWindowProxy* proxy = builder->createMainWindowProxy(this);
+            if (proxy != Q_NULLPTR) {
+                addProxy(builder->builderIdentifier(), proxy);
             }
         }
 
         bind();
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildMainWindowFinal(this);
-            }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildMainWindowFinal");
+
+            builder->buildMainWindowFinal(this);
         }
 
         for (auto it=beginProxies(),end=endProxies() ; it!=end ; ++it) {
@@ -1140,6 +1331,16 @@ namespace EQt {
     }
 
 
+    void ProgrammaticMainWindow::menuAboutToShow() {
+        QMenu*                        menu = dynamic_cast<QMenu*>(sender());
+        ProgrammaticMainWindow::Node* node = unpopulatedMenus.value(menu, Q_NULLPTR);
+
+        if (node != Q_NULLPTR) {
+            node->populate();
+        }
+    }
+
+
     bool ProgrammaticMainWindow::addDockWidget(DockWidgetDefaults::Area location, QDockWidget* dockWidget) {
         bool addedToWindow;
 
@@ -1195,8 +1396,16 @@ namespace EQt {
             node = rootNodes.value(rootEntry);
         } else {
             node = new ProgrammaticMainWindow::Node(rootEntry, true, this);
-            menuBar()->addMenu(node->menu());
+            menuBar()->addMenu(node->createMenu());
             rootNodes.insert(rootEntry, node);
+
+            #if (defined(Q_OS_DARWIN))
+
+                // The native menu bar only moves role based actions, such as "About" and "Quit", into the application
+                // menu once they're placed in a menu.  We therefore fill in top level menus immediately.
+                node->populate();
+
+            #endif
         }
 
         int first = 1;
@@ -1216,51 +1425,51 @@ namespace EQt {
     }
 
 
-    ProgrammaticMainWindow::ActionStateMap ProgrammaticMainWindow::processActionState(
-            const Util::BitSet& actionState,
-            ActionStateMap*     multiMap,
-            bool                enableAction
-        ) {
-        Util::BitSetReverseIterator iterator(actionState);
-        ActionStateMap              adjustedActions;
-
-        while (iterator.isNotEnd() && !multiMap->isEmpty()) {
-            ActionStateMap::iterator mapIterator = multiMap->lowerBound(*iterator);
-
-            while (mapIterator != multiMap->end() && mapIterator.key().intersects(*iterator)) {
-                const Util::BitSet& entryActionState = mapIterator.key();
-                QAction*            action           = mapIterator.value();
+    void ProgrammaticMainWindow::materializeNode(ProgrammaticMainWindow::Node* node) {
+        QList<ProgrammaticMainWindow::Node*> path;
+        while (node != Q_NULLPTR) {
+            path.prepend(node);
+            node = node->parent();
+        }
 
-                adjustedActions.insert(entryActionState, action);
-                action->setEnabled(enableAction);
+        for (  QList<ProgrammaticMainWindow::Node*>::const_iterator pathIterator    = path.constBegin(),
+                                                                    pathEndIterator = path.constEnd()
+             ; pathIterator != pathEndIterator
+             ; ++pathIterator
+            ) {
+            (*pathIterator)->populate();
+        }
+    }
 
-                mapIterator = multiMap->erase(mapIterator);
-            }
 
-            ++iterator;
-        }
+    void ProgrammaticMainWindow::addMenuEntry(ProgrammaticMainWindow::Node* node, QAction* action) {
+        node->addEntry(action);
 
-        return adjustedActions;
+        // Menus are built on demand so we also associate the action with the window.  This keeps the action's
+        // shortcut live before the menu holding the action has been built.
+        QWidget::addAction(action);
     }
 
 
-    bool ProgrammaticMainWindow::removeFromMap(const QAction* action, ActionStateMap& actionMap) {
-        bool result;
+    void ProgrammaticMainWindow::updateActionEnabled(QAction* action, bool nowEnabled) {
+        if (currentActionUpdateDepth > 0) {
+            pendingActionEnables.insert(action, nowEnabled);
+        } else {
+            action->setEnabled(nowEnabled);
+        }
+    }
 
-        ActionStateMap::iterator it  = actionMap.begin();
-        ActionStateMap::iterator end = actionMap.end();
 
-        while (it != end && it.value() != action) {
-            ++it;
-        }
+    QVector<unsigned long> ProgrammaticMainWindow::setBitIndexes(const Util::BitSet& bitSet) {
+        QVector<unsigned long> result;
 
-        if (it != end) {
-            actionMap.erase(it);
-            result = true;
-        } else {
-            result = false;
+        Util::BitSetReverseIterator iterator(bitSet);
+        while (iterator.isNotEnd()) {
+            result.append(*iterator);
+            ++iterator;
         }
 
+        std::reverse(result.begin(), result.end());
         return result;
     }
 
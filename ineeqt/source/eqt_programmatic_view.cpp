@@ -27,8 +27,12 @@
 
 #include <QWidget>
 #include <QVBoxLayout>
+#include <QList>
 
 #include "eqt_common.h"
+#include "eqt_programmatic_application.h"
+#include "eqt_builder.h"
+#include "eqt_builder_profiler.h"
 #include "eqt_programmatic_main_window.h"
 #include "eqt_programmatic_view_proxy.h"
 #include "eqt_programmatic_view.h"
@@ -59,30 +63,34 @@ namespace EQt {
 
 
     void ProgrammaticView::runBuilders() {
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildViewGui(this, currentWindow);
-            }
+        ProgrammaticApplication::prepareBuilders();
+
+        const QList<Builder*>& builders = ProgrammaticApplication::builders();
+
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildViewGui");
+
+            builder->buildViewGui(this, currentWindow);
         }
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                ProgrammaticViewProxy* proxy = builder->createViewProxy(this, currentWindow);
-                if (proxy != Q_NULLPTR) {
-                    addProxy(builder->builderIdentifier(), proxy);
-                }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "createViewProxy");
+
+            ProgrammaticViewProxy* proxy = builder->createViewProxy(this, currentWindow);
+            if (proxy != Q_NULLPTR) {
+                addProxy(builder->builderIdentifier(), proxy);
             }
         }
 
         bind();
 
-        for (auto it=ProgrammaticApplication::begin(),end=ProgrammaticApplication::end() ; it!=end ; ++it) {
-            Builder* builder = dynamic_cast<Builder*>(*it);
-            if (builder != Q_NULLPTR) {
-                builder->buildViewFinal(this, currentWindow);
-            }
+        for (auto it=builders.constBegin(),end=builders.constEnd() ; it!=end ; ++it) {
+            Builder*               builder = *it;
+            BuilderProfiler::Scope scope(builder, "buildViewFinal");
+
+            builder->buildViewFinal(this, currentWindow);
         }
     }
 }
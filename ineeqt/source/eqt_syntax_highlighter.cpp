@@ -0,0 +1,104 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::SyntaxHighlighter class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QSharedPointer>
+#include <QSyntaxHighlighter>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QTextLayout>
+
+#include "eqt_syntax_rule_set.h"
+#include "eqt_syntax_highlighter.h"
+
+namespace EQt {
+    SyntaxHighlighter::SyntaxHighlighter(
+            QSharedPointer<const SyntaxRuleSet> ruleSet,
+            QTextDocument*                      parent
+        ):QSyntaxHighlighter(
+            parent
+        ),currentRuleSet(
+            ruleSet
+        ),currentInitialBlockState(
+            -1
+        ) {}
+
+
+    SyntaxHighlighter::~SyntaxHighlighter() {}
+
+
+    QSharedPointer<const SyntaxRuleSet> SyntaxHighlighter::ruleSet() const {
+        return currentRuleSet;
+    }
+
+
+    void SyntaxHighlighter::setRuleSet(QSharedPointer<const SyntaxRuleSet> newRuleSet) {
+        currentRuleSet = newRuleSet;
+        rehighlight();
+    }
+
+
+    void SyntaxHighlighter::setInitialBlockState(int newInitialBlockState) {
+        if (newInitialBlockState != currentInitialBlockState) {
+            currentInitialBlockState = newInitialBlockState;
+
+            // Blocks following the first block are highlighted again by Qt only while their states change.
+
+            if (document() != Q_NULLPTR) {
+                rehighlightBlock(document()->firstBlock());
+            }
+        }
+    }
+
+
+    int SyntaxHighlighter::initialBlockState() const {
+        return currentInitialBlockState;
+    }
+
+
+    void SyntaxHighlighter::highlightBlock(const QString& text) {
+        if (!currentRuleSet.isNull()) {
+            int previousState = (
+                  currentBlock().blockNumber() == 0
+                ? currentInitialBlockState
+                : previousBlockState()
+            );
+
+            int newBlockState = currentRuleSet->highlightBlock(text, previousState, currentFormatRanges);
+
+            for (  SyntaxRuleSet::FormatRanges::const_iterator rangeIterator    = currentFormatRanges.constBegin(),
+                                                               rangeEndIterator = currentFormatRanges.constEnd()
+                 ; rangeIterator != rangeEndIterator
+                 ; ++rangeIterator
+                ) {
+                setFormat(rangeIterator->start, rangeIterator->length, rangeIterator->format);
+            }
+
+            setCurrentBlockState(newBlockState);
+        }
+    }
+}
@@ -0,0 +1,362 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref EQt::SyntaxRuleSet class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QRegularExpressionMatchIterator>
+#include <QTextCharFormat>
+#include <QTextLayout>
+#include <QFont>
+#include <QColor>
+
+#include <algorithm>
+
+#include "eqt_cpp_lexer.h"
+#include "eqt_syntax_rule_set.h"
+
+/***********************************************************************************************************************
+ * EQt::SyntaxRuleSet::Rule
+ */
+
+namespace EQt {
+    SyntaxRuleSet::Rule::Rule() {}
+
+
+    SyntaxRuleSet::Rule::Rule(const QString& pattern, const QTextCharFormat& format) {
+        currentPattern = pattern;
+        currentFormat  = format;
+    }
+
+
+    SyntaxRuleSet::Rule::~Rule() {}
+
+
+    QString SyntaxRuleSet::Rule::pattern() const {
+        return currentPattern;
+    }
+
+
+    QTextCharFormat SyntaxRuleSet::Rule::format() const {
+        return currentFormat;
+    }
+}
+
+/***********************************************************************************************************************
+ * EQt::SyntaxRuleSet
+ */
+
+namespace EQt {
+    const int SyntaxRuleSet::normalState    = 0;
+    const int SyntaxRuleSet::multiLineState = 1;
+
+    static QMutex                                              registryMutex;
+    static bool                                                builtInRuleSetsRegistered = false;
+    static QHash<QString, QSharedPointer<const SyntaxRuleSet>> ruleSetsByFileType;
+    static QHash<QString, QString>                             fileTypesBySuffix;
+
+    /**
+     * Function that fills a range of format indexes.
+     *
+     * \param[in,out] formatIndexes The per-character format indexes.
+     *
+     * \param[in]     start         The first character to fill.
+     *
+     * \param[in]     length        The number of characters to fill.
+     *
+     * \param[in]     formatIndex   The format index to store.
+     */
+    static inline void fillFormatIndexes(QVector<short>& formatIndexes, int start, int length, short formatIndex) {
+        std::fill(formatIndexes.begin() + start, formatIndexes.begin() + start + length, formatIndex);
+    }
+
+
+    /**
+     * Function that builds the formats used by the C++ rule set, indexed by \ref EQt::CppLexer::TokenType.
+     *
+     * \return Returns the C++ formats.
+     */
+    static QVector<QTextCharFormat> cppTokenFormats() {
+        QTextCharFormat keywordFormat;
+        keywordFormat.setForeground(Qt::darkBlue);
+        keywordFormat.setFontWeight(QFont::Bold);
+
+        QTextCharFormat singleLineCommentFormat;
+        singleLineCommentFormat.setForeground(Qt::red);
+
+        QTextCharFormat quotationFormat;
+        quotationFormat.setForeground(Qt::darkGreen);
+
+        QTextCharFormat functionFormat;
+        functionFormat.setFontItalic(true);
+        functionFormat.setForeground(Qt::blue);
+
+        QTextCharFormat multiLineCommentFormat;
+        multiLineCommentFormat.setForeground(Qt::red);
+
+        QVector<QTextCharFormat> result(5);
+        result[static_cast<int>(CppLexer::TokenType::KEYWORD)]             = keywordFormat;
+        result[static_cast<int>(CppLexer::TokenType::SINGLE_LINE_COMMENT)] = singleLineCommentFormat;
+        result[static_cast<int>(CppLexer::TokenType::QUOTATION)]           = quotationFormat;
+        result[static_cast<int>(CppLexer::TokenType::FUNCTION)]            = functionFormat;
+        result[static_cast<int>(CppLexer::TokenType::MULTI_LINE_COMMENT)]  = multiLineCommentFormat;
+
+        return result;
+    }
+
+
+    SyntaxRuleSet::SyntaxRuleSet(
+            const QString&              name,
+            const SyntaxRuleSet::Rules& rules,
+            const QString&              multiLineStartPattern,
+            const QString&              multiLineEndPattern,
+            const QTextCharFormat&      multiLineFormat
+        ) {
+        currentName         = name;
+        currentUsesCppLexer = false;
+        currentIsValid      = true;
+
+        currentExpressions.reserve(rules.size());
+        currentFormats.reserve(rules.size() + 1);
+
+        for (  Rules::const_iterator ruleIterator    = rules.constBegin(),
+                                     ruleEndIterator = rules.constEnd()
+             ; ruleIterator != ruleEndIterator
+             ; ++ruleIterator
+            ) {
+            QRegularExpression expression(ruleIterator->pattern());
+            expression.optimize();
+
+            currentIsValid = currentIsValid && expression.isValid();
+
+            currentExpressions.append(expression);
+            currentFormats.append(ruleIterator->format());
+        }
+
+        if (!multiLineStartPattern.isEmpty()) {
+            currentMultiLineStartExpression = QRegularExpression(multiLineStartPattern);
+            currentMultiLineEndExpression   = QRegularExpression(multiLineEndPattern);
+
+            currentMultiLineStartExpression.optimize();
+            currentMultiLineEndExpression.optimize();
+
+            currentIsValid = (
+                   currentIsValid
+                && currentMultiLineStartExpression.isValid()
+                && currentMultiLineEndExpression.isValid()
+            );
+        }
+
+        currentFormats.append(multiLineFormat);
+    }
+
+
+    SyntaxRuleSet::SyntaxRuleSet(const QString& name, const QVector<QTextCharFormat>& tokenFormats) {
+        currentName         = name;
+        currentUsesCppLexer = true;
+        currentIsValid      = true;
+        currentFormats      = tokenFormats;
+    }
+
+
+    SyntaxRuleSet::~SyntaxRuleSet() {}
+
+
+    const QString& SyntaxRuleSet::name() const {
+        return currentName;
+    }
+
+
+    bool SyntaxRuleSet::isValid() const {
+        return currentIsValid;
+    }
+
+
+    int SyntaxRuleSet::highlightBlock(
+            const QString&               text,
+            int                          previousBlockState,
+            SyntaxRuleSet::FormatRanges& formatRanges
+        ) const {
+        int length = text.length();
+        int newBlockState;
+
+        QVector<short> formatIndexes(length, -1);
+
+        if (currentUsesCppLexer) {
+            CppLexer::Spans spans;
+            newBlockState = CppLexer::lex(text, previousBlockState, spans);
+
+            for (CppLexer::Spans::const_iterator it=spans.constBegin(),end=spans.constEnd() ; it!=end ; ++it) {
+                fillFormatIndexes(formatIndexes, it->start(), it->length(), static_cast<short>(it->tokenType()));
+            }
+        } else {
+            unsigned numberExpressions = static_cast<unsigned>(currentExpressions.size());
+            for (unsigned expressionIndex=0 ; expressionIndex<numberExpressions ; ++expressionIndex) {
+                const QRegularExpression&       expression    = currentExpressions.at(expressionIndex);
+                QRegularExpressionMatchIterator matchIterator = expression.globalMatch(text);
+                while (matchIterator.hasNext()) {
+                    QRegularExpressionMatch match = matchIterator.next();
+                    fillFormatIndexes(
+                        formatIndexes,
+                        match.capturedStart(),
+                        match.capturedLength(),
+                        static_cast<short>(expressionIndex)
+                    );
+                }
+            }
+
+            newBlockState = normalState;
+
+            if (!currentMultiLineStartExpression.pattern().isEmpty()) {
+                short multiLineFormatIndex = static_cast<short>(numberExpressions);
+
+                int startIndex = 0;
+                if (previousBlockState != multiLineState) {
+                    startIndex = text.indexOf(currentMultiLineStartExpression);
+                }
+
+                while (startIndex >= 0) {
+                    QRegularExpressionMatch match           = currentMultiLineEndExpression.match(text, startIndex);
+                    int                     endIndex        = match.capturedStart();
+                    int                     multiLineLength = 0;
+
+                    if (endIndex < 0) {
+                        newBlockState   = multiLineState;
+                        multiLineLength = length - startIndex;
+                    } else {
+                        multiLineLength = endIndex - startIndex + match.capturedLength();
+                    }
+
+                    fillFormatIndexes(formatIndexes, startIndex, multiLineLength, multiLineFormatIndex);
+                    startIndex = text.indexOf(
+                        currentMultiLineStartExpression,
+                        startIndex + std::max(1, multiLineLength)
+                    );
+                }
+            }
+        }
+
+        formatRanges.clear();
+
+        int index = 0;
+        while (index < length) {
+            short formatIndex = formatIndexes.at(index);
+            int   runEnd      = index + 1;
+            while (runEnd < length && formatIndexes.at(runEnd) == formatIndex) {
+                ++runEnd;
+            }
+
+            if (formatIndex >= 0) {
+                QTextLayout::FormatRange range;
+                range.start  = index;
+                range.length = runEnd - index;
+                range.format = currentFormats.at(formatIndex);
+
+                formatRanges.append(range);
+            }
+
+            index = runEnd;
+        }
+
+        return newBlockState;
+    }
+
+
+    QSharedPointer<const SyntaxRuleSet> SyntaxRuleSet::cppRuleSet() {
+        static const QSharedPointer<const SyntaxRuleSet> ruleSet = QSharedPointer<const SyntaxRuleSet>(
+            new SyntaxRuleSet(QString("C++"), cppTokenFormats())
+        );
+
+        return ruleSet;
+    }
+
+
+    void SyntaxRuleSet::registerRuleSet(
+            const QString&                      fileType,
+            const QStringList&                  fileSuffixes,
+            QSharedPointer<const SyntaxRuleSet> ruleSet
+        ) {
+        QMutexLocker locker(&registryMutex);
+
+        registerBuiltInRuleSets();
+
+        ruleSetsByFileType.insert(fileType, ruleSet);
+        for (QStringList::const_iterator it=fileSuffixes.constBegin(),end=fileSuffixes.constEnd() ; it!=end ; ++it) {
+            fileTypesBySuffix.insert(it->toLower(), fileType);
+        }
+    }
+
+
+    QSharedPointer<const SyntaxRuleSet> SyntaxRuleSet::ruleSetForFileType(const QString& fileType) {
+        QMutexLocker locker(&registryMutex);
+
+        registerBuiltInRuleSets();
+        return ruleSetsByFileType.value(fileType);
+    }
+
+
+    QSharedPointer<const SyntaxRuleSet> SyntaxRuleSet::ruleSetForFile(const QString& filename) {
+        QMutexLocker locker(&registryMutex);
+
+        registerBuiltInRuleSets();
+
+        QString suffix = QFileInfo(filename).suffix().toLower();
+        return ruleSetsByFileType.value(fileTypesBySuffix.value(suffix));
+    }
+
+
+    QStringList SyntaxRuleSet::fileTypes() {
+        QMutexLocker locker(&registryMutex);
+
+        registerBuiltInRuleSets();
+        return ruleSetsByFileType.keys();
+    }
+
+
+    void SyntaxRuleSet::registerBuiltInRuleSets() {
+        if (!builtInRuleSetsRegistered) {
+            builtInRuleSetsRegistered = true;
+
+            QString cppFileType("cpp");
+            ruleSetsByFileType.insert(cppFileType, cppRuleSet());
+
+            QStringList cppSuffixes;
+            cppSuffixes << "cpp" << "cxx" << "cc" << "c" << "h" << "hpp" << "hxx" << "hh" << "inl";
+            for (QStringList::const_iterator it=cppSuffixes.constBegin(),end=cppSuffixes.constEnd() ; it!=end ; ++it) {
+                fileTypesBySuffix.insert(*it, cppFileType);
+            }
+        }
+    }
+}
@@ -0,0 +1,506 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref GraphicsPixmapPyramid class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QSize>
+#include <QRect>
+#include <QPixmap>
+#include <QImage>
+#include <QImageReader>
+#include <QImageIOHandler>
+#include <QList>
+#include <QVector>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QMetaObject>
+#include <QMetaType>
+#include <QElapsedTimer>
+#include <QPair>
+
+#include <algorithm>
+
+#include "eqt_graphics_pixmap_item.h"
+#include "graphics_pixmap_pyramid.h"
+
+/***********************************************************************************************************************
+ * GraphicsPixmapPyramid::Context
+ */
+
+/**
+ * Class that holds state shared between a pyramid and the worker thread decoding its image.
+ */
+class GraphicsPixmapPyramid::Context {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] pyramid    The pyramid that should receive the decoded levels.
+         *
+         * \param[in] generation The decode this context belongs to.
+         */
+        Context(GraphicsPixmapPyramid* pyramid, unsigned generation) {
+            currentPyramid    = pyramid;
+            currentGeneration = generation;
+        }
+
+        /**
+         * Method that is called by the worker thread to deliver the decoded levels.  The levels are discarded if the
+         * pyramid was destroyed.
+         *
+         * \param[in] levels The decoded levels.
+         */
+        void deliver(const QList<QImage>& levels) {
+            QMutexLocker locker(&mutex);
+            if (currentPyramid != Q_NULLPTR && !isCanceled()) {
+                QMetaObject::invokeMethod(
+                    currentPyramid,
+                    "levelsDecoded",
+                    Qt::QueuedConnection,
+                    Q_ARG(unsigned, currentGeneration),
+                    Q_ARG(QList<QImage>, levels)
+                );
+            }
+        }
+
+        /**
+         * Method that is called to detach the pyramid from this context.
+         */
+        void detach() {
+            QMutexLocker locker(&mutex);
+            currentPyramid = Q_NULLPTR;
+            canceled.storeRelease(1);
+        }
+
+        /**
+         * Method that is called to determine if outstanding work has been canceled.
+         *
+         * \return Returns true if outstanding work has been canceled.
+         */
+        bool isCanceled() const {
+            return canceled.loadAcquire() != 0;
+        }
+
+    private:
+        /**
+         * Mutex used to guard the pyramid pointer.
+         */
+        QMutex mutex;
+
+        /**
+         * The pyramid to receive the levels.
+         */
+        GraphicsPixmapPyramid* currentPyramid;
+
+        /**
+         * The decode this context belongs to.
+         */
+        unsigned currentGeneration;
+
+        /**
+         * Flag indicating that outstanding work has been canceled.
+         */
+        QAtomicInt canceled;
+};
+
+/***********************************************************************************************************************
+ * GraphicsPixmapPyramid::Decoder
+ */
+
+/**
+ * Runnable that decodes an image and builds the pyramid levels.
+ */
+class GraphicsPixmapPyramid::Decoder:public QRunnable {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] context  The shared context used to deliver the levels.
+         *
+         * \param[in] filename The image file to be decoded.
+         */
+        Decoder(
+                QSharedPointer<Context> context,
+                const QString&          filename
+            ):currentContext(
+                context
+            ),currentFilename(
+                filename
+            ) {}
+
+        /**
+         * Method that performs the decode.
+         */
+        void run() override {
+            QList<QImage> levels;
+
+            QImageReader reader(currentFilename);
+            reader.setAutoTransform(true);
+
+            QImage image = reader.read();
+            if (!image.isNull() && !currentContext->isCanceled()) {
+                QImage::Format format = (
+                      image.hasAlphaChannel()
+                    ? QImage::Format_ARGB32_Premultiplied
+                    : QImage::Format_RGB32
+                );
+
+                levels.append(image.convertToFormat(format));
+
+                int width  = image.width();
+                int height = image.height();
+                int limit  = static_cast<int>(minimumLevelDimension);
+                while ((width > limit || height > limit) && !currentContext->isCanceled()) {
+                    width  = std::max(1, width / 2);
+                    height = std::max(1, height / 2);
+
+                    levels.append(
+                        levels.last().scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                    );
+                }
+            }
+
+            if (!currentContext->isCanceled()) {
+                currentContext->deliver(levels);
+            }
+        }
+
+    private:
+        QSharedPointer<Context> currentContext;
+        QString                 currentFilename;
+};
+
+/***********************************************************************************************************************
+ * GraphicsPixmapPyramid
+ */
+
+const unsigned GraphicsPixmapPyramid::minimumLevelDimension = 64;
+const unsigned GraphicsPixmapPyramid::defaultMemoryBudget   = 262144;
+const unsigned GraphicsPixmapPyramid::recentUseInterval     = 1000;
+
+static QList<GraphicsPixmapPyramid*> livePyramids;
+static unsigned long long            totalPyramidCost    = 0;
+static unsigned                      pyramidMemoryBudget = GraphicsPixmapPyramid::defaultMemoryBudget;
+static QElapsedTimer                 pyramidClock;
+
+/**
+ * Function that returns the time used to track when pyramids were last painted.
+ *
+ * \return Returns a monotonic time, in mSec.
+ */
+static qint64 pyramidTime() {
+    if (!pyramidClock.isValid()) {
+        pyramidClock.start();
+    }
+
+    return pyramidClock.elapsed();
+}
+
+
+/**
+ * Function that calculates the memory used by a pixmap.
+ *
+ * \param[in] pixmap The pixmap to measure.
+ *
+ * \return Returns the memory used by the pixmap, in KiB.
+ */
+static unsigned pixmapCost(const QPixmap& pixmap) {
+    unsigned long long bytes = (
+          static_cast<unsigned long long>(pixmap.width())
+        * static_cast<unsigned long long>(pixmap.height())
+        * static_cast<unsigned long long>(std::max(1, pixmap.depth() / 8))
+    );
+
+    return static_cast<unsigned>((bytes + 1023) / 1024);
+}
+
+
+/**
+ * Function used to order pyramids from least to most recently painted.
+ *
+ * \param[in] a The first pyramid and the time it was last painted.
+ *
+ * \param[in] b The second pyramid and the time it was last painted.
+ *
+ * \return Returns true if a was painted before b.
+ */
+static bool paintedEarlier(
+        const QPair<qint64, GraphicsPixmapPyramid*>& a,
+        const QPair<qint64, GraphicsPixmapPyramid*>& b
+    ) {
+    return a.first < b.first;
+}
+
+
+/**
+ * Function that calculates the size of a pyramid level.  Each level is half the size of the level above it.
+ *
+ * \param[in] imageSize  The full image size.
+ *
+ * \param[in] levelIndex The zero based level index.
+ *
+ * \return Returns the size of the level, in pixels.
+ */
+static QSize levelSize(const QSize& imageSize, unsigned levelIndex) {
+    int width  = imageSize.width();
+    int height = imageSize.height();
+
+    for (unsigned i=0 ; i<levelIndex ; ++i) {
+        width  = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    return QSize(width, height);
+}
+
+
+GraphicsPixmapPyramid::GraphicsPixmapPyramid(
+        EQt::GraphicsPixmapItem* item,
+        const QString&           filename
+    ):currentItem(
+        item
+    ),currentFilename(
+        filename
+    ) {
+    static bool metaTypeRegistered = false;
+    if (!metaTypeRegistered) {
+        qRegisterMetaType<QList<QImage>>("QList<QImage>");
+        metaTypeRegistered = true;
+    }
+
+    currentCost         = 0;
+    currentDecodeFailed = false;
+    currentGeneration   = 0;
+    lastUsed            = pyramidTime();
+
+    QImageReader reader(filename);
+    reader.setAutoTransform(true);
+
+    // Readers return an invalid size if the header can not be read or the format does not report a size.  The
+    // decoded size is reported to the item once decoding completes.
+
+    currentImageSize = reader.size();
+    if (!currentImageSize.isValid()) {
+        currentImageSize = QSize(0, 0);
+    } else if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+        currentImageSize.transpose();
+    }
+
+    livePyramids.append(this);
+    startDecode();
+}
+
+
+GraphicsPixmapPyramid::~GraphicsPixmapPyramid() {
+    if (!currentContext.isNull()) {
+        currentContext->detach();
+    }
+
+    totalPyramidCost -= currentCost;
+    livePyramids.removeOne(this);
+}
+
+
+const QString& GraphicsPixmapPyramid::filename() const {
+    return currentFilename;
+}
+
+
+QSize GraphicsPixmapPyramid::imageSize() const {
+    return currentImageSize;
+}
+
+
+bool GraphicsPixmapPyramid::isLoading() const {
+    return !currentContext.isNull();
+}
+
+
+bool GraphicsPixmapPyramid::decodeFailed() const {
+    return currentDecodeFailed;
+}
+
+
+QSize GraphicsPixmapPyramid::levelSizeForScale(double scale) const {
+    return currentLevels.isEmpty() ? QSize(0, 0) : levelSize(currentImageSize, levelIndexForScale(scale));
+}
+
+
+QPixmap GraphicsPixmapPyramid::pixmapForScale(double scale) {
+    QPixmap result;
+
+    lastUsed = pyramidTime();
+
+    if (!currentLevels.isEmpty()) {
+        unsigned levelIndex = levelIndexForScale(scale);
+
+        if (currentLevels.at(levelIndex).isNull()) {
+            if (currentContext.isNull()) {
+                startDecode();
+            }
+
+            // Use the closest level still held, preferring larger levels.
+
+            unsigned searchIndex = levelIndex;
+            while (searchIndex > 0 && currentLevels.at(searchIndex).isNull()) {
+                --searchIndex;
+            }
+
+            if (currentLevels.at(searchIndex).isNull()) {
+                searchIndex = levelIndex;
+                while (currentLevels.at(searchIndex).isNull()) {
+                    ++searchIndex;
+                }
+            }
+
+            levelIndex = searchIndex;
+        }
+
+        result = currentLevels.at(levelIndex);
+    }
+
+    return result;
+}
+
+
+void GraphicsPixmapPyramid::setMemoryBudget(unsigned newMemoryBudget) {
+    pyramidMemoryBudget = newMemoryBudget;
+    enforceMemoryBudget(Q_NULLPTR);
+}
+
+
+unsigned GraphicsPixmapPyramid::memoryBudget() {
+    return pyramidMemoryBudget;
+}
+
+
+unsigned GraphicsPixmapPyramid::levelIndexForScale(double scale) const {
+    double   displayedWidth = scale * currentImageSize.width();
+    unsigned levelIndex     = static_cast<unsigned>(currentLevels.size()) - 1;
+
+    // Released levels hold null pixmaps so level widths are derived from the image size.
+
+    while (levelIndex > 0 && levelSize(currentImageSize, levelIndex).width() < displayedWidth) {
+        --levelIndex;
+    }
+
+    return levelIndex;
+}
+
+
+void GraphicsPixmapPyramid::levelsDecoded(unsigned generation, const QList<QImage>& levels) {
+    if (!currentContext.isNull() && generation == currentGeneration) {
+        currentContext.reset();
+
+        if (!levels.isEmpty()) {
+            release();
+            currentLevels.clear();
+            currentLevels.reserve(levels.size());
+
+            for (QList<QImage>::const_iterator it=levels.constBegin(),end=levels.constEnd() ; it!=end ; ++it) {
+                currentLevels.append(QPixmap::fromImage(*it));
+            }
+
+            unsigned numberLevels = static_cast<unsigned>(currentLevels.size());
+            for (unsigned levelIndex=0 ; levelIndex<numberLevels - 1 ; ++levelIndex) {
+                currentCost += pixmapCost(currentLevels.at(levelIndex));
+            }
+
+            totalPyramidCost += currentCost;
+            enforceMemoryBudget(this);
+
+            // The item must be told before the size changes so the scene index sees the old geometry.
+
+            QSize newImageSize = currentLevels.first().size();
+            currentItem->imageDecoded(newImageSize != currentImageSize);
+            currentImageSize = newImageSize;
+        } else if (currentLevels.isEmpty()) {
+            // Nothing was ever decoded so the item collapses to an empty size rather than keep a placeholder the
+            // size reported by the image header.
+
+            currentDecodeFailed = true;
+
+            QSize newImageSize(0, 0);
+            currentItem->imageDecoded(newImageSize != currentImageSize);
+            currentImageSize = newImageSize;
+        } else {
+            // A re-decode of released levels failed.  The smallest level is still held and remains in use.
+
+            currentItem->imageDecoded(false);
+        }
+    }
+}
+
+
+void GraphicsPixmapPyramid::startDecode() {
+    ++currentGeneration;
+    currentContext = QSharedPointer<Context>(new Context(this, currentGeneration));
+    QThreadPool::globalInstance()->start(new Decoder(currentContext, currentFilename));
+}
+
+
+void GraphicsPixmapPyramid::release() {
+    unsigned numberLevels = static_cast<unsigned>(currentLevels.size());
+    for (unsigned levelIndex=0 ; levelIndex+1<numberLevels ; ++levelIndex) {
+        currentLevels[levelIndex] = QPixmap();
+    }
+
+    totalPyramidCost -= currentCost;
+    currentCost       = 0;
+}
+
+
+void GraphicsPixmapPyramid::enforceMemoryBudget(GraphicsPixmapPyramid* keep) {
+    if (totalPyramidCost > pyramidMemoryBudget) {
+        qint64 protectedAfter = pyramidTime() - recentUseInterval;
+
+        QVector<QPair<qint64, GraphicsPixmapPyramid*>> candidates;
+        for (  QList<GraphicsPixmapPyramid*>::const_iterator pyramidIterator    = livePyramids.constBegin(),
+                                                             pyramidEndIterator = livePyramids.constEnd()
+             ; pyramidIterator != pyramidEndIterator
+             ; ++pyramidIterator
+            ) {
+            GraphicsPixmapPyramid* pyramid = *pyramidIterator;
+            if (pyramid != keep && pyramid->currentCost > 0 && pyramid->lastUsed < protectedAfter) {
+                candidates.append(QPair<qint64, GraphicsPixmapPyramid*>(pyramid->lastUsed, pyramid));
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), paintedEarlier);
+
+        QVector<QPair<qint64, GraphicsPixmapPyramid*>>::const_iterator candidateIterator    = candidates.constBegin();
+        QVector<QPair<qint64, GraphicsPixmapPyramid*>>::const_iterator candidateEndIterator = candidates.constEnd();
+        while (totalPyramidCost > pyramidMemoryBudget && candidateIterator != candidateEndIterator) {
+            candidateIterator->second->release();
+            ++candidateIterator;
+        }
+    }
+}
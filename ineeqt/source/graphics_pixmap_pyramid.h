@@ -0,0 +1,236 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref GraphicsPixmapPyramid class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineeqt */
+
+#ifndef GRAPHICS_PIXMAP_PYRAMID_H
+#define GRAPHICS_PIXMAP_PYRAMID_H
+
+#include <QObject>
+#include <QString>
+#include <QSize>
+#include <QPixmap>
+#include <QImage>
+#include <QList>
+#include <QVector>
+#include <QSharedPointer>
+
+namespace EQt {
+    class GraphicsPixmapItem;
+}
+
+/**
+ * Class that decodes an image file on a worker thread and holds a pyramid of successively halved pixmaps for a
+ * \ref EQt::GraphicsPixmapItem.  All pyramids share a single memory budget.  When the budget is exceeded, pyramids
+ * that have not been painted recently release every level except the smallest and are decoded again when next
+ * painted.
+ */
+class GraphicsPixmapPyramid:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * The size, in pixels, below which no further levels are generated.  The smallest level is never released.
+         */
+        static const unsigned minimumLevelDimension;
+
+        /**
+         * The default memory budget shared by all pyramids, in KiB.
+         */
+        static const unsigned defaultMemoryBudget;
+
+        /**
+         * Time, in mSec, during which a recently painted pyramid is protected from being released.
+         */
+        static const unsigned recentUseInterval;
+
+        /**
+         * Constructor.  The image header is read immediately to determine the image size.  Decoding is started on
+         * the global thread pool.
+         *
+         * \param[in] item     The item to be notified when decoding completes.
+         *
+         * \param[in] filename The image file to be decoded.
+         */
+        GraphicsPixmapPyramid(EQt::GraphicsPixmapItem* item, const QString& filename);
+
+        ~GraphicsPixmapPyramid() override;
+
+        /**
+         * Method you can use to obtain the image filename.
+         *
+         * \return Returns the image filename.
+         */
+        const QString& filename() const;
+
+        /**
+         * Method you can use to obtain the full size of the image.
+         *
+         * \return Returns the image size, in pixels.  An empty size is returned if the image header could not be
+         *         read or if the image could not be decoded.
+         */
+        QSize imageSize() const;
+
+        /**
+         * Method you can use to determine if a decode is underway.
+         *
+         * \return Returns true if the image is being decoded.
+         */
+        bool isLoading() const;
+
+        /**
+         * Method you can use to determine if the image could not be decoded.
+         *
+         * \return Returns true if decoding completed without producing an image.
+         */
+        bool decodeFailed() const;
+
+        /**
+         * Method you can use to determine which level would be used to draw the image at a given scale factor.
+         * Unlike \ref GraphicsPixmapPyramid::pixmapForScale, this method does not restart decoding or mark the
+         * pyramid as used.
+         *
+         * \param[in] scale The number of device pixels per image pixel.
+         *
+         * \return Returns the size of the preferred level.  An empty size is returned if the image has not been
+         *         decoded.
+         */
+        QSize levelSizeForScale(double scale) const;
+
+        /**
+         * Method that selects the pixmap best suited for a given scale factor.  The smallest level that is at least
+         * as large as the displayed image is preferred.  If that level has been released, decoding is restarted and
+         * the closest available level is returned.
+         *
+         * \param[in] scale The number of device pixels per image pixel.
+         *
+         * \return Returns the selected pixmap.  A null pixmap is returned if no level is available yet.
+         */
+        QPixmap pixmapForScale(double scale);
+
+        /**
+         * Method you can use to set the memory budget shared by all pyramids.
+         *
+         * \param[in] newMemoryBudget The new budget, in KiB.
+         */
+        static void setMemoryBudget(unsigned newMemoryBudget);
+
+        /**
+         * Method you can use to obtain the memory budget shared by all pyramids.
+         *
+         * \return Returns the budget, in KiB.
+         */
+        static unsigned memoryBudget();
+
+    private slots:
+        /**
+         * Slot that is triggered when a worker thread has decoded the image.
+         *
+         * \param[in] generation The decode the levels belong to.
+         *
+         * \param[in] levels     The decoded levels, largest first.  An empty list indicates the image could not be
+         *                       decoded.
+         */
+        void levelsDecoded(unsigned generation, const QList<QImage>& levels);
+
+    private:
+        class Context;
+        class Decoder;
+
+        /**
+         * Method that selects the smallest level that is at least as wide as the image will be drawn.
+         *
+         * \param[in] scale The number of device pixels per image pixel.
+         *
+         * \return Returns the index of the preferred level.  The level may have been released.
+         */
+        unsigned levelIndexForScale(double scale) const;
+
+        /**
+         * Method that starts decoding the image on the global thread pool.
+         */
+        void startDecode();
+
+        /**
+         * Method that releases every level except the smallest.
+         */
+        void release();
+
+        /**
+         * Method that releases pyramids, least recently painted first, until the shared budget is met.
+         *
+         * \param[in] keep A pyramid that should not be released.
+         */
+        static void enforceMemoryBudget(GraphicsPixmapPyramid* keep);
+
+        /**
+         * The item to be notified.
+         */
+        EQt::GraphicsPixmapItem* currentItem;
+
+        /**
+         * The image filename.
+         */
+        QString currentFilename;
+
+        /**
+         * The full image size.
+         */
+        QSize currentImageSize;
+
+        /**
+         * The pyramid levels, largest first.  Released levels hold null pixmaps.
+         */
+        QVector<QPixmap> currentLevels;
+
+        /**
+         * The memory used by the releasable levels, in KiB.
+         */
+        unsigned currentCost;
+
+        /**
+         * Context shared with the worker thread for the decode underway.
+         */
+        QSharedPointer<Context> currentContext;
+
+        /**
+         * Flag indicating that decoding completed without producing an image.
+         */
+        bool currentDecodeFailed;
+
+        /**
+         * Counter used to identify each decode.
+         */
+        unsigned currentGeneration;
+
+        /**
+         * The time this pyramid was last painted, in mSec.
+         */
+        qint64 lastUsed;
+};
+
+#endif
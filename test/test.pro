@@ -26,7 +26,7 @@
 #
 
 TEMPLATE = app
-QT += core testlib gui widgets network
+QT += core testlib gui widgets network charts
 CONFIG += testcase c++14
 
 HEADERS = application_wrapper.h \
@@ -35,6 +35,15 @@ HEADERS = application_wrapper.h \
           test_unique_application.h \
           test_programmatic_dock_widget.h \
           test_programmatic_main_window.h \
+          test_cpp_lexer.h \
+          test_builder_profiler.h \
+          test_graphics_scene_page_renderer.h \
+          test_graphics_scene.h \
+          test_graphics_item_serializer.h \
+          test_chart_series_decimator.h \
+          test_code_editor_search_engine.h \
+          test_chart_streaming_series.h \
+          test_graphics_pixmap_item.h \
 
 SOURCES = test_ineeqt.cpp \
           application_wrapper.cpp \
@@ -43,6 +52,15 @@ SOURCES = test_ineeqt.cpp \
           test_unique_application.cpp \
           test_programmatic_dock_widget.cpp \
           test_programmatic_main_window.cpp \
+          test_cpp_lexer.cpp \
+          test_builder_profiler.cpp \
+          test_graphics_scene_page_renderer.cpp \
+          test_graphics_scene.cpp \
+          test_graphics_item_serializer.cpp \
+          test_chart_series_decimator.cpp \
+          test_code_editor_search_engine.cpp \
+          test_chart_streaming_series.cpp \
+          test_graphics_pixmap_item.cpp \
 
 ########################################################################################################################
 # Libraries
@@ -0,0 +1,269 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref BuilderProfiler class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QList>
+#include <QAtomicInt>
+
+#include <eqt_builder_base.h>
+#include <eqt_builder.h>
+#include <eqt_builder_profiler.h>
+#include <eqt_programmatic_application.h>
+
+#include "test_builder_profiler.h"
+
+/***********************************************************************************************************************
+ * Class ProfiledBuilder
+ */
+
+class ProfiledBuilder:public EQt::BuilderBase {
+    public:
+        ProfiledBuilder(const char* identifier, const char* plugIn);
+
+        ~ProfiledBuilder() override;
+
+        unsigned priority() const override;
+
+        const char* builderIdentifier() const override;
+
+        const char* plugInName() const override;
+
+    private:
+        const char* currentIdentifier;
+        const char* currentPlugIn;
+};
+
+
+ProfiledBuilder::ProfiledBuilder(const char* identifier, const char* plugIn) {
+    currentIdentifier = identifier;
+    currentPlugIn     = plugIn;
+}
+
+
+ProfiledBuilder::~ProfiledBuilder() {}
+
+
+unsigned ProfiledBuilder::priority() const {
+    return 0;
+}
+
+
+const char* ProfiledBuilder::builderIdentifier() const {
+    return currentIdentifier;
+}
+
+
+const char* ProfiledBuilder::plugInName() const {
+    return currentPlugIn;
+}
+
+/***********************************************************************************************************************
+ * Class CountingBuilder
+ */
+
+class CountingBuilder:public EQt::Builder {
+    public:
+        CountingBuilder(const char* identifier, unsigned priority);
+
+        ~CountingBuilder() override;
+
+        void prepare() override;
+
+        unsigned priority() const override;
+
+        const char* builderIdentifier() const override;
+
+        const char* plugInName() const override;
+
+        int numberPrepareCalls() const;
+
+    private:
+        const char* currentIdentifier;
+        unsigned    currentPriority;
+        QAtomicInt  currentNumberPrepareCalls;
+};
+
+
+CountingBuilder::CountingBuilder(const char* identifier, unsigned priority) {
+    currentIdentifier = identifier;
+    currentPriority   = priority;
+}
+
+
+CountingBuilder::~CountingBuilder() {}
+
+
+void CountingBuilder::prepare() {
+    currentNumberPrepareCalls.fetchAndAddOrdered(1);
+}
+
+
+unsigned CountingBuilder::priority() const {
+    return currentPriority;
+}
+
+
+const char* CountingBuilder::builderIdentifier() const {
+    return currentIdentifier;
+}
+
+
+const char* CountingBuilder::plugInName() const {
+    return "";
+}
+
+
+int CountingBuilder::numberPrepareCalls() const {
+    return currentNumberPrepareCalls.loadAcquire();
+}
+
+/***********************************************************************************************************************
+ * Class TestBuilderProfiler
+ */
+
+void TestBuilderProfiler::testRecord() {
+    EQt::BuilderProfiler::clear();
+
+    ProfiledBuilder fastBuilder("Test::FastBuilder", "");
+    ProfiledBuilder slowBuilder("Test::SlowBuilder", "TestPlugIn");
+
+    EQt::BuilderProfiler::record(&fastBuilder, "buildMainWindowGui", 1000);
+    EQt::BuilderProfiler::record(&slowBuilder, "buildMainWindowGui", 5000);
+    EQt::BuilderProfiler::record(&fastBuilder, "buildMainWindowGui", 2000);
+    EQt::BuilderProfiler::record(&fastBuilder, "prepare", 500);
+
+    QList<EQt::BuilderProfiler::Timing> timings = EQt::BuilderProfiler::timings();
+    QCOMPARE(timings.size(), 3);
+
+    QCOMPARE(timings.at(0).builderIdentifier(), QString("Test::SlowBuilder"));
+    QCOMPARE(timings.at(0).plugInName(), QString("TestPlugIn"));
+    QCOMPARE(timings.at(0).elapsedNanoseconds(), qint64(5000));
+    QCOMPARE(timings.at(0).numberCalls(), 1UL);
+
+    QCOMPARE(timings.at(1).builderIdentifier(), QString("Test::FastBuilder"));
+    QCOMPARE(timings.at(1).phase(), QString("buildMainWindowGui"));
+    QCOMPARE(timings.at(1).elapsedNanoseconds(), qint64(3000));
+    QCOMPARE(timings.at(1).numberCalls(), 2UL);
+
+    QCOMPARE(timings.at(2).phase(), QString("prepare"));
+
+    EQt::BuilderProfiler::clear();
+    QCOMPARE(EQt::BuilderProfiler::timings().isEmpty(), true);
+}
+
+
+void TestBuilderProfiler::testScope() {
+    EQt::BuilderProfiler::clear();
+
+    ProfiledBuilder builder("Test::ScopedBuilder", "");
+
+    EQt::BuilderProfiler::setProfilingDisabled();
+    QCOMPARE(EQt::BuilderProfiler::profilingEnabled(), false);
+
+    {
+        EQt::BuilderProfiler::Scope scope(&builder, "buildViewGui");
+    }
+
+    QCOMPARE(EQt::BuilderProfiler::timings().isEmpty(), true);
+
+    EQt::BuilderProfiler::setProfilingEnabled();
+    QCOMPARE(EQt::BuilderProfiler::profilingDisabled(), false);
+
+    {
+        EQt::BuilderProfiler::Scope scope(&builder, "buildViewGui");
+    }
+
+    EQt::BuilderProfiler::setProfilingDisabled();
+
+    QList<EQt::BuilderProfiler::Timing> timings = EQt::BuilderProfiler::timings();
+    QCOMPARE(timings.size(), 1);
+    QCOMPARE(timings.first().phase(), QString("buildViewGui"));
+    QCOMPARE(timings.first().numberCalls(), 1UL);
+
+    EQt::BuilderProfiler::clear();
+}
+
+
+void TestBuilderProfiler::testReport() {
+    EQt::BuilderProfiler::clear();
+
+    ProfiledBuilder fastBuilder("Test::FastBuilder", "");
+    ProfiledBuilder slowBuilder("Test::SlowBuilder", "TestPlugIn");
+
+    EQt::BuilderProfiler::record(&fastBuilder, "registerResources", 1000000);
+    EQt::BuilderProfiler::record(&slowBuilder, "prepare", 4000000);
+
+    QString report = EQt::BuilderProfiler::report();
+
+    QCOMPARE(report.contains("5.000 ms total"), true);
+
+    int slowIndex = report.indexOf("Test::SlowBuilder (TestPlugIn)::prepare");
+    int fastIndex = report.indexOf("Test::FastBuilder::registerResources");
+
+    QVERIFY(slowIndex >= 0);
+    QVERIFY(fastIndex > slowIndex);
+
+    EQt::BuilderProfiler::clear();
+}
+
+
+void TestBuilderProfiler::testPrepareBuilders() {
+    // The application owns the builders, so they're left in the builder list once the test completes.
+
+    CountingBuilder* lateBuilder  = new CountingBuilder("Test::LateBuilder", 20);
+    CountingBuilder* earlyBuilder = new CountingBuilder("Test::EarlyBuilder", 10);
+
+    int numberBuilders = EQt::ProgrammaticApplication::builders().size();
+
+    EQt::ProgrammaticApplication::addBuilder(lateBuilder);
+    EQt::ProgrammaticApplication::addBuilder(new ProfiledBuilder("Test::UntypedBuilder", ""));
+    EQt::ProgrammaticApplication::addBuilder(earlyBuilder);
+
+    const QList<EQt::Builder*>& builders = EQt::ProgrammaticApplication::builders();
+    QCOMPARE(builders.size(), numberBuilders + 2);
+    QVERIFY(builders.indexOf(earlyBuilder) >= 0);
+    QVERIFY(builders.indexOf(earlyBuilder) < builders.indexOf(lateBuilder));
+
+    EQt::ProgrammaticApplication::prepareBuilders();
+    QCOMPARE(earlyBuilder->numberPrepareCalls(), 1);
+    QCOMPARE(lateBuilder->numberPrepareCalls(), 1);
+
+    // Builders are only prepared once, including builders added after an earlier call.
+
+    CountingBuilder* addedBuilder = new CountingBuilder("Test::AddedBuilder", 15);
+    EQt::ProgrammaticApplication::addBuilder(addedBuilder);
+
+    QCOMPARE(builders.indexOf(addedBuilder), builders.indexOf(earlyBuilder) + 1);
+    QCOMPARE(builders.indexOf(lateBuilder), builders.indexOf(addedBuilder) + 1);
+
+    EQt::ProgrammaticApplication::prepareBuilders();
+    QCOMPARE(earlyBuilder->numberPrepareCalls(), 1);
+    QCOMPARE(lateBuilder->numberPrepareCalls(), 1);
+    QCOMPARE(addedBuilder->numberPrepareCalls(), 1);
+}
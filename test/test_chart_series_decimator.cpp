@@ -0,0 +1,145 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref ChartSeriesDecimator class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QVector>
+#include <QPointF>
+
+#include <cmath>
+
+#include <eqt_chart_series_decimator.h>
+
+#include "test_chart_series_decimator.h"
+
+void TestChartSeriesDecimator::testMinMaxDegenerateInput() {
+    QVector<QPointF> points;
+    points << QPointF(1, 2);
+
+    const QPointF* begin = points.constData();
+
+    QCOMPARE(EQt::ChartSeriesDecimator::minMaxDecimate(begin, begin, 4).size(), 0);
+    QCOMPARE(EQt::ChartSeriesDecimator::minMaxDecimate(begin, begin + 1, 0).size(), 0);
+    QCOMPARE(EQt::ChartSeriesDecimator::minMaxDecimate(begin, begin + 1, 4), points);
+
+    points << QPointF(2, 2) << QPointF(3, 2);
+    begin = points.constData();
+
+    QVector<QPointF> flat = EQt::ChartSeriesDecimator::minMaxDecimate(begin, begin + points.size(), 1);
+    QCOMPARE(flat.size(), 2);
+    QCOMPARE(flat.first(), points.first());
+    QCOMPARE(flat.last(), points.last());
+}
+
+
+void TestChartSeriesDecimator::testMinMaxEndPoints() {
+    QVector<QPointF> data  = testData();
+    const QPointF*   begin = data.constData();
+    const QPointF*   end   = begin + data.size();
+
+    // A falling line makes the first point of the first bucket its maximum and the last point of the last bucket its
+    // minimum.
+
+    QVector<QPointF> falling;
+    for (unsigned i=0 ; i<numberTestPoints ; ++i) {
+        falling.append(QPointF(i, -static_cast<double>(i)));
+    }
+
+    for (unsigned numberBuckets=1 ; numberBuckets<=1024 ; numberBuckets*=4) {
+        QVector<QPointF> reduced = EQt::ChartSeriesDecimator::minMaxDecimate(begin, end, numberBuckets);
+        QCOMPARE(reduced.first(), data.first());
+        QCOMPARE(reduced.last(), data.last());
+        QVERIFY(strictlyIncreasing(reduced));
+        QVERIFY(static_cast<unsigned>(reduced.size()) <= 2 * numberBuckets + 2);
+
+        reduced = EQt::ChartSeriesDecimator::minMaxDecimate(
+            falling.constData(),
+            falling.constData() + falling.size(),
+            numberBuckets
+        );
+        QCOMPARE(reduced.first(), falling.first());
+        QCOMPARE(reduced.last(), falling.last());
+        QVERIFY(strictlyIncreasing(reduced));
+    }
+}
+
+
+void TestChartSeriesDecimator::testMinMaxExtremes() {
+    QVector<QPointF> data = testData();
+    data[1234].setY(1000);
+    data[8765].setY(-1000);
+
+    QVector<QPointF> reduced = EQt::ChartSeriesDecimator::minMaxDecimate(
+        data.constData(),
+        data.constData() + data.size(),
+        50
+    );
+
+    QVERIFY(reduced.contains(data.at(1234)));
+    QVERIFY(reduced.contains(data.at(8765)));
+}
+
+
+void TestChartSeriesDecimator::testLttbDecimate() {
+    QVector<QPointF> data  = testData();
+    const QPointF*   begin = data.constData();
+    const QPointF*   end   = begin + data.size();
+
+    QVector<QPointF> reduced = EQt::ChartSeriesDecimator::lttbDecimate(begin, end, 100);
+    QCOMPARE(reduced.size(), 100);
+    QCOMPARE(reduced.first(), data.first());
+    QCOMPARE(reduced.last(), data.last());
+    QVERIFY(strictlyIncreasing(reduced));
+
+    QCOMPARE(EQt::ChartSeriesDecimator::lttbDecimate(begin, begin + 50, 100).size(), 50);
+    QCOMPARE(EQt::ChartSeriesDecimator::lttbDecimate(begin, end, 2).size(), data.size());
+}
+
+
+QVector<QPointF> TestChartSeriesDecimator::testData() {
+    QVector<QPointF> result;
+    result.reserve(numberTestPoints);
+
+    for (unsigned i=0 ; i<numberTestPoints ; ++i) {
+        result.append(QPointF(0.5 * i, std::sin(0.01 * i) + 0.25 * std::sin(1.3 * i)));
+    }
+
+    return result;
+}
+
+
+bool TestChartSeriesDecimator::strictlyIncreasing(const QVector<QPointF>& points) {
+    bool     result = true;
+    unsigned index  = 1;
+
+    while (result && index < static_cast<unsigned>(points.size())) {
+        result = points.at(index - 1).x() < points.at(index).x();
+        ++index;
+    }
+
+    return result;
+}
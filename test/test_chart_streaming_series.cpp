@@ -0,0 +1,73 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref EQt::ChartStreamingSeries class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QSizeF>
+
+#include <eqt_charts.h>
+#include <eqt_chart_streaming_series.h>
+
+#include "test_chart_streaming_series.h"
+
+void TestChartStreamingSeries::testAxisRangeChanged() {
+    QChart       chart;
+    QLineSeries* series = new QLineSeries;
+    QValueAxis*  axisX  = new QValueAxis;
+    QValueAxis*  axisY  = new QValueAxis;
+
+    chart.resize(QSizeF(1000, 600));
+    chart.addSeries(series);
+    chart.addAxis(axisX, Qt::AlignBottom);
+    chart.addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+
+    axisX->setRange(0, 49);
+
+    EQt::ChartStreamingSeries streamingSeries(series, 200);
+    streamingSeries.setScrollPolicy(EQt::ChartStreamingSeries::ScrollPolicy::NONE);
+
+    for (unsigned i=0 ; i<200 ; ++i) {
+        streamingSeries.append(i, i % 7);
+    }
+
+    streamingSeries.flush();
+
+    // One sample beyond each edge of the axis range is published.
+
+    QCOMPARE(series->count(), 51);
+
+    // Zooming out or panning without appending publishes the newly visible samples.
+
+    axisX->setRange(0, 149);
+    QTRY_COMPARE(series->count(), 151);
+
+    axisX->setRange(100, 149);
+    QTRY_COMPARE(series->count(), 52);
+    QCOMPARE(series->at(0).x(), 99.0);
+}
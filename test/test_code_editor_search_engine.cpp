@@ -0,0 +1,188 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref EQt::CodeEditorSearchEngine class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QList>
+#include <QTextEdit>
+#include <QTextCursor>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QCoreApplication>
+
+#include <eqt_code_editor.h>
+#include <eqt_code_editor_search_engine.h>
+
+#include "test_code_editor_search_engine.h"
+
+void TestCodeEditorSearchEngine::testWholeWordsOnly() {
+    EQt::CodeEditor              editor(QString("foo food foo_bar afoo foo\nfoo-bar"));
+    EQt::CodeEditorSearchEngine* engine = new EQt::CodeEditorSearchEngine(&editor);
+
+    engine->setSearchText(QString("foo"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 6UL);
+
+    engine->setWholeWordsOnlyEnabled();
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 3UL);
+
+    engine->setWholeWordsOnlyDisabled();
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 6UL);
+}
+
+
+void TestCodeEditorSearchEngine::testRegularExpression() {
+    EQt::CodeEditor              editor(QString("a1 b22 c333\nd4444"));
+    EQt::CodeEditorSearchEngine* engine = new EQt::CodeEditorSearchEngine(&editor);
+
+    engine->setRegularExpressionSearchEnabled();
+    engine->setSearchText(QString("\\d+"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->searchIsValid(), true);
+    QCOMPARE(engine->numberMatches(), 4UL);
+
+    engine->setWholeWordsOnlyEnabled();
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 0UL);
+
+    engine->setSearchText(QString("[a-z]\\d+"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 4UL);
+
+    engine->setSearchText(QString("("));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->searchIsValid(), false);
+    QCOMPARE(engine->numberMatches(), 0UL);
+}
+
+
+void TestCodeEditorSearchEngine::testWrapAround() {
+    EQt::CodeEditor              editor(QString("foo\nbar\nfoo bar foo\nbar"));
+    EQt::CodeEditorSearchEngine* engine = new EQt::CodeEditorSearchEngine(&editor);
+
+    engine->setSearchText(QString("foo"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 3UL);
+    QCOMPARE(engine->currentMatchIndex(), -1L);
+
+    QTextCursor cursor = editor.textCursor();
+    cursor.movePosition(QTextCursor::End);
+    editor.setTextCursor(cursor);
+
+    engine->findNext();
+    QCOMPARE(engine->currentMatchIndex(), 0L);
+    QCOMPARE(editor.textCursor().selectionStart(), 0);
+
+    engine->findNext();
+    QCOMPARE(engine->currentMatchIndex(), 1L);
+    QCOMPARE(editor.textCursor().selectionStart(), 8);
+
+    engine->findNext();
+    QCOMPARE(engine->currentMatchIndex(), 2L);
+    QCOMPARE(editor.textCursor().selectionStart(), 16);
+
+    engine->findNext();
+    QCOMPARE(engine->currentMatchIndex(), 0L);
+    QCOMPARE(editor.textCursor().selectedText(), QString("foo"));
+
+    engine->findPrevious();
+    QCOMPARE(engine->currentMatchIndex(), 2L);
+    QCOMPARE(editor.textCursor().selectionStart(), 16);
+
+    engine->findPrevious();
+    QCOMPARE(engine->currentMatchIndex(), 1L);
+    QCOMPARE(editor.textCursor().selectionStart(), 8);
+}
+
+
+void TestCodeEditorSearchEngine::testIncrementalUpdate() {
+    EQt::CodeEditor              editor(QString("foo\nbar\nbaz\nfoo"));
+    EQt::CodeEditorSearchEngine* engine = new EQt::CodeEditorSearchEngine(&editor);
+
+    engine->setSearchText(QString("foo"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 2UL);
+
+    engine->findNext();
+    engine->findNext();
+    QCOMPARE(engine->currentMatchIndex(), 1L);
+
+    // Edits before the current match shift its index without changing the match itself.
+
+    QTextCursor cursor(editor.document()->findBlockByNumber(1));
+    cursor.insertText(QString("foo "));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 3UL);
+    QCOMPARE(engine->currentMatchIndex(), 2L);
+
+    cursor = QTextCursor(editor.document()->firstBlock());
+    cursor.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor);
+    cursor.removeSelectedText();
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 2UL);
+    QCOMPARE(engine->currentMatchIndex(), 1L);
+
+    // Edits to the block holding the current match forget the match.
+
+    cursor = QTextCursor(editor.document()->lastBlock());
+    cursor.insertText(QString("foo"));
+    QTRY_VERIFY(engine->isIdle());
+    QCOMPARE(engine->numberMatches(), 3UL);
+    QCOMPARE(engine->currentMatchIndex(), -1L);
+}
+
+
+void TestCodeEditorSearchEngine::testEmptySearchText() {
+    EQt::CodeEditor              editor(QString("foo\nbar"));
+    EQt::CodeEditorSearchEngine* engine = new EQt::CodeEditorSearchEngine(&editor);
+
+    engine->setSearchText(QString("foo"));
+    QTRY_VERIFY(engine->isIdle());
+
+    QList<QTextEdit::ExtraSelection> selections;
+    QTextEdit::ExtraSelection        selection;
+    selection.cursor = QTextCursor(editor.document()->lastBlock());
+    selections.append(selection);
+
+    editor.setExtraSelections(selections);
+
+    engine->setSearchText(QString());
+    QCOMPARE(editor.extraSelections().size(), 0);
+
+    // Selections set by others are left alone while no search string is set.
+
+    editor.setExtraSelections(selections);
+
+    engine->research();
+    QTRY_VERIFY(engine->isIdle());
+    QCoreApplication::processEvents();
+
+    QCOMPARE(editor.extraSelections().size(), 1);
+}
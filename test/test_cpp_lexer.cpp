@@ -0,0 +1,291 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref CppLexer class.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QRegularExpressionMatchIterator>
+
+#include <eqt_cpp_lexer.h>
+
+#include "test_cpp_lexer.h"
+
+/***********************************************************************************************************************
+ * Class TestCppLexer:
+ */
+
+TestCppLexer::TestCppLexer() {
+    QStringList keywords;
+    keywords << "char" << "class" << "const" << "double" << "enum" << "explicit"
+             << "friend" << "inline" << "int" << "long" << "namespace" << "operator"
+             << "private" << "protected" << "public" << "short" << "signals" << "signed"
+             << "slots" << "static" << "struct" << "template" << "typedef" << "typename"
+             << "union" << "unsigned" << "virtual" << "void" << "volatile" << "bool";
+
+    for (QStringList::const_iterator it=keywords.constBegin(),end=keywords.constEnd() ; it!=end ; ++it) {
+        keywordExpressions.append(QRegularExpression(QString("\\b%1\\b").arg(*it)));
+    }
+
+    singleLineCommentExpression = QRegularExpression("//[^\n]*");
+    quotationExpression         = QRegularExpression("\".*\"");
+    functionExpression          = QRegularExpression("\\b[A-Za-z0-9_]+(?=\\()");
+}
+
+
+TestCppLexer::~TestCppLexer() {}
+
+
+void TestCppLexer::testKnownCases() {
+    QStringList blocks;
+    blocks << ""
+           << "int main(int argc, char** argv) {"
+           << "    static const unsigned value = 3; // int comment \"quoted\""
+           << "    printf(\"%d int\\n\", value); /* comment */ void"
+           << "/*/ still a comment */ int"
+           << "*/*/ int x; /* open"
+           << "int inside(); // still open"
+           << "end */ char y; //* trailing"
+           << "a/**/b///*c"
+           << "unsignedint signed_ _int int_ 9int int9("
+           << "\"one \"two\" three\" four\""
+           << "voi\xC3\xA9 int\xC3\xA9 \xC3\xA9int"
+           << "/* unterminated"
+           << ""
+           << "\"*/\" int";
+
+    compareBlocks(blocks);
+}
+
+
+void TestCppLexer::testRandomCases() {
+    quint32 seed = 12345;
+
+    for (unsigned i=0 ; i<numberRandomCases ; ++i) {
+        QStringList blocks;
+        unsigned numberBlocks = 1 + seed % 4;
+        for (unsigned blockIndex=0 ; blockIndex<numberBlocks ; ++blockIndex) {
+            blocks << randomBlock(seed);
+        }
+
+        compareBlocks(blocks);
+    }
+}
+
+
+void TestCppLexer::testBlockState() {
+    EQt::CppLexer::Spans spans;
+
+    QCOMPARE(EQt::CppLexer::lex("int x; /* open", EQt::CppLexer::normalState, spans), 1);
+    QCOMPARE(spans.size(), 2);
+    QVERIFY(spans.at(0) == EQt::CppLexer::Span(0, 3, EQt::CppLexer::TokenType::KEYWORD));
+    QVERIFY(spans.at(1) == EQt::CppLexer::Span(7, 7, EQt::CppLexer::TokenType::MULTI_LINE_COMMENT));
+
+    QCOMPARE(EQt::CppLexer::lex("", EQt::CppLexer::multiLineCommentState, spans), 1);
+    QCOMPARE(spans.size(), 0);
+
+    QCOMPARE(EQt::CppLexer::lex("close */ void", EQt::CppLexer::multiLineCommentState, spans), 0);
+    QCOMPARE(spans.size(), 2);
+    QVERIFY(spans.at(0) == EQt::CppLexer::Span(9, 4, EQt::CppLexer::TokenType::KEYWORD));
+    QVERIFY(spans.at(1) == EQt::CppLexer::Span(0, 8, EQt::CppLexer::TokenType::MULTI_LINE_COMMENT));
+
+    QCOMPARE(EQt::CppLexer::lex("close */ void", -1, spans), 0);
+    QCOMPARE(spans.size(), 1);
+}
+
+
+void TestCppLexer::benchmarkRegularExpressionRules() {
+    QStringList lines = benchmarkLines();
+
+    QBENCHMARK {
+        int state = -1;
+        for (QStringList::const_iterator it=lines.constBegin(),end=lines.constEnd() ; it!=end ; ++it) {
+            int newState;
+            referenceFormats(*it, state, newState);
+            state = newState;
+        }
+    }
+}
+
+
+void TestCppLexer::benchmarkLexer() {
+    QStringList          lines = benchmarkLines();
+    EQt::CppLexer::Spans spans;
+
+    QBENCHMARK {
+        int state = -1;
+        for (QStringList::const_iterator it=lines.constBegin(),end=lines.constEnd() ; it!=end ; ++it) {
+            state = EQt::CppLexer::lex(*it, state, spans);
+        }
+    }
+}
+
+
+QString TestCppLexer::referenceFormats(const QString& text, int previousBlockState, int& newBlockState) const {
+    QString result(text.length(), QChar('.'));
+
+    for (  QVector<QRegularExpression>::const_iterator it  = keywordExpressions.constBegin(),
+                                                       end = keywordExpressions.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QRegularExpressionMatchIterator matchIterator = it->globalMatch(text);
+        while (matchIterator.hasNext()) {
+            QRegularExpressionMatch match = matchIterator.next();
+            result.replace(match.capturedStart(), match.capturedLength(), QString(match.capturedLength(), 'K'));
+        }
+    }
+
+    const QRegularExpression* expressions[] = {
+        &singleLineCommentExpression,
+        &quotationExpression,
+        &functionExpression
+    };
+    const char codes[] = { 'S', 'Q', 'F' };
+
+    for (unsigned i=0 ; i<3 ; ++i) {
+        QRegularExpressionMatchIterator matchIterator = expressions[i]->globalMatch(text);
+        while (matchIterator.hasNext()) {
+            QRegularExpressionMatch match = matchIterator.next();
+            result.replace(match.capturedStart(), match.capturedLength(), QString(match.capturedLength(), codes[i]));
+        }
+    }
+
+    newBlockState = 0;
+
+    int startIndex = 0;
+    if (previousBlockState != 1) {
+        startIndex = text.indexOf("/*");
+    }
+
+    while (startIndex >= 0) {
+        int endIndex      = text.indexOf("*/", startIndex);
+        int commentLength = 0;
+
+        if (endIndex < 0) {
+            newBlockState = 1;
+            commentLength = text.length() - startIndex;
+        } else {
+            commentLength = endIndex - startIndex + 2;
+        }
+
+        result.replace(startIndex, commentLength, QString(commentLength, 'M'));
+        startIndex = text.indexOf("/*", startIndex + commentLength);
+    }
+
+    return result;
+}
+
+
+QString TestCppLexer::lexerFormats(const QString& text, int previousBlockState, int& newBlockState) {
+    static const char codes[] = { 'K', 'S', 'Q', 'F', 'M' };
+
+    QString              result(text.length(), QChar('.'));
+    EQt::CppLexer::Spans spans;
+
+    newBlockState = EQt::CppLexer::lex(text, previousBlockState, spans);
+
+    for (EQt::CppLexer::Spans::const_iterator it=spans.constBegin(),end=spans.constEnd() ; it!=end ; ++it) {
+        char code = codes[static_cast<unsigned>(it->tokenType())];
+        result.replace(it->start(), it->length(), QString(it->length(), code));
+    }
+
+    return result;
+}
+
+
+void TestCppLexer::compareBlocks(const QStringList& blocks) const {
+    int referenceState = -1;
+    int lexerState     = -1;
+
+    for (QStringList::const_iterator it=blocks.constBegin(),end=blocks.constEnd() ; it!=end ; ++it) {
+        int newReferenceState;
+        int newLexerState;
+
+        QString expected = referenceFormats(*it, referenceState, newReferenceState);
+        QString measured = lexerFormats(*it, lexerState, newLexerState);
+
+        if (expected != measured || newReferenceState != newLexerState) {
+            qDebug() << "Text:    " << *it;
+            qDebug() << "Expected:" << expected << newReferenceState;
+            qDebug() << "Measured:" << measured << newLexerState;
+        }
+
+        QCOMPARE(measured, expected);
+        QCOMPARE(newLexerState, newReferenceState);
+
+        referenceState = newReferenceState;
+        lexerState     = newLexerState;
+    }
+}
+
+
+QString TestCppLexer::randomBlock(quint32& seed) {
+    static const char* const fragments[] = {
+        "/", "*", "\"", "(", " ", "int", "void", "foo", "x", "_", "1", "\t", ")", "//", "/*", "*/", "char", "a(",
+        "\xC3\xA9"
+    };
+    static const unsigned numberFragments = sizeof(fragments) / sizeof(fragments[0]);
+
+    QString result;
+
+    seed = seed * 1664525U + 1013904223U;
+    unsigned numberFragmentsInBlock = (seed >> 16) % 13;
+
+    for (unsigned i=0 ; i<numberFragmentsInBlock ; ++i) {
+        seed = seed * 1664525U + 1013904223U;
+        result += QString::fromUtf8(fragments[(seed >> 16) % numberFragments]);
+    }
+
+    return result;
+}
+
+
+QStringList TestCppLexer::benchmarkLines() {
+    static const char* const templateLines[] = {
+        "namespace Generated {",
+        "    /* Generated accessor.",
+        "     * Do not edit. */",
+        "    static const unsigned value%1 = %1; // Value number %1",
+        "    inline int accessor%1(const char* name, double scale) {",
+        "        return static_cast<int>(compute(\"name %1\", scale) * %1);",
+        "    }",
+        "}"
+    };
+    static const unsigned numberTemplateLines = sizeof(templateLines) / sizeof(templateLines[0]);
+
+    QStringList result;
+    for (unsigned i=0 ; i<numberBenchmarkLines ; ++i) {
+        result << QString(templateLines[i % numberTemplateLines]).arg(i);
+    }
+
+    return result;
+}
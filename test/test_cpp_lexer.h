@@ -0,0 +1,117 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides tests for the \ref CppLexer class.
+***********************************************************************************************************************/
+
+#ifndef TEST_CPP_LEXER_H
+#define TEST_CPP_LEXER_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QRegularExpression>
+
+class TestCppLexer:public QObject {
+    Q_OBJECT
+
+    public:
+        TestCppLexer();
+
+        ~TestCppLexer() override;
+
+    private slots:
+//        void initTestCase();
+
+        void testKnownCases();
+        void testRandomCases();
+        void testBlockState();
+        void benchmarkRegularExpressionRules();
+        void benchmarkLexer();
+
+//        void cleanupTestCase();
+
+    private:
+        static constexpr unsigned numberRandomCases = 20000;
+        static constexpr unsigned numberBenchmarkLines = 20000;
+
+        /**
+         * Method that applies the regular expression rules formerly used by the C++ syntax highlighter.
+         *
+         * \param[in]  text               The block text.
+         *
+         * \param[in]  previousBlockState The state of the previous block.
+         *
+         * \param[out] newBlockState      The state at the end of the block.
+         *
+         * \return Returns one character per text character indicating the applied format.
+         */
+        QString referenceFormats(const QString& text, int previousBlockState, int& newBlockState) const;
+
+        /**
+         * Method that applies the lexer.
+         *
+         * \param[in]  text               The block text.
+         *
+         * \param[in]  previousBlockState The state of the previous block.
+         *
+         * \param[out] newBlockState      The state at the end of the block.
+         *
+         * \return Returns one character per text character indicating the applied format.
+         */
+        static QString lexerFormats(const QString& text, int previousBlockState, int& newBlockState);
+
+        /**
+         * Method that compares the lexer against the reference rules for a sequence of blocks.
+         *
+         * \param[in] blocks The block texts.
+         */
+        void compareBlocks(const QStringList& blocks) const;
+
+        /**
+         * Method that generates a pseudo-random block of text built from C++ fragments.
+         *
+         * \param[in,out] seed The generator seed.
+         *
+         * \return Returns the generated text.
+         */
+        static QString randomBlock(quint32& seed);
+
+        /**
+         * Method that generates representative source lines for benchmarking.
+         *
+         * \return Returns the generated lines.
+         */
+        static QStringList benchmarkLines();
+
+        QVector<QRegularExpression> keywordExpressions;
+        QRegularExpression          singleLineCommentExpression;
+        QRegularExpression          quotationExpression;
+        QRegularExpression          functionExpression;
+};
+
+#endif
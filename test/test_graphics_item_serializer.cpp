@@ -0,0 +1,254 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref GraphicsItemSerializer class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QFont>
+#include <QPen>
+#include <QBrush>
+#include <QColor>
+#include <QRectF>
+#include <QLineF>
+#include <QPointF>
+#include <QPainterPath>
+#include <QGraphicsItem>
+
+#include <eqt_graphics_item_group.h>
+#include <eqt_graphics_multi_text_group.h>
+#include <eqt_graphics_math_group.h>
+#include <eqt_graphics_math_group_with_line.h>
+#include <eqt_graphics_math_group_with_painter_path.h>
+#include <eqt_graphics_item_serializer.h>
+
+#include "test_graphics_item_serializer.h"
+
+void TestGraphicsItemSerializer::testRoundTrip() {
+    QFont font;
+    font.setPointSize(14);
+
+    QPen dashedPen(QColor(10, 20, 30, 40));
+    dashedPen.setStyle(Qt::DashLine);
+    dashedPen.setCapStyle(Qt::RoundCap);
+    dashedPen.setJoinStyle(Qt::BevelJoin);
+    dashedPen.setWidthF(2.5);
+
+    EQt::GraphicsItemGroup* root = new EQt::GraphicsItemGroup;
+    root->setPos(QPointF(1.5, -2.25));
+    root->setForcedGeometry(QRectF(0, 0, 100, 50));
+
+    EQt::GraphicsMultiTextGroup* text = new EQt::GraphicsMultiTextGroup;
+    text->setBackgroundBrush(QBrush(QColor(Qt::yellow)));
+    text->setBorderPen(dashedPen);
+    text->append(QString("alpha"), font, QPointF(0, 10));
+    text->append(QString("beta"), font, QPointF(20, 10));
+    text->setParentItem(root);
+
+    EQt::GraphicsMathGroupWithLine* line = new EQt::GraphicsMathGroupWithLine;
+    line->setLeftParenthesis(EQt::GraphicsMathGroup::ParenthesisStyle::BRACKETS, QRectF(0, 0, 4, 12));
+    line->setLine(QLineF(0, 1, 8, 1));
+    line->setLinePen(dashedPen);
+    line->setParentItem(text);
+
+    QPainterPath path;
+    path.moveTo(0, 0);
+    path.lineTo(4, 4);
+    path.cubicTo(QPointF(5, 5), QPointF(6, 4), QPointF(8, 0));
+
+    EQt::GraphicsMathGroupWithPainterPath* pathGroup = new EQt::GraphicsMathGroupWithPainterPath;
+    pathGroup->setPainterPath(path);
+    pathGroup->setPainterPathBrush(QBrush(QColor(Qt::blue)));
+    pathGroup->setParentItem(root);
+
+    QByteArray data = EQt::GraphicsItemSerializer::serialize(root);
+    QVERIFY(!data.isEmpty());
+
+    QList<EQt::GraphicsItemGroup*> items = EQt::GraphicsItemSerializer::deserialize(data);
+    QCOMPARE(items.size(), 1);
+
+    EQt::GraphicsItemGroup* readRoot = items.first();
+    QCOMPARE(readRoot->type(), static_cast<int>(EQt::GraphicsItemGroup::Type));
+    QCOMPARE(readRoot->pos(), root->pos());
+    QCOMPARE(readRoot->forcedGeometry(), root->forcedGeometry());
+    QCOMPARE(readRoot->childItems().size(), 2);
+
+    EQt::GraphicsMultiTextGroup* readText = dynamic_cast<EQt::GraphicsMultiTextGroup*>(readRoot->childItems().at(0));
+    QVERIFY(readText != Q_NULLPTR);
+    QCOMPARE(readText->backgroundBrush(), text->backgroundBrush());
+    QCOMPARE(readText->borderPen(), text->borderPen());
+    QCOMPARE(readText->numberTextEntries(), 2U);
+    QCOMPARE(readText->entry(1).text(), text->entry(1).text());
+    QCOMPARE(readText->entry(1).position(), text->entry(1).position());
+    QCOMPARE(readText->entry(1).font(), font);
+
+    EQt::GraphicsMathGroupWithLine* readLine =
+        dynamic_cast<EQt::GraphicsMathGroupWithLine*>(readText->childItems().value(0));
+    QVERIFY(readLine != Q_NULLPTR);
+    QCOMPARE(readLine->leftParenthesisStyle(), EQt::GraphicsMathGroup::ParenthesisStyle::BRACKETS);
+    QCOMPARE(readLine->line(), line->line());
+    QCOMPARE(readLine->linePen(), dashedPen);
+
+    EQt::GraphicsMathGroupWithPainterPath* readPath =
+        dynamic_cast<EQt::GraphicsMathGroupWithPainterPath*>(readRoot->childItems().at(1));
+    QVERIFY(readPath != Q_NULLPTR);
+    QCOMPARE(readPath->painterPath(), path);
+    QCOMPARE(readPath->painterPathBrush(), pathGroup->painterPathBrush());
+
+    // Writing the rebuilt tree must reproduce the original stream.
+
+    QCOMPARE(EQt::GraphicsItemSerializer::serialize(readRoot), data);
+
+    deleteTree(readRoot);
+    deleteTree(root);
+}
+
+
+void TestGraphicsItemSerializer::testTruncatedInput() {
+    EQt::GraphicsMultiTextGroup* group = new EQt::GraphicsMultiTextGroup;
+    group->append(QString("truncated"), QFont(), QPointF(1, 2));
+
+    EQt::GraphicsMathGroupWithPainterPath* child = new EQt::GraphicsMathGroupWithPainterPath;
+    QPainterPath path;
+    path.moveTo(0, 0);
+    path.lineTo(1, 1);
+    child->setPainterPath(path);
+    child->setParentItem(group);
+
+    QByteArray data = EQt::GraphicsItemSerializer::serialize(group);
+    QVERIFY(!data.isEmpty());
+
+    for (int length=0 ; length<data.size() ; ++length) {
+        QList<EQt::GraphicsItemGroup*> items = EQt::GraphicsItemSerializer::deserialize(data.left(length));
+        QCOMPARE(items.size(), 0);
+    }
+
+    QList<EQt::GraphicsItemGroup*> items = EQt::GraphicsItemSerializer::deserialize(data);
+    QCOMPARE(items.size(), 1);
+
+    deleteTree(items.first());
+    deleteTree(group);
+}
+
+
+void TestGraphicsItemSerializer::testCorruptEnumeratedValues() {
+    QByteArray data = emptyTextGroupStream();
+    QCOMPARE(data.size(), emptyTextGroupSize);
+
+    QList<EQt::GraphicsItemGroup*> items = EQt::GraphicsItemSerializer::deserialize(data);
+    QCOMPARE(items.size(), 1);
+    deleteTree(items.first());
+
+    QList<QPair<int, char>> corruptions;
+    corruptions << qMakePair(itemTagOffset,      char(99))
+                << qMakePair(forcedFlagOffset,   char(2))
+                << qMakePair(brushStyleOffset,   char(200))
+                << qMakePair(penStyleOffset,     char(50))
+                << qMakePair(penCapStyleOffset,  char(0x05))
+                << qMakePair(penJoinStyleOffset, char(0x03))
+                << qMakePair(penCosmeticOffset,  char(7));
+
+    for (  QList<QPair<int, char>>::const_iterator it  = corruptions.constBegin(),
+                                                   end = corruptions.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QByteArray corrupt = data;
+        corrupt[it->first] = it->second;
+
+        QCOMPARE(EQt::GraphicsItemSerializer::deserialize(corrupt).size(), 0);
+    }
+}
+
+
+void TestGraphicsItemSerializer::testNestingDepth() {
+    unsigned maximumDepth = EQt::GraphicsItemSerializer::maximumNestingDepth;
+
+    QList<EQt::GraphicsItemGroup*> items = EQt::GraphicsItemSerializer::deserialize(nestedGroupStream(maximumDepth));
+    QCOMPARE(items.size(), 1);
+    deleteTree(items.first());
+
+    items = EQt::GraphicsItemSerializer::deserialize(nestedGroupStream(maximumDepth + 1));
+    QCOMPARE(items.size(), 0);
+
+    EQt::GraphicsItemGroup* root = new EQt::GraphicsItemGroup;
+    EQt::GraphicsItemGroup* leaf = root;
+    for (unsigned depth=1 ; depth<maximumDepth ; ++depth) {
+        EQt::GraphicsItemGroup* child = new EQt::GraphicsItemGroup;
+        child->setParentItem(leaf);
+        leaf = child;
+    }
+
+    QVERIFY(!EQt::GraphicsItemSerializer::serialize(root).isEmpty());
+
+    EQt::GraphicsItemGroup* tooDeep = new EQt::GraphicsItemGroup;
+    tooDeep->setParentItem(leaf);
+
+    QVERIFY(EQt::GraphicsItemSerializer::serialize(root).isEmpty());
+
+    deleteTree(root);
+}
+
+
+QByteArray TestGraphicsItemSerializer::emptyTextGroupStream() {
+    EQt::GraphicsMultiTextGroup group;
+    return EQt::GraphicsItemSerializer::serialize(&group);
+}
+
+
+QByteArray TestGraphicsItemSerializer::nestedGroupStream(unsigned depth) {
+    QByteArray result;
+    result.append("EQGI", 4);
+    result.append("\x01\x00\x00\x00", 4); // Version 1, reserved.
+    result.append(QByteArray(4, '\0'));    // No fonts.
+    result.append("\x01\x00\x00\x00", 4); // One root item.
+
+    for (unsigned level=1 ; level<=depth ; ++level) {
+        result.append('\x01');                 // ITEM_GROUP tag.
+        result.append(QByteArray(16, '\0'));   // Position.
+        result.append('\0');                   // No forced geometry.
+
+        if (level < depth) {
+            result.append("\x01\x00\x00\x00", 4);
+        } else {
+            result.append(QByteArray(4, '\0'));
+        }
+    }
+
+    return result;
+}
+
+
+void TestGraphicsItemSerializer::deleteTree(QGraphicsItem* item) {
+    QList<QGraphicsItem*> children = item->childItems();
+    delete item;
+
+    for (QList<QGraphicsItem*>::const_iterator it=children.constBegin(),end=children.constEnd() ; it!=end ; ++it) {
+        deleteTree(*it);
+    }
+}
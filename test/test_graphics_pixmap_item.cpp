@@ -0,0 +1,109 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref EQt::GraphicsPixmapItem class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QSize>
+#include <QRectF>
+#include <QColor>
+#include <QImage>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <eqt_graphics_scene.h>
+#include <eqt_graphics_pixmap_item.h>
+
+#include "test_graphics_pixmap_item.h"
+
+void TestGraphicsPixmapItem::testImageFile() {
+    QTemporaryDir temporaryDirectory;
+    QVERIFY(temporaryDirectory.isValid());
+
+    QString filename = temporaryDirectory.filePath(QString("image.png"));
+
+    QImage image(300, 200, QImage::Format_RGB32);
+    image.fill(QColor(Qt::blue));
+    QVERIFY(image.save(filename));
+
+    EQt::GraphicsScene      scene;
+    EQt::GraphicsPixmapItem item;
+    scene.addItem(&item);
+
+    item.setImageFile(filename);
+    QCOMPARE(item.imageFile(), filename);
+
+    // The size is read from the image header before decoding completes.
+
+    QCOMPARE(item.imageIsLoading(), true);
+    QCOMPARE(item.boundingRect(), QRectF(0, 0, 300, 200));
+    QCOMPARE(item.imageLevelSize(1.0), QSize(0, 0));
+
+    QTRY_COMPARE(item.imageIsLoading(), false);
+    QCOMPARE(item.imageLoadFailed(), false);
+    QCOMPARE(item.boundingRect(), QRectF(0, 0, 300, 200));
+
+    // Levels are 300x200, 150x100, 75x50 and 37x25.  The smallest level at least as wide as the drawn image is used.
+
+    QCOMPARE(item.imageLevelSize(2.0), QSize(300, 200));
+    QCOMPARE(item.imageLevelSize(1.0), QSize(300, 200));
+    QCOMPARE(item.imageLevelSize(0.5), QSize(150, 100));
+    QCOMPARE(item.imageLevelSize(0.3), QSize(150, 100));
+    QCOMPARE(item.imageLevelSize(0.2), QSize(75, 50));
+    QCOMPARE(item.imageLevelSize(0.1), QSize(37, 25));
+
+    item.setImageFile(QString());
+    QCOMPARE(item.imageFile(), QString());
+    QCOMPARE(item.imageIsLoading(), false);
+}
+
+
+void TestGraphicsPixmapItem::testImageFileFailure() {
+    QTemporaryDir temporaryDirectory;
+    QVERIFY(temporaryDirectory.isValid());
+
+    QString filename = temporaryDirectory.filePath(QString("broken.png"));
+
+    QFile file(filename);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("This is not an image.");
+    file.close();
+
+    EQt::GraphicsScene      scene;
+    EQt::GraphicsPixmapItem item;
+    scene.addItem(&item);
+
+    // The header can not be read so the item must not report a negative size.
+
+    item.setImageFile(filename);
+    QCOMPARE(item.boundingRect(), QRectF(0, 0, 0, 0));
+
+    QTRY_COMPARE(item.imageIsLoading(), false);
+    QCOMPARE(item.imageLoadFailed(), true);
+    QCOMPARE(item.boundingRect(), QRectF(0, 0, 0, 0));
+    QCOMPARE(item.imageLevelSize(1.0), QSize(0, 0));
+}
@@ -0,0 +1,202 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref GraphicsScene class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QList>
+#include <QRectF>
+#include <QPointF>
+#include <QFont>
+#include <QGraphicsItem>
+#include <QGraphicsSimpleTextItem>
+
+#include <eqt_graphics_scene.h>
+#include <eqt_graphics_item_group.h>
+#include <eqt_graphics_multi_text_group.h>
+#include <eqt_graphics_text_item.h>
+
+#include "test_graphics_scene.h"
+
+void TestGraphicsScene::testTransactionNesting() {
+    EQt::GraphicsScene     scene;
+    EQt::GraphicsItemGroup item;
+    scene.addItem(&item);
+
+    item.setForcedGeometry(QRectF(0, 0, 10, 10));
+    QCOMPARE(scene.updateTransactionIsOpen(), false);
+
+    scene.beginUpdateTransaction();
+    scene.beginUpdateTransaction();
+    QCOMPARE(scene.updateTransactionIsOpen(), true);
+
+    item.setForcedGeometry(QRectF(20, 20, 10, 10));
+    QCOMPARE(item.forcedGeometry(), QRectF(20, 20, 10, 10));
+    QCOMPARE(item.boundingRect(), QRectF(20, 20, 10, 10));
+    QCOMPARE(item.updatesAreDeferred(), true);
+
+    scene.commitUpdateTransaction();
+    QCOMPARE(scene.updateTransactionIsOpen(), true);
+    QCOMPARE(item.updatesAreDeferred(), true);
+    QCOMPARE(item.boundingRect(), QRectF(20, 20, 10, 10));
+
+    scene.commitUpdateTransaction();
+    QCOMPARE(scene.updateTransactionIsOpen(), false);
+    QCOMPARE(item.updatesAreDeferred(), false);
+    QCOMPARE(item.boundingRect(), QRectF(20, 20, 10, 10));
+
+    // Unmatched commits are ignored.
+    scene.commitUpdateTransaction();
+    QCOMPARE(scene.updateTransactionIsOpen(), false);
+
+    item.setForcedGeometry(QRectF(5, 5, 1, 1));
+    QCOMPARE(item.updatesAreDeferred(), false);
+    QCOMPARE(item.boundingRect(), QRectF(5, 5, 1, 1));
+}
+
+
+void TestGraphicsScene::testTransactionGuard() {
+    EQt::GraphicsScene     scene;
+    EQt::GraphicsItemGroup item;
+    scene.addItem(&item);
+
+    item.setForcedGeometry(QRectF(0, 0, 10, 10));
+
+    {
+        EQt::GraphicsScene::UpdateTransaction outerTransaction(&scene);
+        item.setForcedGeometry(QRectF(1, 1, 10, 10));
+        QCOMPARE(item.boundingRect(), QRectF(1, 1, 10, 10));
+
+        {
+            EQt::GraphicsScene::UpdateTransaction innerTransaction(&scene);
+            item.setForcedGeometry(QRectF(2, 2, 10, 10));
+        }
+
+        QCOMPARE(scene.updateTransactionIsOpen(), true);
+        QCOMPARE(item.updatesAreDeferred(), true);
+        QCOMPARE(item.boundingRect(), QRectF(2, 2, 10, 10));
+    }
+
+    QCOMPARE(scene.updateTransactionIsOpen(), false);
+    QCOMPARE(item.updatesAreDeferred(), false);
+    QCOMPARE(item.boundingRect(), QRectF(2, 2, 10, 10));
+}
+
+
+void TestGraphicsScene::testImmediateSetters() {
+    EQt::GraphicsScene    scene;
+    EQt::GraphicsTextItem item(QString("before"));
+    scene.addItem(&item);
+
+    QFont font = item.font();
+    font.setPointSize(font.pointSize() + 4);
+
+    item.deferUpdates();
+    scene.beginUpdateTransaction();
+
+    item.setText(QString("first"));
+    item.setFont(font);
+    QCOMPARE(item.text(), QString("first"));
+    QCOMPARE(item.font(), font);
+
+    // Calls through the Qt base class must behave identically.
+    QGraphicsSimpleTextItem* baseItem = &item;
+    baseItem->setText(QString("after"));
+    QCOMPARE(item.text(), QString("after"));
+
+    QRectF boundingRectangle = item.boundingRect();
+
+    scene.commitUpdateTransaction();
+    QCOMPARE(item.text(), QString("after"));
+    QCOMPARE(item.boundingRect(), boundingRectangle);
+
+    item.restoreUpdates();
+
+    QCOMPARE(item.text(), QString("after"));
+    QCOMPARE(item.font(), font);
+    QCOMPARE(item.boundingRect(), boundingRectangle);
+}
+
+
+void TestGraphicsScene::testGeometryReindexed() {
+    EQt::GraphicsScene     scene(QRectF(0, 0, 1000, 1000));
+    EQt::GraphicsItemGroup group;
+    scene.addItem(&group);
+
+    QRectF firstRectangle(10, 10, 20, 20);
+    QRectF secondRectangle(500, 500, 20, 20);
+
+    scene.beginUpdateTransaction();
+
+    group.setForcedGeometry(firstRectangle);
+    QCOMPARE(scene.items(firstRectangle).contains(&group), true);
+
+    group.setForcedGeometry(secondRectangle);
+
+    scene.commitUpdateTransaction();
+
+    QCOMPARE(scene.items(secondRectangle).contains(&group), true);
+    QCOMPARE(scene.items(firstRectangle).contains(&group), false);
+}
+
+
+void TestGraphicsScene::testMultiTextGroupReindexed() {
+    EQt::GraphicsScene          scene(QRectF(0, 0, 1000, 1000));
+    EQt::GraphicsMultiTextGroup group;
+    scene.addItem(&group);
+
+    QFont font;
+
+    scene.beginUpdateTransaction();
+
+    group.append(QString("first"), font, QPointF(10, 50));
+    QRectF firstRectangle = group.boundingRect();
+    QCOMPARE(scene.items(firstRectangle).contains(&group), true);
+
+    group.clearText();
+    group.append(QString("second"), font, QPointF(600, 600));
+    QRectF secondRectangle = group.boundingRect();
+
+    scene.commitUpdateTransaction();
+
+    QCOMPARE(scene.items(secondRectangle).contains(&group), true);
+    QCOMPARE(scene.items(firstRectangle).contains(&group), false);
+}
+
+
+void TestGraphicsScene::testItemDestroyedDuringTransaction() {
+    EQt::GraphicsScene      scene;
+    EQt::GraphicsItemGroup* item = new EQt::GraphicsItemGroup;
+    scene.addItem(item);
+
+    scene.beginUpdateTransaction();
+    item->setForcedGeometry(QRectF(1, 1, 10, 10));
+    QCOMPARE(item->updatesAreDeferred(), true);
+    delete item;
+    scene.commitUpdateTransaction();
+
+    QCOMPARE(scene.items().isEmpty(), true);
+}
@@ -0,0 +1,190 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2022 Inesonic, LLC.
+* 
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref GraphicsScenePageRenderer class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QList>
+#include <QRectF>
+#include <QImage>
+#include <QColor>
+#include <QPen>
+#include <QBrush>
+#include <QGraphicsScene>
+#include <QGraphicsRectItem>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QWidget>
+
+#include <algorithm>
+
+#include <eqt_graphics_scene_page_renderer.h>
+
+#include "test_graphics_scene_page_renderer.h"
+
+void TestGraphicsScenePageRenderer::testRender() {
+    QGraphicsScene scene;
+    scene.addRect(QRectF(0, 0, 100, 100), QPen(Qt::NoPen), QBrush(Qt::black));
+
+    QList<QRectF> pageRectangles;
+    for (unsigned pageIndex=0 ; pageIndex<5 ; ++pageIndex) {
+        pageRectangles.append(QRectF(0, 100 * pageIndex, 100, 100));
+    }
+
+    EQt::GraphicsScenePageRenderer renderer;
+    renderer.setScaleFactor(2.0);
+
+    QSignalSpy pageSpy(&renderer, SIGNAL(pageRendered(unsigned, const QImage&)));
+    QSignalSpy finishedSpy(&renderer, SIGNAL(finished(bool)));
+
+    QCOMPARE(renderer.render(&scene, pageRectangles), true);
+    QCOMPARE(renderer.isActive(), true);
+    QCOMPARE(renderer.render(&scene, pageRectangles), false);
+
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().at(0).toBool(), true);
+    QCOMPARE(renderer.isActive(), false);
+
+    QCOMPARE(pageSpy.size(), 5);
+    for (unsigned pageIndex=0 ; pageIndex<5 ; ++pageIndex) {
+        QCOMPARE(pageSpy.at(pageIndex).at(0).toUInt(), pageIndex);
+
+        QImage image = pageSpy.at(pageIndex).at(1).value<QImage>();
+        QCOMPARE(image.size(), QSize(200, 200));
+
+        QColor center = image.pixelColor(100, 100);
+        if (pageIndex == 0) {
+            QCOMPARE(center, QColor(Qt::black));
+        } else {
+            QCOMPARE(center, QColor(Qt::white));
+        }
+    }
+}
+
+
+/**
+ * Item that tracks the number of pages outstanding.  The item spans every page so it is painted once as each page is
+ * recorded.  Pages are reported through the progress signal.
+ */
+class PageCountingItem:public QGraphicsRectItem {
+    public:
+        PageCountingItem(const QRectF& rectangle, const QSignalSpy* progressSpy);
+
+        ~PageCountingItem() override;
+
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+        unsigned peakPagesOutstanding() const;
+
+    private:
+        const QSignalSpy* currentProgressSpy;
+        unsigned          currentPagesStarted;
+        unsigned          currentPeakPagesOutstanding;
+};
+
+
+PageCountingItem::PageCountingItem(
+        const QRectF&     rectangle,
+        const QSignalSpy* progressSpy
+    ):QGraphicsRectItem(
+        rectangle
+    ) {
+    currentProgressSpy          = progressSpy;
+    currentPagesStarted         = 0;
+    currentPeakPagesOutstanding = 0;
+}
+
+
+PageCountingItem::~PageCountingItem() {}
+
+
+void PageCountingItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    ++currentPagesStarted;
+
+    unsigned pagesReported = static_cast<unsigned>(currentProgressSpy->size());
+    currentPeakPagesOutstanding = std::max(currentPeakPagesOutstanding, currentPagesStarted - pagesReported);
+
+    QGraphicsRectItem::paint(painter, option, widget);
+}
+
+
+unsigned PageCountingItem::peakPagesOutstanding() const {
+    return currentPeakPagesOutstanding;
+}
+
+
+void TestGraphicsScenePageRenderer::testBoundedPagesInFlight() {
+    EQt::GraphicsScenePageRenderer renderer;
+    renderer.setMaximumPagesInFlight(2);
+
+    QSignalSpy progressSpy(&renderer, SIGNAL(progress(unsigned, unsigned)));
+    QSignalSpy finishedSpy(&renderer, SIGNAL(finished(bool)));
+
+    QGraphicsScene    scene;
+    PageCountingItem* item = new PageCountingItem(QRectF(0, 0, 10, 1000), &progressSpy);
+    scene.addItem(item);
+
+    QList<QRectF> pageRectangles;
+    for (unsigned pageIndex=0 ; pageIndex<40 ; ++pageIndex) {
+        pageRectangles.append(QRectF(0, 25 * pageIndex, 10, 25));
+    }
+
+    renderer.render(&scene, pageRectangles);
+
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().at(0).toBool(), true);
+
+    QCOMPARE(progressSpy.size(), 40);
+    QCOMPARE(progressSpy.last().at(0).toUInt(), 40U);
+    QCOMPARE(progressSpy.last().at(1).toUInt(), 40U);
+
+    QVERIFY(item->peakPagesOutstanding() > 0);
+    QVERIFY(item->peakPagesOutstanding() <= renderer.maximumPagesInFlight());
+}
+
+
+void TestGraphicsScenePageRenderer::testSceneDestroyed() {
+    QGraphicsScene* scene = new QGraphicsScene;
+    scene->addRect(QRectF(0, 0, 10, 1000));
+
+    QList<QRectF> pageRectangles;
+    for (unsigned pageIndex=0 ; pageIndex<40 ; ++pageIndex) {
+        pageRectangles.append(QRectF(0, 25 * pageIndex, 10, 25));
+    }
+
+    EQt::GraphicsScenePageRenderer renderer;
+    renderer.setMaximumPagesInFlight(1);
+
+    QSignalSpy finishedSpy(&renderer, SIGNAL(finished(bool)));
+
+    renderer.render(scene, pageRectangles);
+    delete scene;
+
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().at(0).toBool(), false);
+    QCOMPARE(renderer.isActive(), false);
+}
@@ -34,6 +34,15 @@
 #include "test_unique_application.h"
 #include "test_programmatic_dock_widget.h"
 #include "test_programmatic_main_window.h"
+#include "test_cpp_lexer.h"
+#include "test_builder_profiler.h"
+#include "test_graphics_scene_page_renderer.h"
+#include "test_graphics_scene.h"
+#include "test_graphics_item_serializer.h"
+#include "test_chart_series_decimator.h"
+#include "test_code_editor_search_engine.h"
+#include "test_chart_streaming_series.h"
+#include "test_graphics_pixmap_item.h"
 
 int main(int argumentCount, char** argumentValues) {
     ApplicationWrapper wrapper(argumentCount, argumentValues);
@@ -43,6 +52,15 @@ int main(int argumentCount, char** argumentValues) {
     wrapper.includeTest(new TestUniqueApplication);
     wrapper.includeTest(new TestProgrammaticDockWidget);
     wrapper.includeTest(new TestProgrammaticMainWindow);
+    wrapper.includeTest(new TestCppLexer);
+    wrapper.includeTest(new TestBuilderProfiler);
+    wrapper.includeTest(new TestGraphicsScenePageRenderer);
+    wrapper.includeTest(new TestGraphicsScene);
+    wrapper.includeTest(new TestGraphicsItemSerializer);
+    wrapper.includeTest(new TestChartSeriesDecimator);
+    wrapper.includeTest(new TestCodeEditorSearchEngine);
+    wrapper.includeTest(new TestChartStreamingSeries);
+    wrapper.includeTest(new TestGraphicsPixmapItem);
 
     int status = wrapper.exec();
 
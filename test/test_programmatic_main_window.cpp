@@ -31,6 +31,12 @@
 #include <QtTest/QtTest>
 #include <QString>
 #include <QMenu>
+#include <QMenuBar>
+#include <QAction>
+#include <QSignalSpy>
+#include <QList>
+
+#include <util_bit_set.h>
 
 #include <eqt_programmatic_dock_widget.h>
 #include <eqt_programmatic_main_window.h>
@@ -109,6 +115,88 @@ void TestProgrammaticMainWindow::testAddMenu() {
 }
 
 
+void TestProgrammaticMainWindow::testLazyMenus() {
+    EQt::ProgrammaticMainWindow mainWindow;
+
+    QAction* openAction   = mainWindow.addMenuAction(tr("Project | Open"));
+    QAction* recentAction = mainWindow.addMenuAction(tr("Project | Recent | First"));
+
+    QList<QAction*> menuBarActions = mainWindow.menuBar()->actions();
+    QCOMPARE(menuBarActions.size(), 1);
+
+    QMenu* projectMenu = menuBarActions.first()->menu();
+    QVERIFY(projectMenu != Q_NULLPTR);
+
+    #if (!defined(Q_OS_DARWIN))
+
+        // MacOS fills in top level menus immediately.
+        QCOMPARE(projectMenu->actions().isEmpty(), true);
+
+    #endif
+
+    // Menu actions are associated with the window so shortcuts work before menus are built.
+
+    QCOMPARE(mainWindow.QWidget::actions().contains(openAction), true);
+    QCOMPARE(mainWindow.QWidget::actions().contains(recentAction), true);
+
+    QMetaObject::invokeMethod(projectMenu, "aboutToShow");
+
+    QList<QAction*> projectActions = projectMenu->actions();
+    QCOMPARE(projectActions.size(), 2);
+    QCOMPARE(projectActions.at(0), openAction);
+
+    QMenu* recentMenu = projectActions.at(1)->menu();
+    QVERIFY(recentMenu != Q_NULLPTR);
+    QCOMPARE(recentMenu->actions().isEmpty(), true);
+
+    QMetaObject::invokeMethod(recentMenu, "aboutToShow");
+
+    QCOMPARE(recentMenu->actions().size(), 1);
+    QCOMPARE(recentMenu->actions().first(), recentAction);
+
+    // Entries added after a menu is built are added to the menu directly.
+
+    QAction* secondAction = mainWindow.addMenuAction(tr("Project | Recent | Second"));
+    QCOMPARE(recentMenu->actions().size(), 2);
+    QCOMPARE(recentMenu->actions().last(), secondAction);
+
+    // Menus returned to the caller are built immediately.
+
+    QMenu* toolsMenu = mainWindow.addMenu(tr("Tools | Options"));
+    QCOMPARE(mainWindow.menuBar()->actions().size(), 2);
+
+    QMenu* rootToolsMenu = mainWindow.menuBar()->actions().last()->menu();
+    QCOMPARE(rootToolsMenu->actions().size(), 1);
+    QCOMPARE(rootToolsMenu->actions().first()->menu(), toolsMenu);
+}
+
+
+void TestProgrammaticMainWindow::testLazyMenuDeletedAction() {
+    EQt::ProgrammaticMainWindow mainWindow;
+
+    QAction* firstAction  = mainWindow.addMenuAction(tr("Project | Recent | First"));
+    QAction* secondAction = mainWindow.addMenuAction(tr("Project | Recent | Second"));
+    QAction* thirdAction  = mainWindow.addMenuAction(tr("Project | Recent | Third"));
+
+    // Actions deleted before the menu is first shown are skipped when the menu is built.
+
+    delete secondAction;
+
+    QMenu* projectMenu = mainWindow.menuBar()->actions().first()->menu();
+    QMetaObject::invokeMethod(projectMenu, "aboutToShow");
+
+    QMenu* recentMenu = projectMenu->actions().first()->menu();
+    QVERIFY(recentMenu != Q_NULLPTR);
+
+    QMetaObject::invokeMethod(recentMenu, "aboutToShow");
+
+    QList<QAction*> recentActions = recentMenu->actions();
+    QCOMPARE(recentActions.size(), 2);
+    QCOMPARE(recentActions.at(0), firstAction);
+    QCOMPARE(recentActions.at(1), thirdAction);
+}
+
+
 void TestProgrammaticMainWindow::testSetTipAndShortcut() {
     /* For now we won't test activation, only that the actions receive the results from the method calls. */
 
@@ -142,3 +230,220 @@ void TestProgrammaticMainWindow::testDockWidgetRegistry() {
     mainWindow.addDockWidget("Snort 2", dock, EQt::DockWidgetDefaults(EQt::DockWidgetDefaults::Area::TOP, true));
     QCOMPARE(mainWindow.dockWidget("Snort 2"), dock);
 }
+
+
+void TestProgrammaticMainWindow::testActionState() {
+    EQt::ProgrammaticMainWindow mainWindow;
+
+    QAction* firstAction  = mainWindow.addMenuAction(tr("Edit | First"));
+    QAction* secondAction = mainWindow.addMenuAction(tr("Edit | Second"));
+    QAction* eitherAction = mainWindow.addMenuAction(tr("Edit | Either"));
+
+    Util::BitSet firstMask;
+    firstMask.setBit(1);
+
+    Util::BitSet secondMask;
+    secondMask.setBit(5);
+
+    Util::BitSet eitherMask;
+    eitherMask.setBit(1);
+    eitherMask.setBit(5);
+
+    mainWindow.setActionMask(firstAction, firstMask);
+    mainWindow.setActionMask(secondAction, secondMask);
+    mainWindow.setActionMask(eitherAction, eitherMask);
+
+    QCOMPARE(firstAction->isEnabled(), false);
+    QCOMPARE(secondAction->isEnabled(), false);
+    QCOMPARE(eitherAction->isEnabled(), false);
+
+    Util::BitSet firstState;
+    firstState.setBit(1);
+
+    mainWindow.setActionState(firstState);
+    QCOMPARE(firstAction->isEnabled(), true);
+    QCOMPARE(secondAction->isEnabled(), false);
+    QCOMPARE(eitherAction->isEnabled(), true);
+
+    Util::BitSet secondState;
+    secondState.setBit(5);
+
+    mainWindow.setActionState(secondState);
+    QCOMPARE(firstAction->isEnabled(), false);
+    QCOMPARE(secondAction->isEnabled(), true);
+    QCOMPARE(eitherAction->isEnabled(), true);
+
+    mainWindow.setActionState(Util::BitSet());
+    QCOMPARE(firstAction->isEnabled(), false);
+    QCOMPARE(secondAction->isEnabled(), false);
+    QCOMPARE(eitherAction->isEnabled(), false);
+
+    // Moving an action to a different bit must stop it from following the bit it previously depended on.
+
+    mainWindow.setActionMask(secondAction, firstMask);
+    QVERIFY(mainWindow.actionMask(secondAction) == firstMask);
+
+    mainWindow.setActionState(secondState);
+    QCOMPARE(secondAction->isEnabled(), false);
+
+    mainWindow.setActionState(firstState);
+    QCOMPARE(secondAction->isEnabled(), true);
+
+    mainWindow.setActionMask(tr("Edit | Second"), secondMask);
+    QCOMPARE(secondAction->isEnabled(), false);
+}
+
+
+void TestProgrammaticMainWindow::testActionStateBatching() {
+    EQt::ProgrammaticMainWindow mainWindow;
+
+    QAction* action = mainWindow.addMenuAction(tr("Edit | Batched"));
+
+    Util::BitSet mask;
+    mask.setBit(2);
+
+    mainWindow.setActionMask(action, mask);
+    QCOMPARE(action->isEnabled(), false);
+
+    QSignalSpy changedSpy(action, SIGNAL(changed()));
+
+    Util::BitSet enabledState;
+    enabledState.setBit(2);
+
+    // Toggling an action back to its original state within a batch must not emit any change.
+
+    mainWindow.beginActionStateUpdate();
+    QCOMPARE(mainWindow.actionStateUpdateInProgress(), true);
+
+    mainWindow.setActionState(enabledState);
+    QCOMPARE(action->isEnabled(), false);
+
+    mainWindow.setActionState(Util::BitSet());
+    mainWindow.endActionStateUpdate();
+
+    QCOMPARE(mainWindow.actionStateUpdateInProgress(), false);
+    QCOMPARE(action->isEnabled(), false);
+    QCOMPARE(changedSpy.count(), 0);
+
+    // A net change must be applied once, when the outermost batch ends.
+
+    mainWindow.beginActionStateUpdate();
+    mainWindow.beginActionStateUpdate();
+    mainWindow.setActionState(enabledState);
+    mainWindow.endActionStateUpdate();
+
+    QCOMPARE(action->isEnabled(), false);
+
+    mainWindow.endActionStateUpdate();
+
+    QCOMPARE(action->isEnabled(), true);
+    QCOMPARE(changedSpy.count(), 1);
+}
+
+
+void TestProgrammaticMainWindow::testHiddenActionState() {
+    EQt::ProgrammaticMainWindow mainWindow;
+
+    QAction* action = mainWindow.addMenuAction(tr("Edit | Hidden"));
+
+    Util::BitSet mask;
+    mask.setBit(3);
+
+    Util::BitSet enabledState;
+    enabledState.setBit(3);
+
+    mainWindow.setActionMask(action, mask);
+    mainWindow.setActionState(enabledState);
+    QCOMPARE(action->isEnabled(), true);
+
+    // Hidden actions always report themselves as disabled so the disable must not be skipped.
+
+    action->setVisible(false);
+    QCOMPARE(action->isEnabled(), false);
+
+    mainWindow.setActionState(Util::BitSet());
+
+    action->setVisible(true);
+    QCOMPARE(action->isEnabled(), false);
+
+    // The same applies to a disable recorded within a batch.
+
+    mainWindow.setActionState(enabledState);
+    QCOMPARE(action->isEnabled(), true);
+
+    action->setVisible(false);
+
+    mainWindow.beginActionStateUpdate();
+    mainWindow.setActionState(Util::BitSet());
+    mainWindow.endActionStateUpdate();
+
+    action->setVisible(true);
+    QCOMPARE(action->isEnabled(), false);
+}
+
+
+void TestProgrammaticMainWindow::benchmarkSetActionState() {
+    EQt::ProgrammaticMainWindow mainWindow;
+    QList<QAction*>             actions = addSyntheticActions(mainWindow);
+
+    Util::BitSet firstState;
+    firstState.setBit(0);
+    firstState.setBit(1);
+
+    Util::BitSet secondState;
+    secondState.setBit(0);
+    secondState.setBit(2);
+
+    bool useFirstState = true;
+    QBENCHMARK {
+        mainWindow.setActionState(useFirstState ? firstState : secondState);
+        useFirstState = !useFirstState;
+    }
+
+    QVERIFY(!actions.isEmpty());
+}
+
+
+void TestProgrammaticMainWindow::benchmarkSetActionMask() {
+    EQt::ProgrammaticMainWindow mainWindow;
+    QList<QAction*>             actions = addSyntheticActions(mainWindow);
+
+    Util::BitSet firstMask;
+    firstMask.setBit(3);
+
+    Util::BitSet secondMask;
+    secondMask.setBit(4);
+
+    bool useFirstMask = true;
+    QBENCHMARK {
+        for (QList<QAction*>::const_iterator it=actions.constBegin(),end=actions.constEnd() ; it!=end ; ++it) {
+            mainWindow.setActionMask(*it, useFirstMask ? firstMask : secondMask);
+        }
+
+        useFirstMask = !useFirstMask;
+    }
+}
+
+
+QList<QAction*> TestProgrammaticMainWindow::addSyntheticActions(EQt::ProgrammaticMainWindow& mainWindow) {
+    static const unsigned numberActions = 10000;
+    static const unsigned numberBits    = 64;
+
+    QList<QAction*> result;
+    for (unsigned index=0 ; index<numberActions ; ++index) {
+        QAction* action = new QAction(QString("Action %1").arg(index), &mainWindow);
+
+        // Most actions depend on a single bit, every fourth action depends on two bits.
+
+        Util::BitSet mask;
+        mask.setBit(index % numberBits);
+        if (index % 4 == 0) {
+            mask.setBit((index * 7 + 3) % numberBits);
+        }
+
+        mainWindow.setActionMask(action, mask);
+        result.append(action);
+    }
+
+    return result;
+}
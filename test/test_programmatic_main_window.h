@@ -31,6 +31,13 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QtTest/QtTest>
+#include <QList>
+
+class QAction;
+
+namespace EQt {
+    class ProgrammaticMainWindow;
+}
 
 class TestProgrammaticMainWindow:public QObject {
     Q_OBJECT
@@ -46,9 +53,33 @@ class TestProgrammaticMainWindow:public QObject {
 
         void testAddMenu();
 
+        void testLazyMenus();
+
+        void testLazyMenuDeletedAction();
+
         void testSetTipAndShortcut();
 
         void testDockWidgetRegistry();
+
+        void testActionState();
+
+        void testActionStateBatching();
+
+        void testHiddenActionState();
+
+        void benchmarkSetActionState();
+
+        void benchmarkSetActionMask();
+
+    private:
+        /**
+         * Method that registers a large number of synthetic actions with a main window.
+         *
+         * \param[in] mainWindow The main window to receive the actions.
+         *
+         * \return Returns the actions, in the order they were created.
+         */
+        static QList<QAction*> addSyntheticActions(EQt::ProgrammaticMainWindow& mainWindow);
 };
 
 #endif